@@ -0,0 +1,72 @@
+// Test that a $text query sorted by text score with a limit returns the best scoring documents.
+(function() {
+    "use strict";
+
+    var coll = db.fts_score_sort_limit;
+    coll.drop();
+
+    assert.commandWorked(coll.ensureIndex({a: "text"}, {default_language: "none"}));
+
+    var words = ["pear", "plum", "fig", "kiwi"];
+    for (var i = 0; i < 200; i++) {
+        var text = [];
+        for (var j = 0; j < words.length; j++) {
+            for (var k = 0; k < (i * (j + 3)) % 7; k++) {
+                text.push(words[j]);
+            }
+        }
+        text.push("filler" + i);
+        assert.writeOK(coll.insert({_id: i, a: text.join(" ")}));
+    }
+
+    function getTextOrStage(stage) {
+        if (stage.stage === "TEXT_OR") {
+            return stage;
+        }
+        if (stage.inputStage) {
+            return getTextOrStage(stage.inputStage);
+        }
+        if (stage.shards) {
+            return getTextOrStage(stage.shards[0].executionStages);
+        }
+        return null;
+    }
+
+    function getScores(search, limit) {
+        var cursor = coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+                         .sort({score: {$meta: "textScore"}});
+        if (limit) {
+            cursor = cursor.limit(limit);
+        }
+        return cursor.toArray().map(function(doc) {
+            return doc.score;
+        });
+    }
+
+    ["pear", "pear plum", "pear plum fig kiwi", "fig absent"].forEach(function(search) {
+        var all = getScores(search, 0);
+        [1, 5, 20, 500].forEach(function(limit) {
+            assert.eq(all.slice(0, limit), getScores(search, limit), search + " " + limit);
+        });
+    });
+
+    // The limit is passed down to the TEXT_OR stage.
+    var explain = coll.find({$text: {$search: "pear plum"}}, {score: {$meta: "textScore"}})
+                      .sort({score: {$meta: "textScore"}})
+                      .limit(5)
+                      .explain("executionStats");
+    var textOr = getTextOrStage(explain.executionStats.executionStages);
+    if (textOr !== null) {
+        assert.eq(5, textOr.topK, tojson(explain));
+    }
+
+    // Negated terms need every document scored, so no limit is passed down.
+    explain = coll.find({$text: {$search: "pear -plum"}}, {score: {$meta: "textScore"}})
+                  .sort({score: {$meta: "textScore"}})
+                  .limit(5)
+                  .explain("executionStats");
+    textOr = getTextOrStage(explain.executionStats.executionStages);
+    if (textOr !== null) {
+        assert(!textOr.hasOwnProperty("topK"), tojson(explain));
+    }
+})();
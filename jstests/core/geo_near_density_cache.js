@@ -0,0 +1,98 @@
+// Test that $nearSphere searches on a 2dsphere index learn the density of the documents near the
+// query point, and return the same results in order of distance when they use it. Searches that
+// filter the documents must not teach later searches the density of only those they select.
+(function() {
+    "use strict";
+
+    var t = db.geo_near_density_cache;
+    t.drop();
+
+    // A dense cluster of points around the query point, and sparse points further away.
+    var points = [];
+    for (var i = 0; i < 500; i++) {
+        var coordinates = [i % 25 * 0.0001, Math.floor(i / 25) * 0.0001];
+        points.push({_id: i, loc: {type: "Point", coordinates: coordinates}});
+    }
+    for (var i = 500; i < 600; i++) {
+        points.push({_id: i, loc: {type: "Point", coordinates: [(i - 500) * 0.5, 1]}});
+    }
+    assert.writeOK(t.insert(points));
+    assert.commandWorked(t.ensureIndex({loc: "2dsphere"}));
+
+    var query = {loc: {$nearSphere: {type: "Point", coordinates: [0.001, 0.001]}}};
+
+    function getNearStage() {
+        var explain = t.find(query).limit(20).explain("executionStats");
+        var stage = explain.executionStats.executionStages;
+        while (stage && stage.stage !== "GEO_NEAR_2DSPHERE") {
+            stage = stage.inputStage || (stage.shards && stage.shards[0].executionStages);
+        }
+        return stage;
+    }
+
+    function getDistances(limit) {
+        return t.aggregate([
+                    {
+                      $geoNear: {
+                          near: {type: "Point", coordinates: [0.001, 0.001]},
+                          spherical: true,
+                          distanceField: "dist",
+                          limit: limit
+                      }
+                    },
+                    {$project: {_id: 0, dist: 1}}
+                ])
+            .toArray()
+            .map(function(doc) {
+                return doc.dist;
+            });
+    }
+
+    function getIds() {
+        return t.find(query)
+            .toArray()
+            .map(function(doc) {
+                return doc._id;
+            })
+            .sort(function(a, b) {
+                return a - b;
+            });
+    }
+
+    var expected = getIds();
+    assert.eq(600, expected.length);
+
+    // Once the first search has learned the density, later ones use it.
+    var stage = getNearStage();
+    if (stage) {
+        assert.eq(true, stage.densityFromCache, tojson(stage));
+    }
+
+    assert.eq(expected, getIds());
+
+    var distances = getDistances(600);
+    assert.eq(600, distances.length);
+    for (var i = 1; i < distances.length; i++) {
+        assert.lte(distances[i - 1], distances[i]);
+    }
+
+    // A selective filtered search runs first on a fresh collection. It finds only the sparse
+    // points, and the unfiltered search that follows must not take their density for that of the
+    // dense cluster, or its first annulus would hold the whole cluster.
+    t.drop();
+    assert.writeOK(t.insert(points));
+    assert.commandWorked(t.ensureIndex({loc: "2dsphere"}));
+
+    var filteredQuery = {
+        loc: {$nearSphere: {type: "Point", coordinates: [0.001, 0.001]}},
+        _id: {$gte: 500}
+    };
+    assert.eq(100, t.find(filteredQuery).itcount());
+
+    stage = getNearStage();
+    if (stage) {
+        assert.eq(false, stage.densityFromCache, tojson(stage));
+        assert.lt(stage.searchIntervals[0].maxDistance, 1000, tojson(stage));
+    }
+    assert.eq(expected, getIds());
+})();
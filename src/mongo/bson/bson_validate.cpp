@@ -390,6 +390,174 @@ Status validateBSONIterative(Buffer* buffer) {
     return Status::OK();
 }
 
+// Objects nested deeper than this are left to the element by element validator.
+const int kFastPathMaxDepth = 32;
+
+int32_t readInt32(const char* ptr) {
+    return ConstDataView(ptr).read<LittleEndian<int32_t>>();
+}
+
+/**
+ * Single pass check which only answers whether the buffer holds valid BSON. The declared size of
+ * every object is checked against the object enclosing it before any of its elements are visited,
+ * so each element only needs to be bounds checked against the end of its own object, and the walk
+ * neither allocates nor builds a Status per element. Field names are scanned with memchr, which
+ * the C library implements with vector instructions.
+ *
+ * This never accepts data that validateBSONIterative() rejects. It does, however, conservatively
+ * reject some valid data (code with scope, very deep nesting), which is fine because on failure
+ * validateBSON() re-runs the element by element validator, which also builds the error message.
+ */
+bool validateBSONFastPath(const char* buffer, uint64_t maxLength, BSONVersion version) {
+    const int32_t size = readInt32(buffer);
+    if (size < 5 || static_cast<uint64_t>(size) > maxLength) {
+        return false;
+    }
+
+    // 'end' points at the terminating EOO of the object being visited, and 'parentEnds' holds the
+    // same for each enclosing object.
+    const char* parentEnds[kFastPathMaxDepth];
+    int depth = 0;
+    const char* pos = buffer + sizeof(int32_t);
+    const char* end = buffer + size - 1;
+    if (*end != EOO) {
+        return false;
+    }
+
+    while (true) {
+        if (pos == end) {
+            if (depth == 0) {
+                return true;
+            }
+            pos = end + 1;
+            end = parentEnds[--depth];
+            continue;
+        }
+
+        const signed char type = *pos++;
+        const char* const fieldNameEnd = static_cast<const char*>(memchr(pos, 0, end - pos));
+        if (!fieldNameEnd) {
+            return false;
+        }
+        pos = fieldNameEnd + 1;
+
+        const uint64_t remaining = end - pos;
+        switch (type) {
+            case MinKey:
+            case MaxKey:
+            case jstNULL:
+            case Undefined:
+                break;
+
+            case Bool:
+                if (remaining < 1 || (*pos != 0 && *pos != 1)) {
+                    return false;
+                }
+                pos += 1;
+                break;
+
+            case NumberInt:
+                if (remaining < sizeof(int32_t)) {
+                    return false;
+                }
+                pos += sizeof(int32_t);
+                break;
+
+            case NumberDouble:
+            case NumberLong:
+            case bsonTimestamp:
+            case Date:
+                if (remaining < sizeof(int64_t)) {
+                    return false;
+                }
+                pos += sizeof(int64_t);
+                break;
+
+            case jstOID:
+                if (remaining < OID::kOIDSize) {
+                    return false;
+                }
+                pos += OID::kOIDSize;
+                break;
+
+            case NumberDecimal:
+                if (version == BSONVersion::kV1_0 || remaining < sizeof(Decimal128::Value)) {
+                    return false;
+                }
+                pos += sizeof(Decimal128::Value);
+                break;
+
+            case Code:
+            case Symbol:
+            case String:
+            case DBRef: {
+                if (remaining < sizeof(int32_t)) {
+                    return false;
+                }
+                const int32_t stringSize = readInt32(pos);
+                if (stringSize <= 0 ||
+                    static_cast<uint64_t>(stringSize) > remaining - sizeof(int32_t) ||
+                    pos[sizeof(int32_t) + stringSize - 1] != 0) {
+                    return false;
+                }
+                pos += sizeof(int32_t) + stringSize;
+
+                if (type == DBRef) {
+                    if (static_cast<uint64_t>(end - pos) < OID::kOIDSize) {
+                        return false;
+                    }
+                    pos += OID::kOIDSize;
+                }
+                break;
+            }
+
+            case RegEx:
+                for (int i = 0; i < 2; ++i) {
+                    const char* const cstringEnd =
+                        static_cast<const char*>(memchr(pos, 0, end - pos));
+                    if (!cstringEnd) {
+                        return false;
+                    }
+                    pos = cstringEnd + 1;
+                }
+                break;
+
+            case BinData: {
+                if (remaining < sizeof(int32_t) + 1) {
+                    return false;
+                }
+                const int32_t binDataSize = readInt32(pos);
+                if (binDataSize < 0 ||
+                    static_cast<uint64_t>(binDataSize) > remaining - sizeof(int32_t) - 1) {
+                    return false;
+                }
+                pos += sizeof(int32_t) + 1 + binDataSize;
+                break;
+            }
+
+            case Object:
+            case Array: {
+                if (remaining < 5 || depth == kFastPathMaxDepth) {
+                    return false;
+                }
+                const int32_t objSize = readInt32(pos);
+                if (objSize < 5 || static_cast<uint64_t>(objSize) > remaining ||
+                    pos[objSize - 1] != EOO) {
+                    return false;
+                }
+                parentEnds[depth++] = end;
+                end = pos + objSize - 1;
+                pos += sizeof(int32_t);
+                break;
+            }
+
+            default:
+                // Includes CodeWScope, which is rare enough to leave to the full validator.
+                return false;
+        }
+    }
+}
+
 }  // namespace
 
 Status validateBSON(const char* originalBuffer, uint64_t maxLength, BSONVersion version) {
@@ -397,6 +565,21 @@ Status validateBSON(const char* originalBuffer, uint64_t maxLength, BSONVersion
         return Status(ErrorCodes::InvalidBSON, "bson data has to be at least 5 bytes");
     }
 
+    if (MONGO_likely(validateBSONFastPath(originalBuffer, maxLength, version))) {
+        return Status::OK();
+    }
+
+    Buffer buf(originalBuffer, maxLength, version);
+    return validateBSONIterative(&buf);
+}
+
+Status validateBSONElementwise(const char* originalBuffer,
+                               uint64_t maxLength,
+                               BSONVersion version) {
+    if (maxLength < 5) {
+        return Status(ErrorCodes::InvalidBSON, "bson data has to be at least 5 bytes");
+    }
+
     Buffer buf(originalBuffer, maxLength, version);
     return validateBSONIterative(&buf);
 }
@@ -46,4 +46,10 @@ class Status;
  */
 Status validateBSON(const char* buf, uint64_t maxLength, BSONVersion version);
 
+/**
+ * Same as validateBSON(), but always walks the data element by element instead of first trying
+ * the single pass fast path. Exposed for tests and benchmarks which compare the two.
+ */
+Status validateBSONElementwise(const char* buf, uint64_t maxLength, BSONVersion version);
+
 }  // namespace mongo
@@ -193,6 +193,53 @@ TEST(BSONValidate, Fuzz) {
     }
 }
 
+TEST(BSONValidate, FastPathAgreesWithElementwiseValidation) {
+    int64_t seed = time(0);
+    log() << "BSONValidate FastPathAgreesWithElementwiseValidation random seed: " << seed << endl;
+    PseudoRandom randomSource(seed);
+
+    BSONObjBuilder builder;
+    builder.append("_id", OID("deadbeefdeadbeefdeadbeef"));
+    builder.append("int", 3);
+    builder.append("long", 1LL << 40);
+    builder.append("double", 2.5);
+    builder.append("decimal", Decimal128("1.5"));
+    builder.append("bool", true);
+    builder.append("string", "hello");
+    builder.appendCode("code", "x = 1");
+    builder.appendSymbol("symbol", "sym");
+    builder.appendNull("null");
+    builder.appendMinKey("min");
+    builder.appendMaxKey("max");
+    builder.append("timestamp", Timestamp(1, 2));
+    builder.append("date", Date_t::fromMillisSinceEpoch(44));
+    builder.append("regex", BSONRegEx("foooooo", "i"));
+    builder.append("dbref", BSONDBRef("rrr", OID("01234567890123456789aaaa")));
+    builder.append("binData", BSONBinData("\x69\xb7", 2, BinDataGeneral));
+    builder.append("array", BSON_ARRAY(1 << 2 << BSON("three" << BSON_ARRAY(3))));
+    builder.append("object", BSON("a" << BSON("b" << BSON("c" << 4))));
+    // No code with scope, which the fast path always leaves to the elementwise validator.
+    const BSONObj original = builder.obj();
+
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+        unique_ptr<char[]> buffer(new char[original.objsize()]);
+        memcpy(buffer.get(), original.objdata(), original.objsize());
+
+        // Corrupt a few random bytes after the size of the object.
+        const int numCorruptions = 1 + randomSource.nextInt32(3);
+        for (int i = 0; i < numCorruptions; ++i) {
+            buffer[4 + randomSource.nextInt32(original.objsize() - 4)] =
+                static_cast<char>(randomSource.nextInt32(256));
+        }
+
+        for (auto version : {BSONVersion::kV1_0, BSONVersion::kLatest}) {
+            ASSERT_EQUALS(
+                validateBSONElementwise(buffer.get(), original.objsize(), version).isOK(),
+                validateBSON(buffer.get(), original.objsize(), version).isOK());
+        }
+    }
+}
+
 TEST(BSONValidateFast, Empty) {
     BSONObj x;
     ASSERT_OK(validateBSON(x.objdata(), x.objsize(), BSONVersion::kLatest));
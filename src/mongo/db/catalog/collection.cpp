@@ -272,10 +272,11 @@ std::unique_ptr<SeekableRecordCursor> Collection::getCursor(OperationContext* tx
     return _recordStore->getCursor(txn, forward);
 }
 
-vector<std::unique_ptr<RecordCursor>> Collection::getManyCursors(OperationContext* txn) const {
+vector<std::unique_ptr<RecordCursor>> Collection::getManyCursors(OperationContext* txn,
+                                                                 size_t numCursorsHint) const {
     dassert(txn->lockState()->isCollectionLockedForMode(ns().toString(), MODE_IS));
 
-    return _recordStore->getManyCursors(txn);
+    return _recordStore->getManyCursors(txn, numCursorsHint);
 }
 
 Snapshotted<BSONObj> Collection::docFor(OperationContext* txn, const RecordId& loc) const {
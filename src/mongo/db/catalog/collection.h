@@ -241,9 +241,11 @@ public:
 
     /**
      * Returns many cursors that partition the Collection into many disjoint sets. Iterating
-     * all returned cursors is equivalent to iterating the full collection.
+     * all returned cursors is equivalent to iterating the full collection. 'numCursorsHint' is
+     * passed through to the RecordStore, which may return more or fewer cursors than requested.
      */
-    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn) const;
+    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn,
+                                                              size_t numCursorsHint) const;
 
     /**
      * Deletes the document with the given RecordId from the collection.
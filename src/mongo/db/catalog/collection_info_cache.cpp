@@ -54,6 +54,7 @@ CollectionInfoCache::CollectionInfoCache(Collection* collection)
       _keysComputed(false),
       _planCache(new PlanCache(collection->ns().ns())),
       _querySettings(new QuerySettings()),
+      _geoNearDensityCache(new GeoNearDensityCache()),
       _indexUsageTracker(getGlobalServiceContext()->getPreciseClockSource()) {}
 
 CollectionInfoCache::~CollectionInfoCache() {
@@ -167,6 +168,10 @@ QuerySettings* CollectionInfoCache::getQuerySettings() const {
     return _querySettings.get();
 }
 
+GeoNearDensityCache* CollectionInfoCache::getGeoNearDensityCache() const {
+    return _geoNearDensityCache.get();
+}
+
 void CollectionInfoCache::updatePlanCacheIndexEntries(OperationContext* txn) {
     std::vector<IndexEntry> indexEntries;
 
@@ -229,6 +234,9 @@ void CollectionInfoCache::droppedIndex(OperationContext* txn, StringData indexNa
 void CollectionInfoCache::rebuildIndexData(OperationContext* txn) {
     clearQueryCache();
 
+    // An index may have been dropped and recreated under the same name.
+    _geoNearDensityCache->clear();
+
     _keysComputed = false;
     computeIndexKeys(txn);
     updatePlanCacheIndexEntries(txn);
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "mongo/db/collection_index_usage_tracker.h"
+#include "mongo/db/query/geo_near_density_cache.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
@@ -61,6 +62,11 @@ public:
      */
     QuerySettings* getQuerySettings() const;
 
+    /**
+     * Get the densities learned by geo near searches over this collection's indexes.
+     */
+    GeoNearDensityCache* getGeoNearDensityCache() const;
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
@@ -121,6 +127,9 @@ private:
     // Includes index filters.
     std::unique_ptr<QuerySettings> _querySettings;
 
+    // Densities learned by geo near searches.
+    std::unique_ptr<GeoNearDensityCache> _geoNearDensityCache;
+
     // Tracks index usage statistics for this collection.
     CollectionIndexUsageTracker _indexUsageTracker;
 
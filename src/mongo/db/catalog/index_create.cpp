@@ -47,7 +47,9 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -65,6 +67,32 @@ MONGO_FP_DECLARE(crashAfterStartingIndexBuild);
 MONGO_FP_DECLARE(hangAfterStartingIndexBuild);
 MONGO_FP_DECLARE(hangAfterStartingIndexBuildUnlocked);
 
+namespace {
+
+// Threads a foreground index build uses to generate the keys of the documents it scans.
+int internalIndexBuildKeyGenerationThreads = 1;
+class ExportedKeyGenerationThreadsParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupOnly> {
+public:
+    ExportedKeyGenerationThreadsParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupOnly>(
+              ServerParameterSet::getGlobal(),
+              "internalIndexBuildKeyGenerationThreads",
+              &internalIndexBuildKeyGenerationThreads) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        if (potentialNewValue < 1 || potentialNewValue > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "internalIndexBuildKeyGenerationThreads must be between 1 and 128");
+        }
+
+        return Status::OK();
+    }
+
+} exportedKeyGenerationThreadsParam;
+
+}  // namespace
+
 /**
  * On rollback sets MultiIndexBlock::_needToCleanup to true.
  */
@@ -99,12 +127,146 @@ private:
     MultiIndexBlock* const _indexer;
 };
 
+/**
+ * Generates the keys of a foreground index build on a pool of threads.
+ *
+ * The scanning thread copies documents into a batch. Once the batch is full it is split into one
+ * slice per thread, and each thread inserts the keys of its slice into its own partition of every
+ * index's BulkBuilder, while the scanning thread fills the next batch. Only one batch is processed
+ * at a time, so no two threads ever use the same partition at once.
+ */
+class MultiIndexBlock::ParallelBulkInserter {
+    MONGO_DISALLOW_COPYING(ParallelBulkInserter);
+
+public:
+    ParallelBulkInserter(MultiIndexBlock* indexer, size_t numThreads)
+        : _indexer(indexer), _numThreads(numThreads), _pool(makePoolOptions(numThreads)) {
+        _pool.startup();
+    }
+
+    ~ParallelBulkInserter() {
+        _pool.shutdown();
+        _pool.join();
+    }
+
+    /**
+     * Adds a copy of 'doc' to the current batch, starting the batch if it is full. Returns the
+     * first error from the previous batch, if there was one.
+     */
+    Status insert(const BSONObj& doc, const RecordId& loc) {
+        _batch.emplace_back(doc.getOwned(), loc);
+        _batchBytes += doc.objsize();
+        if (_batch.size() < kMaxBatchDocuments && _batchBytes < kMaxBatchBytes) {
+            return Status::OK();
+        }
+
+        Status status = _waitForBatchInProgress();
+        if (!status.isOK()) {
+            return status;
+        }
+        _startBatch();
+        return Status::OK();
+    }
+
+    /**
+     * Inserts the keys of any remaining documents and waits for all of them to be inserted.
+     */
+    Status finish() {
+        Status status = _waitForBatchInProgress();
+        if (!status.isOK()) {
+            return status;
+        }
+        _startBatch();
+        return _waitForBatchInProgress();
+    }
+
+private:
+    static const size_t kMaxBatchDocuments = 16 * 1024;
+    static const int kMaxBatchBytes = 16 * 1024 * 1024;
+
+    static ThreadPool::Options makePoolOptions(size_t numThreads) {
+        ThreadPool::Options options;
+        options.poolName = "IndexBuildKeyGeneration";
+        options.minThreads = numThreads;
+        options.maxThreads = numThreads;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+        };
+        return options;
+    }
+
+    Status _waitForBatchInProgress() {
+        _pool.waitForIdle();
+        _batchInProgress.clear();
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _status;
+    }
+
+    void _startBatch() {
+        _batchInProgress.swap(_batch);
+        _batchBytes = 0;
+        if (_batchInProgress.empty()) {
+            return;
+        }
+
+        for (size_t slice = 0; slice < _numThreads; slice++) {
+            fassertStatusOK(40322, _pool.schedule([this, slice] { _insertSlice(slice); }));
+        }
+    }
+
+    void _insertSlice(size_t slice) {
+        const size_t begin = _batchInProgress.size() * slice / _numThreads;
+        const size_t end = _batchInProgress.size() * (slice + 1) / _numThreads;
+
+        Status status = Status::OK();
+        try {
+            for (size_t i = begin; i < end && status.isOK(); i++) {
+                const BSONObj& doc = _batchInProgress[i].first;
+                for (auto&& index : _indexer->_indexes) {
+                    if (index.filterExpression && !index.filterExpression->matchesBSON(doc)) {
+                        continue;
+                    }
+
+                    int64_t unused;
+                    status = index.bulk->insert(
+                        nullptr, doc, _batchInProgress[i].second, index.options, &unused, slice);
+                    if (!status.isOK()) {
+                        break;
+                    }
+                }
+            }
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+
+        if (!status.isOK()) {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (_status.isOK()) {
+                _status = status;
+            }
+        }
+    }
+
+    MultiIndexBlock* const _indexer;
+    const size_t _numThreads;
+    ThreadPool _pool;
+
+    std::vector<std::pair<BSONObj, RecordId>> _batch;  // filled by the scanning thread
+    int _batchBytes = 0;
+    std::vector<std::pair<BSONObj, RecordId>> _batchInProgress;  // read by the pool threads
+
+    stdx::mutex _mutex;
+    Status _status = Status::OK();  // The first error from any slice. Guarded by _mutex.
+};
+
 MultiIndexBlock::MultiIndexBlock(OperationContext* txn, Collection* collection)
     : _collection(collection),
       _txn(txn),
       _buildInBackground(false),
       _allowInterruption(false),
       _ignoreUnique(false),
+      _keyGenerationThreads(internalIndexBuildKeyGenerationThreads),
       _needToCleanup(true) {}
 
 MultiIndexBlock::~MultiIndexBlock() {
@@ -260,6 +422,17 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
 
     unsigned long long n = 0;
 
+    // A foreground build may generate its keys on several threads. Its BulkBuilders are only split
+    // into one partition per thread here, since the partitions share the sort's memory budget and
+    // insert() only ever uses the first. None of them has been inserted into yet.
+    unique_ptr<ParallelBulkInserter> parallelInserter;
+    if (!_buildInBackground && !_indexes.empty() && _keyGenerationThreads > 1) {
+        for (auto&& index : _indexes) {
+            index.bulk = index.real->initiateBulk(_keyGenerationThreads);
+        }
+        parallelInserter.reset(new ParallelBulkInserter(this, _keyGenerationThreads));
+    }
+
     unique_ptr<PlanExecutor> exec(InternalPlanner::collectionScan(
         _txn, _collection->ns().ns(), _collection, PlanExecutor::YIELD_MANUAL));
     if (_buildInBackground) {
@@ -291,7 +464,8 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
             progress->setTotalWhileRunning(_collection->numRecords(_txn));
 
             WriteUnitOfWork wunit(_txn);
-            Status ret = insert(objToIndex.value(), loc);
+            Status ret = parallelInserter ? parallelInserter->insert(objToIndex.value(), loc)
+                                          : insert(objToIndex.value(), loc);
             if (_buildInBackground)
                 exec->saveState();
             if (ret.isOK()) {
@@ -329,6 +503,12 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
                 WorkingSetCommon::toStatusString(objToIndex.value()),
             state == PlanExecutor::IS_EOF);
 
+    if (parallelInserter) {
+        Status ret = parallelInserter->finish();
+        if (!ret.isOK())
+            return ret;
+    }
+
     // Need the index build to hang before the progress meter is marked as finished so we can
     // reliably check that the index build has actually started in js tests.
     while (MONGO_FAIL_POINT(hangAfterStartingIndexBuild)) {
@@ -99,6 +99,16 @@ public:
         _ignoreUnique = true;
     }
 
+    /**
+     * Call this before init() to generate the keys of a foreground build on 'numThreads' threads.
+     * This only affects builds using the insertAllDocumentsInCollection helper, which must not be
+     * combined with insert(), and defaults to the internalIndexBuildKeyGenerationThreads server
+     * parameter.
+     */
+    void setKeyGenerationThreads(size_t numThreads) {
+        _keyGenerationThreads = numThreads;
+    }
+
     /**
      * Removes pre-existing indexes from 'specs'. If this isn't done, init() may fail with
      * IndexAlreadyExists.
@@ -189,6 +199,7 @@ public:
 private:
     class SetNeedToCleanupOnRollback;
     class CleanupIndexesVectorOnRollback;
+    class ParallelBulkInserter;
 
     struct IndexToBuild {
         std::unique_ptr<IndexCatalog::IndexBuildBlock> block;
@@ -211,6 +222,7 @@ private:
     bool _buildInBackground;
     bool _allowInterruption;
     bool _ignoreUnique;
+    size_t _keyGenerationThreads;
 
     bool _needToCleanup;
 };
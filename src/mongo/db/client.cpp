@@ -90,6 +90,19 @@ void Client::destroy() {
     currentClient.reset(nullptr);
 }
 
+ServiceContext::UniqueClient Client::releaseCurrent() {
+    invariant(currentClient.get());
+    invariant(currentClient.get()->get());
+    return std::move(*currentClient.get());
+}
+
+void Client::setCurrent(ServiceContext::UniqueClient client) {
+    invariant(client);
+    invariant(currentClient.getMake()->get() == nullptr);
+    setThreadName(client->desc().c_str());
+    *currentClient.get() = std::move(client);
+}
+
 namespace {
 int64_t generateSeed(const std::string& desc) {
     size_t seed = 0;
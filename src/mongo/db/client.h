@@ -133,6 +133,21 @@ public:
      */
     static void destroy();
 
+    /**
+     * Detaches the Client object stored in TLS for the current thread and returns it to the
+     * caller. The current thread must have a Client.
+     *
+     * Used by service entry points that multiplex many sessions onto a small pool of threads, so
+     * that a session's Client can follow it from one worker thread to the next.
+     */
+    static ServiceContext::UniqueClient releaseCurrent();
+
+    /**
+     * Attaches 'client' to the current thread, which must not already have a Client, and sets
+     * the thread name to the Client's description.
+     */
+    static void setCurrent(ServiceContext::UniqueClient client);
+
     std::string clientAddress(bool includePort = false) const;
     const std::string& desc() const {
         return _desc;
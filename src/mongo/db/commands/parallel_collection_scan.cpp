@@ -110,7 +110,7 @@ public:
                                                   << " was: "
                                                   << numCursors));
 
-        auto iterators = collection->getManyCursors(txn);
+        auto iterators = collection->getManyCursors(txn, numCursors);
         if (iterators.size() < numCursors) {
             numCursors = iterators.size();
         }
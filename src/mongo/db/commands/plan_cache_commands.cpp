@@ -265,6 +265,17 @@ Status PlanCacheListQueryShapes::list(const PlanCache& planCache, BSONObjBuilder
     }
     arrayBuilder.doneFast();
 
+    BSONArrayBuilder partitionsBuilder(bob->subarrayStart("partitions"));
+    for (auto&& stats : planCache.getPartitionStats()) {
+        BSONObjBuilder statsBuilder(partitionsBuilder.subobjStart());
+        statsBuilder.appendNumber("numEntries", static_cast<long long>(stats.numEntries));
+        statsBuilder.appendNumber("hits", stats.hits);
+        statsBuilder.appendNumber("misses", stats.misses);
+        statsBuilder.appendNumber("evictions", stats.evictions);
+        statsBuilder.doneFast();
+    }
+    partitionsBuilder.doneFast();
+
     return Status::OK();
 }
 
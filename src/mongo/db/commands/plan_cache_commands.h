@@ -119,7 +119,8 @@ public:
 
     /**
      * Looks up cache keys for collection's plan cache.
-     * Inserts keys for query into BSON builder.
+     * Inserts keys for query into BSON builder, followed by the hit/miss/eviction counters of
+     * each cache partition.
      */
     static Status list(const PlanCache& planCache, BSONObjBuilder* bob);
 };
@@ -131,6 +131,25 @@ TEST(PlanCacheCommandsTest, planCacheListQueryShapesEmpty) {
     ASSERT_TRUE(shapes.empty());
 }
 
+TEST(PlanCacheCommandsTest, planCacheListQueryShapesReportsPartitionStats) {
+    PlanCache empty;
+    BSONObjBuilder bob;
+    ASSERT_OK(PlanCacheListQueryShapes::list(empty, &bob));
+    BSONObj resultObj = bob.obj();
+    BSONElement partitionsElt = resultObj.getField("partitions");
+    ASSERT_EQUALS(partitionsElt.type(), mongo::Array);
+    vector<BSONElement> partitions = partitionsElt.Array();
+    ASSERT_EQUALS(partitions.size(), empty.getPartitionStats().size());
+    for (auto&& partition : partitions) {
+        ASSERT_EQUALS(partition.type(), mongo::Object);
+        BSONObj stats = partition.Obj();
+        ASSERT_EQUALS(stats["numEntries"].numberLong(), 0LL);
+        ASSERT_EQUALS(stats["hits"].numberLong(), 0LL);
+        ASSERT_EQUALS(stats["misses"].numberLong(), 0LL);
+        ASSERT_EQUALS(stats["evictions"].numberLong(), 0LL);
+    }
+}
+
 TEST(PlanCacheCommandsTest, planCacheListQueryShapesOneKey) {
     QueryTestServiceContext serviceContext;
     auto txn = serviceContext.makeOperationContext();
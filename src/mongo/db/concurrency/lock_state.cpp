@@ -38,6 +38,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/util/background.h"
+#include "mongo/util/concurrency/partitioned_counter.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
@@ -47,7 +48,9 @@ namespace mongo {
 namespace {
 
 /**
- * Partitioned global lock statistics, so we don't hit the same bucket.
+ * Partitioned global lock statistics, so we don't hit the same bucket. Each thread updates the
+ * partition picked by getCounterPartitionForCurrentThread(), so concurrent operations mostly write
+ * to different cache lines, and report() folds the partitions together.
  */
 class PartitionedInstanceWideLockStats {
     MONGO_DISALLOW_COPYING(PartitionedInstanceWideLockStats);
@@ -55,20 +58,20 @@ class PartitionedInstanceWideLockStats {
 public:
     PartitionedInstanceWideLockStats() {}
 
-    void recordAcquisition(LockerId id, ResourceId resId, LockMode mode) {
-        _get(id).recordAcquisition(resId, mode);
+    void recordAcquisition(ResourceId resId, LockMode mode) {
+        _get().recordAcquisition(resId, mode);
     }
 
-    void recordWait(LockerId id, ResourceId resId, LockMode mode) {
-        _get(id).recordWait(resId, mode);
+    void recordWait(ResourceId resId, LockMode mode) {
+        _get().recordWait(resId, mode);
     }
 
-    void recordWaitTime(LockerId id, ResourceId resId, LockMode mode, uint64_t waitMicros) {
-        _get(id).recordWaitTime(resId, mode, waitMicros);
+    void recordWaitTime(ResourceId resId, LockMode mode, uint64_t waitMicros) {
+        _get().recordWaitTime(resId, mode, waitMicros);
     }
 
     void recordDeadlock(ResourceId resId, LockMode mode) {
-        _get(resId).recordDeadlock(resId, mode);
+        _get().recordDeadlock(resId, mode);
     }
 
     void report(SingleThreadedLockStats* outStats) const {
@@ -90,11 +93,11 @@ private:
         AtomicLockStats stats;
     };
 
-    enum { NumPartitions = 8 };
+    enum { NumPartitions = 16 };
 
 
-    AtomicLockStats& _get(LockerId id) {
-        return _partitions[id % NumPartitions].stats;
+    AtomicLockStats& _get() {
+        return _partitions[getCounterPartitionForCurrentThread() % NumPartitions].stats;
     }
 
 
@@ -363,7 +366,7 @@ void LockerImpl<IsForMMAPV1>::downgradeGlobalXtoSForMMAPV1() {
     // so it's OK.
 
     // Making this call here will record lock downgrades as acquisitions, which is acceptable
-    globalStats.recordAcquisition(_id, resourceIdGlobal, MODE_S);
+    globalStats.recordAcquisition(resourceIdGlobal, MODE_S);
     _stats.recordAcquisition(resourceIdGlobal, MODE_S);
 
     globalLockManager.downgrade(globalLockRequest, MODE_S);
@@ -674,7 +677,7 @@ LockResult LockerImpl<IsForMMAPV1>::lockBegin(ResourceId resId, LockMode mode) {
     }
 
     // Making this call here will record lock re-acquisitions and conversions as well.
-    globalStats.recordAcquisition(_id, resId, mode);
+    globalStats.recordAcquisition(resId, mode);
     _stats.recordAcquisition(resId, mode);
 
     // Give priority to the full modes for global, parallel batch writer mode,
@@ -707,7 +710,7 @@ LockResult LockerImpl<IsForMMAPV1>::lockBegin(ResourceId resId, LockMode mode) {
                               : globalLockManager.convert(resId, request, mode);
 
     if (result == LOCK_WAITING) {
-        globalStats.recordWait(_id, resId, mode);
+        globalStats.recordWait(resId, mode);
         _stats.recordWait(resId, mode);
     }
 
@@ -747,7 +750,7 @@ LockResult LockerImpl<IsForMMAPV1>::lockComplete(ResourceId resId,
         const uint64_t elapsedTimeMicros = curTimeMicros - startOfCurrentWaitTime;
         startOfCurrentWaitTime = curTimeMicros;
 
-        globalStats.recordWaitTime(_id, resId, mode, elapsedTimeMicros);
+        globalStats.recordWaitTime(resId, mode, elapsedTimeMicros);
         _stats.recordWaitTime(resId, mode, elapsedTimeMicros);
 
         if (result == LOCK_OK)
@@ -28,35 +28,39 @@
 
 #include "mongo/platform/basic.h"
 
-#include "mongo/base/counter.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/util/concurrency/partitioned_counter.h"
 
 namespace mongo {
 namespace {
-Counter64 returnedCounter;
-Counter64 insertedCounter;
-Counter64 updatedCounter;
-Counter64 deletedCounter;
-Counter64 scannedCounter;
-Counter64 scannedObjectCounter;
+// These are bumped at the end of every operation, so spread them over per-thread partitions.
+PartitionedCounter64 returnedCounter;
+PartitionedCounter64 insertedCounter;
+PartitionedCounter64 updatedCounter;
+PartitionedCounter64 deletedCounter;
+PartitionedCounter64 scannedCounter;
+PartitionedCounter64 scannedObjectCounter;
 
-ServerStatusMetricField<Counter64> displayReturned("document.returned", &returnedCounter);
-ServerStatusMetricField<Counter64> displayUpdated("document.updated", &updatedCounter);
-ServerStatusMetricField<Counter64> displayInserted("document.inserted", &insertedCounter);
-ServerStatusMetricField<Counter64> displayDeleted("document.deleted", &deletedCounter);
-ServerStatusMetricField<Counter64> displayScanned("queryExecutor.scanned", &scannedCounter);
-ServerStatusMetricField<Counter64> displayScannedObjects("queryExecutor.scannedObjects",
-                                                         &scannedObjectCounter);
+ServerStatusMetricField<PartitionedCounter64> displayReturned("document.returned",
+                                                              &returnedCounter);
+ServerStatusMetricField<PartitionedCounter64> displayUpdated("document.updated", &updatedCounter);
+ServerStatusMetricField<PartitionedCounter64> displayInserted("document.inserted",
+                                                              &insertedCounter);
+ServerStatusMetricField<PartitionedCounter64> displayDeleted("document.deleted", &deletedCounter);
+ServerStatusMetricField<PartitionedCounter64> displayScanned("queryExecutor.scanned",
+                                                             &scannedCounter);
+ServerStatusMetricField<PartitionedCounter64> displayScannedObjects("queryExecutor.scannedObjects",
+                                                                    &scannedObjectCounter);
 
-Counter64 scanAndOrderCounter;
-Counter64 writeConflictsCounter;
+PartitionedCounter64 scanAndOrderCounter;
+PartitionedCounter64 writeConflictsCounter;
 
-ServerStatusMetricField<Counter64> displayScanAndOrder("operation.scanAndOrder",
-                                                       &scanAndOrderCounter);
-ServerStatusMetricField<Counter64> displayWriteConflicts("operation.writeConflicts",
-                                                         &writeConflictsCounter);
+ServerStatusMetricField<PartitionedCounter64> displayScanAndOrder("operation.scanAndOrder",
+                                                                  &scanAndOrderCounter);
+ServerStatusMetricField<PartitionedCounter64> displayWriteConflicts("operation.writeConflicts",
+                                                                    &writeConflictsCounter);
 
 }  // namespace
 
@@ -119,7 +119,7 @@
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
-#include "mongo/transport/transport_layer_legacy.h"
+#include "mongo/transport/transport_layer_factory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/cmdline_utils/censor_cmdline.h"
 #include "mongo/util/concurrency/task.h"
@@ -563,10 +563,6 @@ ExitCode _initAndListen(int listenPort) {
 
     checked_cast<ServiceContextMongoD*>(getGlobalServiceContext())->createLockFile();
 
-    transport::TransportLayerLegacy::Options options;
-    options.port = listenPort;
-    options.ipList = serverGlobalParams.bind_ip;
-
     auto sep =
         stdx::make_unique<ServiceEntryPointMongod>(getGlobalServiceContext()->getTransportLayer());
     auto sepPtr = sep.get();
@@ -574,12 +570,13 @@ ExitCode _initAndListen(int listenPort) {
     getGlobalServiceContext()->setServiceEntryPoint(std::move(sep));
 
     // Create, start, and attach the TL
-    auto transportLayer = stdx::make_unique<transport::TransportLayerLegacy>(options, sepPtr);
-    auto res = transportLayer->setup();
-    if (!res.isOK()) {
-        error() << "Failed to set up listener: " << res;
+    auto swTransportLayer =
+        transport::makeIngressTransportLayer(listenPort, serverGlobalParams.bind_ip, sepPtr);
+    if (!swTransportLayer.isOK()) {
+        error() << "Failed to set up listener: " << swTransportLayer.getStatus();
         return EXIT_NET_ERROR;
     }
+    auto transportLayer = std::move(swTransportLayer.getValue());
 
     std::shared_ptr<DbWebServer> dbWebServer;
     if (serverGlobalParams.isHttpInterfaceEnabled) {
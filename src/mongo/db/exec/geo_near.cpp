@@ -36,6 +36,7 @@
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/working_set_computed_data.h"
@@ -46,6 +47,7 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/query/expression_index.h"
 #include "mongo/db/query/expression_index_knobs.h"
+#include "mongo/db/query/geo_near_density_cache.h"
 #include "mongo/util/log.h"
 
 #include <algorithm>
@@ -733,6 +735,48 @@ static int getFieldPosition(const IndexDescriptor* index, const string& fieldNam
 
 static const string kS2IndexNearStage("GEO_NEAR_2DSPHERE");
 
+namespace {
+
+// Densities are learned for the S2 cells at this level, which are about 10km across.
+const int kDensityCellLevel = 10;
+
+// The number of documents to aim for in each annulus after the first, when sizing annuli from the
+// density of the documents found.
+const double kTargetIntervalResults = 450;
+
+// How much the increment may shrink or grow from one annulus to the next, so that one unusual
+// annulus does not throw the search off.
+const double kMaxBoundsIncrementShrink = 4;
+const double kMaxBoundsIncrementGrowth = 16;
+
+// How much the increment grows after an annulus with no documents.
+const double kEmptyIntervalGrowth = 4;
+
+/**
+ * Returns true if the search finds every document near the query point, so that the density of
+ * the documents it finds is that of the whole collection there. A filter, or bounds on another
+ * field of the index, would instead make the density that of only the documents it selects.
+ */
+bool searchesAllDocuments(const GeoNearParams& nearParams, int s2FieldPosition) {
+    if (nearParams.filter) {
+        return false;
+    }
+
+    const Interval allValues = IndexBoundsBuilder::allValues();
+    const vector<OrderedIntervalList>& fields = nearParams.baseBounds.fields;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (static_cast<int>(i) == s2FieldPosition) {
+            continue;
+        }
+        if (fields[i].intervals.size() != 1 || !fields[i].intervals[0].equals(allValues)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
 GeoNear2DSphereStage::GeoNear2DSphereStage(const GeoNearParams& nearParams,
                                            OperationContext* txn,
                                            WorkingSet* workingSet,
@@ -754,12 +798,48 @@ GeoNear2DSphereStage::GeoNear2DSphereStage(const GeoNearParams& nearParams,
     // strings, and _nearParams.filter should have the collator.
     const CollatorInterface* collator = nullptr;
     ExpressionParams::initialize2dsphereParams(s2Index->infoObj(), collator, &_indexParams);
+
+    const S2CellId& centerId = _nearParams.nearQuery->centroid->cell.id();
+    if (collection && internalGeoNearQueryAdaptiveSearch.load() &&
+        centerId.level() >= kDensityCellLevel) {
+        _densityCache = collection->infoCache()->getGeoNearDensityCache();
+        _densityCellId = centerId.parent(kDensityCellLevel).id();
+        _recordsDensity = searchesAllDocuments(
+            _nearParams, getFieldPosition(_s2Index, _nearParams.nearQuery->field));
+    }
 }
 
 GeoNear2DSphereStage::~GeoNear2DSphereStage() {}
 
 namespace {
 
+/**
+ * Returns the area of a spherical cap on the earth, in square meters, given its radius in meters.
+ */
+double capArea(double radius) {
+    const double halfAngle = std::min(radius / kRadiusOfEarthInMeters, M_PI) / 2;
+    const double sinHalfAngle = std::sin(halfAngle);
+    return 4 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters * sinHalfAngle *
+        sinHalfAngle;
+}
+
+/**
+ * Returns the radius of a spherical cap on the earth, in meters, given its area in square meters.
+ * The inverse of capArea().
+ */
+double capRadius(double area) {
+    const double earthArea = 4 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters;
+    return 2 * std::asin(std::sqrt(std::min(area / earthArea, 1.0))) * kRadiusOfEarthInMeters;
+}
+
+/**
+ * Returns the increment for the first annulus of a search near documents at the given density.
+ * Like the density estimator, this is three times the radius that holds one document on average.
+ */
+double initialBoundsIncrement(double density) {
+    return 3 * capRadius(1 / density);
+}
+
 S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Internal bounds come in SPHERE CRS units
     // i.e. center is lon/lat, inner/outer are in meters
@@ -918,6 +998,18 @@ PlanStage::StageState GeoNear2DSphereStage::initialize(OperationContext* txn,
                                                        Collection* collection,
                                                        WorkingSetID* out) {
     if (!_densityEstimator) {
+        if (_densityCache) {
+            boost::optional<double> density =
+                _densityCache->getDensity(_s2Index->indexName(), _densityCellId);
+            if (density) {
+                // An earlier search near this point learned how dense the documents are here.
+                _boundsIncrement = initialBoundsIncrement(*density);
+                invariant(_boundsIncrement > 0.0);
+                _specificStats.densityFromCache = true;
+                return IS_EOF;
+            }
+        }
+
         _densityEstimator.reset(
             new DensityEstimator(&_children, _s2Index, &_nearParams, _indexParams));
     }
@@ -937,6 +1029,12 @@ PlanStage::StageState GeoNear2DSphereStage::initialize(OperationContext* txn,
         _boundsIncrement = 3 * estimatedDistance;
         invariant(_boundsIncrement > 0.0);
 
+        if (_recordsDensity) {
+            // Remember the density as one document within the estimated distance.
+            _densityCache->recordDensity(
+                _s2Index->indexName(), _densityCellId, 1 / capArea(estimatedDistance));
+        }
+
         // Clean up
         _densityEstimator.reset(NULL);
     }
@@ -960,11 +1058,14 @@ StatusWith<NearStage::CoveredInterval*>  //
     if (!_specificStats.intervalStats.empty()) {
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
 
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
+        if (_densityCache) {
+            adaptBoundsIncrement();
+        } else if (lastIntervalStats.numResultsReturned < 300) {
+            // TODO: Generally we want small numbers of results fast, then larger numbers later
             _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
+        } else if (lastIntervalStats.numResultsReturned > 600) {
             _boundsIncrement /= 2;
+        }
     }
 
     invariant(_boundsIncrement > 0.0);
@@ -1027,6 +1128,32 @@ StatusWith<NearStage::CoveredInterval*>  //
                                                             isLastInterval));
 }
 
+void GeoNear2DSphereStage::adaptBoundsIncrement() {
+    // The last interval is complete, so it returned all the documents within its bounds.
+    const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
+    const double lastArea = capArea(lastIntervalStats.maxDistanceAllowed) -
+        capArea(std::max(0.0, lastIntervalStats.minDistanceAllowed));
+
+    // Nothing is known about the density after an empty interval, beyond that it is low.
+    double nextIncrement = _boundsIncrement * kEmptyIntervalGrowth;
+    if (lastIntervalStats.numResultsReturned > 0 && lastArea > 0) {
+        const double density = lastIntervalStats.numResultsReturned / lastArea;
+        if (_recordsDensity && _specificStats.intervalStats.size() == 1) {
+            // The first interval is the best guide to the density right around the query point.
+            _densityCache->recordDensity(_s2Index->indexName(), _densityCellId, density);
+        }
+
+        // Size the next annulus to hold about kTargetIntervalResults documents at this density.
+        const double nextOuter =
+            capRadius(capArea(_currBounds.getOuter()) + kTargetIntervalResults / density);
+        nextIncrement = nextOuter - _currBounds.getOuter();
+    }
+
+    _boundsIncrement =
+        std::max(_boundsIncrement / kMaxBoundsIncrementShrink,
+                 std::min(nextIncrement, _boundsIncrement * kMaxBoundsIncrementGrowth));
+}
+
 StatusWith<double> GeoNear2DSphereStage::computeDistance(WorkingSetMember* member) {
     return computeGeoNearDistance(_nearParams, member);
 }
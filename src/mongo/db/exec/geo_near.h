@@ -42,6 +42,8 @@
 
 namespace mongo {
 
+class GeoNearDensityCache;
+
 /**
  * Generic parameters for a GeoNear search
  */
@@ -132,6 +134,13 @@ protected:
                                      WorkingSetID* out) final;
 
 private:
+    /**
+     * Sizes the next interval from the density of the documents found in the last one, so that
+     * each interval holds a steady number of documents. Learns the density from the first one
+     * when the search sees every document near the query point.
+     */
+    void adaptBoundsIncrement();
+
     const GeoNearParams _nearParams;
 
     // The 2D index we're searching over
@@ -154,6 +163,18 @@ private:
 
     class DensityEstimator;
     std::unique_ptr<DensityEstimator> _densityEstimator;
+
+    // Where the densities of documents are learned, or null if the search does not adapt its
+    // annuli to them. Not owned here.
+    GeoNearDensityCache* _densityCache = nullptr;
+
+    // The cell of '_densityCache' that the query point is in.
+    uint64_t _densityCellId = 0;
+
+    // Whether this search may teach '_densityCache' the density it finds. Only searches without a
+    // filter or bounds on other index fields see every document, so only they learn densities
+    // that later searches near this point can rely on.
+    bool _recordsDensity = false;
 };
 
 }  // namespace mongo
@@ -55,6 +55,7 @@ MergeSortStage::MergeSortStage(OperationContext* opCtx,
       _ws(ws),
       _pattern(params.pattern),
       _collator(params.collator),
+      _sortKeyEncoder(params.pattern, params.collator),
       _dedup(params.dedup),
       _merging(StageWithValueComparison(ws, params.pattern, params.collator)) {}
 
@@ -118,9 +119,10 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
             StageWithValue value;
             value.id = id;
             value.stage = child;
+            encodeSortKey(*member, &value.sortKey);
             // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
             member->makeObjOwnedIfNeeded();
-            _mergingData.push_front(value);
+            _mergingData.push_front(std::move(value));
 
             // Insert the result (indirectly) into our priority queue.
             _merging.push(_mergingData.begin());
@@ -200,6 +202,12 @@ void MergeSortStage::doInvalidate(OperationContext* txn,
 // the return from the expected value.
 bool MergeSortStage::StageWithValueComparison::operator()(const MergingRef& lhs,
                                                           const MergingRef& rhs) {
+    if (!lhs->sortKey.empty() && !rhs->sortKey.empty()) {
+        return lhs->sortKey > rhs->sortKey;
+    }
+
+    // At least one of the keys was too large to encode, so compare the results field by field,
+    // which orders keys the same way as their encodings.
     WorkingSetMember* lhsMember = _ws->get(lhs->id);
     WorkingSetMember* rhsMember = _ws->get(rhs->id);
 
@@ -230,6 +238,28 @@ bool MergeSortStage::StageWithValueComparison::operator()(const MergingRef& lhs,
     return false;
 }
 
+void MergeSortStage::encodeSortKey(const WorkingSetMember& member, std::string* out) {
+    BSONObjBuilder sortKey;
+    BSONObjIterator it(_pattern);
+    while (it.more()) {
+        string fn = it.next().fieldName();
+
+        BSONElement elt;
+        verify(member.getFieldDotted(fn, &elt));
+
+        // A missing field compares equal to undefined.
+        if (elt.eoo()) {
+            sortKey.appendUndefined("");
+        } else {
+            sortKey.appendAs(elt, "");
+        }
+    }
+
+    // Results are only ordered by the sort key. Encoding a null RecordId for all of them keeps
+    // equal keys equal.
+    _sortKeyEncoder.encode(sortKey.done(), RecordId(), out);
+}
+
 unique_ptr<PlanStageStats> MergeSortStage::getStats() {
     _commonStats.isEOF = isEOF();
 
@@ -30,11 +30,13 @@
 
 #include <list>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/query/sort_key_encoder.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
@@ -79,6 +81,12 @@ public:
     static const char* kStageType;
 
 private:
+    /**
+     * Replaces the contents of 'out' with the encoded sort key of 'member', or leaves it empty if
+     * the key is too large to encode.
+     */
+    void encodeSortKey(const WorkingSetMember& member, std::string* out);
+
     // Not owned by us.
     const Collection* _collection;
 
@@ -92,6 +100,10 @@ private:
     // represents the collator used to compare strings.
     const CollatorInterface* _collator;
 
+    // Encodes the values of the '_pattern' fields of each result, mapping strings through the
+    // collator if there is one.
+    SortKeyEncoder _sortKeyEncoder;
+
     // Are we deduplicating on RecordId?
     bool _dedup;
 
@@ -119,6 +131,9 @@ private:
         StageWithValue() : id(WorkingSet::INVALID_ID), stage(NULL) {}
         WorkingSetID id;
         PlanStage* stage;
+        // The result's sort key encoded by '_sortKeyEncoder', or empty if the key is too large to
+        // encode. It is computed once when the result arrives rather than on every comparison.
+        std::string sortKey;
     };
 
     // We have a priority queue of these.
@@ -124,7 +124,7 @@ PlanStage::StageState OplogStart::workExtentHopping(WorkingSetID* out) {
 
 void OplogStart::switchToExtentHopping() {
     // Set up our extent hopping state.
-    _subIterators = _collection->getManyCursors(getOpCtx());
+    _subIterators = _collection->getManyCursors(getOpCtx(), 1);
 
     // Transition from backwards scanning to extent hopping.
     _backwardsScanning = false;
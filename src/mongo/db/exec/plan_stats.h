@@ -597,6 +597,9 @@ struct NearStats : public SpecificStats {
     // btree index version, not geo index version
     int indexVersion;
     BSONObj keyPattern;
+    // Whether the first interval was sized from a density learned by earlier searches, rather than
+    // by probing the index.
+    bool densityFromCache = false;
 };
 
 struct UpdateStats : public SpecificStats {
@@ -677,6 +680,11 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // Number of results needed, if only the top scoring ones are, and whether they were found
+    // before reading every index key.
+    size_t topK = 0;
+    bool terminatedEarly = false;
 };
 
 }  // namespace mongo
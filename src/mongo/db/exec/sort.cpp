@@ -58,6 +58,10 @@ SortStage::WorkingSetComparator::WorkingSetComparator(BSONObj p) : pattern(p) {}
 
 bool SortStage::WorkingSetComparator::operator()(const SortableDataItem& lhs,
                                                  const SortableDataItem& rhs) const {
+    if (!lhs.encodedSortKey.empty() && !rhs.encodedSortKey.empty()) {
+        return lhs.encodedSortKey < rhs.encodedSortKey;
+    }
+
     // False means ignore field names.
     int result = lhs.sortKey.woCompare(rhs.sortKey, pattern, false);
     if (0 != result) {
@@ -77,18 +81,16 @@ SortStage::SortStage(OperationContext* opCtx,
       _pattern(params.pattern),
       _limit(params.limit),
       _sorted(false),
+      _sortKeyComparator(FindCommon::transformSortSpec(_pattern)),
+      _sortKeyEncoder(_sortKeyComparator.pattern, nullptr),
       _resultIterator(_data.end()),
       _memUsage(0) {
     _children.emplace_back(child);
 
-    BSONObj sortComparator = FindCommon::transformSortSpec(_pattern);
-    _sortKeyComparator = stdx::make_unique<WorkingSetComparator>(sortComparator);
-
     // If limit > 1, we need to initialize _dataSet here to maintain ordered set of data items while
     // fetching from the child stage.
     if (_limit > 1) {
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
-        _dataSet.reset(new SortableDataItemSet(cmp));
+        _dataSet.reset(new SortableDataItemSet(_sortKeyComparator));
     }
 }
 
@@ -148,7 +150,9 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
                 item.recordId = member->recordId;
             }
 
-            addToBuffer(item);
+            _sortKeyEncoder.encode(item.sortKey, item.recordId, &item.encodedSortKey);
+
+            addToBuffer(std::move(item));
 
             return PlanStage::NEED_TIME;
         } else if (PlanStage::IS_EOF == code) {
@@ -255,7 +259,7 @@ const SpecificStats* SortStage::getSpecificStats() const {
  *                     with lowest key. Updates memory usage accordingly.
  *     sortBuffer() - Copies items from set to vectors.
  */
-void SortStage::addToBuffer(const SortableDataItem& item) {
+void SortStage::addToBuffer(SortableDataItem item) {
     // Holds ID of working set member to be freed at end of this function.
     WorkingSetID wsidToFree = WorkingSet::INVALID_ID;
 
@@ -263,22 +267,22 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
     if (_limit == 0) {
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         member->makeObjOwnedIfNeeded();
-        _data.push_back(item);
+        _data.push_back(std::move(item));
         _memUsage += member->getMemUsage();
     } else if (_limit == 1) {
         if (_data.empty()) {
             member->makeObjOwnedIfNeeded();
-            _data.push_back(item);
+            _data.push_back(std::move(item));
             _memUsage = member->getMemUsage();
             return;
         }
         wsidToFree = item.wsid;
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
+        const WorkingSetComparator& cmp = _sortKeyComparator;
         // Compare new item with existing item in vector.
         if (cmp(item, _data[0])) {
             wsidToFree = _data[0].wsid;
             member->makeObjOwnedIfNeeded();
-            _data[0] = item;
+            _data[0] = std::move(item);
             _memUsage = member->getMemUsage();
         }
     } else {
@@ -287,7 +291,7 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
         vector<SortableDataItem>::size_type limit(_limit);
         if (_dataSet->size() < limit) {
             member->makeObjOwnedIfNeeded();
-            _dataSet->insert(item);
+            _dataSet->insert(std::move(item));
             _memUsage += member->getMemUsage();
             return;
         }
@@ -297,7 +301,7 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
         wsidToFree = item.wsid;
         SortableDataItemSet::const_iterator lastItemIt = --(_dataSet->end());
         const SortableDataItem& lastItem = *lastItemIt;
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
+        const WorkingSetComparator& cmp = _sortKeyComparator;
         if (cmp(item, lastItem)) {
             _memUsage -= _ws->get(lastItem.wsid)->getMemUsage();
             _memUsage += member->getMemUsage();
@@ -308,7 +312,7 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
             // used by the last item and to keep the scope of the iterator to a minimum.
             _dataSet->erase(lastItemIt);
             member->makeObjOwnedIfNeeded();
-            _dataSet->insert(item);
+            _dataSet->insert(std::move(item));
         }
     }
 
@@ -325,7 +329,7 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
 
 void SortStage::sortBuffer() {
     if (_limit == 0) {
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
+        const WorkingSetComparator& cmp = _sortKeyComparator;
         std::sort(_data.begin(), _data.end(), cmp);
     } else if (_limit == 1) {
         // Buffer contains either 0 or 1 item so it is already in a sorted state.
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <set>
+#include <string>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
@@ -36,6 +37,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/sort_key_encoder.h"
 #include "mongo/db/record_id.h"
 #include "mongo/platform/unordered_map.h"
 
@@ -122,11 +124,15 @@ private:
         // RecordId to break sortKey ties.
         // See sorta.js.
         RecordId recordId;
+        // 'sortKey' and 'recordId' encoded by a SortKeyEncoder, or empty if the key is too large
+        // to encode.
+        std::string encodedSortKey;
     };
 
     // Comparison object for data buffers (vector and set). Items are compared on (sortKey, loc).
-    // This is also how the items are ordered in the indices. Keys are compared using
-    // BSONObj::woCompare() with RecordId as a tie-breaker.
+    // This is also how the items are ordered in the indices. When both items have an encoded key
+    // the comparison is a byte comparison of the encodings. Otherwise keys are compared using
+    // BSONObj::woCompare() with RecordId as a tie-breaker, which orders keys the same way.
     //
     // We are comparing keys generated by the SortKeyGenerator, which are already ordered with
     // respect the collation. Therefore, we explicitly avoid comparing using a collator here.
@@ -137,12 +143,11 @@ private:
 
         BSONObj pattern;
     };
-
     /**
      * Inserts one item into data buffer (vector or set).
      * If limit is exceeded, remove item with lowest key.
      */
-    void addToBuffer(const SortableDataItem& item);
+    void addToBuffer(SortableDataItem item);
 
     /**
      * Sorts data buffer.
@@ -153,8 +158,10 @@ private:
     void sortBuffer();
 
     // Comparator for data buffer
-    // Initialization follows sort key generator
-    std::unique_ptr<WorkingSetComparator> _sortKeyComparator;
+    WorkingSetComparator _sortKeyComparator;
+
+    // Encodes the sort keys of incoming results.
+    SortKeyEncoder _sortKeyEncoder;
 
     // The data we buffer and sort.
     // _data will contain sorted data when all data is gathered
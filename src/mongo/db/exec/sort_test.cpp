@@ -300,6 +300,75 @@ TEST_F(SortStageTest, SortDescendingWithLimitOfOne) {
         "{a: -1}", nullptr, "{}", 1, "{input: [{a: 2}, {a: 1}, {a: 3}]}", "{output: [{a: 3}]}");
 }
 
+TEST_F(SortStageTest, SortCompoundWithMixedDirections) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             "{}",
+             0,
+             "{input: [{a: 1, b: 1}, {a: 0, b: 5}, {a: 1, b: 2}]}",
+             "{output: [{a: 0, b: 5}, {a: 1, b: 2}, {a: 1, b: 1}]}");
+}
+
+TEST_F(SortStageTest, SortMixedTypes) {
+    testWork("{a: 1}",
+             nullptr,
+             "{}",
+             0,
+             "{input: [{a: 'x'}, {a: 2.5}, {a: {b: 1}}, {a: null}, {a: 2}]}",
+             "{output: [{a: null}, {a: 2}, {a: 2.5}, {a: 'x'}, {a: {b: 1}}]}");
+}
+
+TEST_F(SortStageTest, SortMissingFieldsAsNull) {
+    testWork("{a: 1}",
+             nullptr,
+             "{}",
+             0,
+             "{input: [{a: 1}, {b: 1}, {a: -1}]}",
+             "{output: [{b: 1}, {a: -1}, {a: 1}]}");
+}
+
+TEST_F(SortStageTest, SortPatternWithMoreThan32Fields) {
+    // The first 32 fields are equal in every document, so only the descending 33rd field, which
+    // is encoded in a second group of fields, orders them.
+    std::string pattern = "{";
+    std::string prefix;
+    for (int i = 0; i < 32; ++i) {
+        pattern += str::stream() << "f" << i << ": 1, ";
+        prefix += str::stream() << "f" << i << ": 0, ";
+    }
+    pattern += "last: -1}";
+
+    auto doc = [&prefix](int last) -> std::string {
+        return str::stream() << "{" << prefix << "last: " << last << "}";
+    };
+    const std::string input = str::stream() << "{input: [" << doc(1) << ", " << doc(3) << ", "
+                                            << doc(2) << "]}";
+    const std::string expected = str::stream() << "{output: [" << doc(3) << ", " << doc(2) << ", "
+                                               << doc(1) << "]}";
+    testWork(pattern.c_str(), nullptr, "{}", 0, input.c_str(), expected.c_str());
+}
+
+TEST_F(SortStageTest, SortKeysTooLargeToEncode) {
+    // More than 1KB of numbers in the sort keys of all but one document. Those keys are compared
+    // as BSON, both among themselves and with the key that is encoded.
+    std::string numbers;
+    for (int i = 0; i < 600; ++i) {
+        numbers += str::stream() << "f" << i << ": " << i << ", ";
+    }
+
+    auto doc = [&numbers](int last) -> std::string {
+        return str::stream() << "{a: {" << numbers << "last: " << last << "}}";
+    };
+    const std::string input = str::stream() << "{input: [" << doc(2) << ", {a: 1}, " << doc(3)
+                                            << ", " << doc(1) << "]}";
+    const std::string expected = str::stream() << "{output: [{a: 1}, " << doc(1) << ", " << doc(2)
+                                               << ", " << doc(3) << "]}";
+    testWork("{a: 1}", nullptr, "{}", 0, input.c_str(), expected.c_str());
+
+    const std::string expectedWithLimit = "{output: [{a: 1}, " + doc(1) + "]}";
+    testWork("{a: 1}", nullptr, "{}", 2, input.c_str(), expectedWithLimit.c_str());
+}
+
 TEST_F(SortStageTest, SortAscendingWithCollation) {
     CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
     testWork("{a: 1}",
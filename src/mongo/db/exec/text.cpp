@@ -97,7 +97,8 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* txn,
                                                const MatchExpression* filter) const {
     auto textScorer = make_unique<TextOrStage>(txn, _params.spec, ws, filter, _params.index);
 
-    // Get all the index scans for each term in our query.
+    // Get all the index scans for each term in our query. Each scan returns the keys of its term
+    // in order of decreasing score.
     for (const auto& term : _params.query.getTermsForBounds()) {
         IndexScanParams ixparams;
 
@@ -113,6 +114,11 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* txn,
         textScorer->addChild(make_unique<IndexScan>(txn, ixparams, ws, nullptr));
     }
 
+    if (canUseTopK()) {
+        const auto& terms = _params.query.getTermsForBounds();
+        textScorer->setTopK(_params.topK, vector<string>(terms.begin(), terms.end()));
+    }
+
     auto matcher =
         make_unique<TextMatchStage>(txn, std::move(textScorer), _params.query, _params.spec, ws);
 
@@ -120,4 +126,10 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* txn,
     return treeRoot;
 }
 
+bool TextStage::canUseTopK() const {
+    return _params.topK > 0 && _params.query.getNegatedTerms().empty() &&
+        _params.query.getPositivePhr().empty() && _params.query.getNegatedPhr().empty() &&
+        !_params.query.getCaseSensitive() && !_params.query.getDiacriticSensitive();
+}
+
 }  // namespace mongo
@@ -62,6 +62,9 @@ struct TextStageParams {
 
     // The text query.
     FTSQueryImpl query;
+
+    // If non-zero, the results are sorted by text score and only this many of them are needed.
+    size_t topK = 0;
 };
 
 /**
@@ -98,6 +101,13 @@ private:
                                         WorkingSet* ws,
                                         const MatchExpression* filter) const;
 
+    /**
+     * Returns true if the top-k results by score can be found without reading every index key.
+     * TEXT_MATCH must then accept every document TEXT_OR returns, so this requires a query
+     * without negations or phrases whose positive terms need not be rechecked.
+     */
+    bool canUseTopK() const;
+
     // Parameters of this text stage.
     TextStageParams _params;
 
@@ -28,6 +28,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -37,6 +38,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/exec/working_set_computed_data.h"
+#include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/matchable.h"
 #include "mongo/db/query/internal_plans.h"
@@ -73,6 +75,18 @@ void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
 }
 
+void TextOrStage::setTopK(size_t limit, std::vector<std::string> terms) {
+    invariant(limit > 0);
+    invariant(terms.size() == _children.size());
+    _topK = limit;
+    _terms = std::move(terms);
+
+    // Nothing is known about the scores of a child's keys until it returns its first one.
+    _childBounds.assign(_children.size(), std::numeric_limits<double>::infinity());
+    _childExhausted.assign(_children.size(), false);
+    _specificStats.topK = limit;
+}
+
 bool TextOrStage::isEOF() {
     return _internalState == State::kDone;
 }
@@ -107,6 +121,9 @@ void TextOrStage::doInvalidate(OperationContext* txn, const RecordId& dl, Invali
             _scoreIterator++;
         }
         _scores.erase(scoreIt);
+
+        // The document may have been one of the best scoring ones.
+        _bestScoresStale = _topK > 0;
     }
 }
 
@@ -192,12 +209,27 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        StageState stageState = addTerm(id, out);
+        if (_topK && PlanStage::NEED_YIELD != stageState) {
+            if (foundTopK()) {
+                // The keys not read yet cannot change the best '_topK' results.
+                _specificStats.terminatedEarly = true;
+                _scoreIterator = _scores.begin();
+                _internalState = State::kReturningResults;
+            } else {
+                invariant(selectNextChild());
+            }
+        }
+        return stageState;
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
-        ++_currentChild;
-
-        if (_currentChild < _children.size()) {
+        if (_topK) {
+            _childBounds[_currentChild] = 0;
+            _childExhausted[_currentChild] = true;
+            if (selectNextChild()) {
+                return PlanStage::NEED_TIME;
+            }
+        } else if (++_currentChild < _children.size()) {
             // We have another child to read from.
             return PlanStage::NEED_TIME;
         }
@@ -243,6 +275,15 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
         return PlanStage::NEED_TIME;
     }
 
+    // In top-k mode, also drop the documents that cannot be among the best ones.
+    if (_topK) {
+        boost::optional<double> threshold = getTopKThreshold();
+        if (threshold && textRecordData.score < *threshold) {
+            _ws->free(textRecordData.wsid);
+            return PlanStage::NEED_TIME;
+        }
+    }
+
     WorkingSetMember* wsm = _ws->get(textRecordData.wsid);
 
     // Populate the working set member with the text score and return it.
@@ -251,6 +292,66 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+bool TextOrStage::selectNextChild() {
+    for (size_t i = 1; i <= _children.size(); i++) {
+        const size_t child = (_currentChild + i) % _children.size();
+        if (!_childExhausted[child]) {
+            _currentChild = child;
+            return true;
+        }
+    }
+    return false;
+}
+
+double TextOrStage::scoreDocument(const BSONObj& obj) const {
+    fts::TermFrequencyMap termFrequencies;
+    _ftsSpec.scoreDocument(obj, &termFrequencies);
+
+    double score = 0;
+    for (auto&& term : _terms) {
+        auto it = termFrequencies.find(term);
+        if (it != termFrequencies.end()) {
+            score += it->second;
+        }
+    }
+    return score;
+}
+
+boost::optional<double> TextOrStage::getTopKThreshold() {
+    if (_bestScoresStale) {
+        _bestScores = decltype(_bestScores)();
+        for (auto&& scoreEntry : _scores) {
+            if (scoreEntry.second.wsid == WorkingSet::INVALID_ID) {
+                continue;
+            }
+            _bestScores.push(scoreEntry.second.score);
+            if (_bestScores.size() > _topK) {
+                _bestScores.pop();
+            }
+        }
+        _bestScoresStale = false;
+    }
+
+    if (_bestScores.size() < _topK) {
+        return boost::none;
+    }
+    return _bestScores.top();
+}
+
+bool TextOrStage::foundTopK() {
+    boost::optional<double> threshold = getTopKThreshold();
+    if (!threshold) {
+        return false;
+    }
+
+    // No document that has not been seen yet can score more than the sum of the bounds.
+    double unseenBound = 0;
+    for (double childBound : _childBounds) {
+        unseenBound += childBound;
+    }
+    return *threshold >= unseenBound;
+}
+
 /**
  * Provides support for covered matching on non-text fields of a compound text index.
  */
@@ -333,6 +434,23 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(newKeyData.keyData);
+    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    double documentTermScore = scoreElement.number();
+
+    if (_topK) {
+        // Keys are read in order of decreasing score, so no key of this child that is yet to be
+        // read can add more than this to the score of a document.
+        _childBounds[_currentChild] = documentTermScore;
+    }
+
     if (textRecordData->score < 0) {
         // We have already rejected this document for not matching the filter.
         invariant(WorkingSet::INVALID_ID == textRecordData->wsid);
@@ -398,6 +516,21 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
 
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         wsm->makeObjOwnedIfNeeded();
+
+        if (_topK) {
+            // The keys of this document for the other terms may never be read, so score it in
+            // full right away.
+            textRecordData->score = scoreDocument(wsm->obj.value());
+            _bestScores.push(textRecordData->score);
+            if (_bestScores.size() > _topK) {
+                _bestScores.pop();
+            }
+            return NEED_TIME;
+        }
+    } else if (_topK) {
+        // This document already has its full score.
+        _ws->free(wsid);
+        return NEED_TIME;
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
@@ -408,17 +541,6 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
-    }
-
-    keyIt.next();  // Skip past 'term'.
-
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
-
     // Aggregate relevance score, term keys.
     textRecordData->score += documentTermScore;
     return NEED_TIME;
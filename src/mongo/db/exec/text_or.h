@@ -28,7 +28,11 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <functional>
 #include <memory>
+#include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/db/catalog/collection.h"
@@ -81,6 +85,20 @@ public:
 
     void addChild(unique_ptr<PlanStage> child);
 
+    /**
+     * Restricts the output to a superset of the 'limit' highest scoring documents, each with its
+     * exact score, instead of every matching document. 'terms' holds the term each child scans,
+     * in the order the children were added. Every child must return the keys of its term in order
+     * of decreasing score, and our parent must not filter out any of the documents returned.
+     *
+     * In this mode the children are read in turn, one key at a time, and each document is scored
+     * in full from its contents when first seen. The score of the last key read from a child
+     * bounds the score any unread key of that child can contribute, so reading stops as soon as
+     * 'limit' documents score at least the sum of these bounds, as in Fagin's threshold
+     * algorithm.
+     */
+    void setTopK(size_t limit, std::vector<std::string> terms);
+
     bool isEOF() final;
 
     StageState doWork(WorkingSetID* out) final;
@@ -125,6 +143,29 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * In top-k mode, moves '_currentChild' on to the next child that is not exhausted. Returns
+     * false if there is none.
+     */
+    bool selectNextChild();
+
+    /**
+     * Returns the score of a document for the terms in '_terms', computed from its contents.
+     */
+    double scoreDocument(const BSONObj& obj) const;
+
+    /**
+     * Returns the lowest of the best '_topK' scores found so far, or boost::none if fewer than
+     * '_topK' documents have been scored.
+     */
+    boost::optional<double> getTopKThreshold();
+
+    /**
+     * Returns true once no document can make it into the top '_topK' anymore unless it has
+     * already been scored.
+     */
+    bool foundTopK();
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -154,6 +195,19 @@ private:
 
     TextOrStats _specificStats;
 
+    // Top-k mode, see setTopK(). '_topK' is zero if every key of every child is read.
+    size_t _topK = 0;
+    std::vector<std::string> _terms;
+
+    // The score of the last key read from each child, or zero once the child is exhausted.
+    std::vector<double> _childBounds;
+    std::vector<bool> _childExhausted;
+
+    // The best '_topK' scores found so far, lowest on top. Rebuilt from '_scores' when an
+    // invalidation removed a document that may be among them.
+    std::priority_queue<double, std::vector<double>, std::greater<double>> _bestScores;
+    bool _bestScoresStale = false;
+
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
     WorkingSetID _idRetrying;
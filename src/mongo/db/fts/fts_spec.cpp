@@ -31,12 +31,18 @@
 
 #include "mongo/db/fts/fts_spec.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/fts/fts_element_iterator.h"
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/fts_util.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/string_map.h"
 #include "mongo/util/stringutils.h"
 
 namespace mongo {
@@ -56,6 +62,43 @@ namespace {
 // Default language.  Used for new indexes.
 const std::string moduleDefaultLanguage("english");
 
+const size_t kMinTermChunkSize = 256;
+
+/**
+ * Holds copies of the terms of one string being scored. The copies are packed into large chunks
+ * rather than each getting an allocation of its own.
+ */
+class TermArena {
+    MONGO_DISALLOW_COPYING(TermArena);
+
+public:
+    /**
+     * 'expectedSize' is the size of the first chunk. The terms of a string usually fit in the size
+     * of the string itself.
+     */
+    explicit TermArena(size_t expectedSize)
+        : _chunkSize(std::max(expectedSize, kMinTermChunkSize)) {}
+
+    StringData copy(StringData term) {
+        if (_chunks.empty() || _chunkUsed + term.size() > _chunkCapacity) {
+            _chunkCapacity = std::max(_chunkSize, term.size());
+            _chunks.emplace_back(new char[_chunkCapacity]);
+            _chunkUsed = 0;
+        }
+
+        char* out = _chunks.back().get() + _chunkUsed;
+        term.copyTo(out, false);
+        _chunkUsed += term.size();
+        return StringData(out, term.size());
+    }
+
+private:
+    const size_t _chunkSize;
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    size_t _chunkUsed = 0;
+    size_t _chunkCapacity = 0;
+};
+
 /** Validate the given language override string. */
 bool validateOverride(const string& override) {
     // The override field can't be empty, can't be prefixed with a dollar sign, and
@@ -181,10 +224,23 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
 
     FTSElementIterator it(*this, obj);
 
+    // Tokenizers keep their buffers across calls to reset(), so use one per language.
+    std::vector<std::pair<const FTSLanguage*, std::unique_ptr<FTSTokenizer>>> tokenizers;
+
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
-        _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
+        FTSTokenizer* tokenizer = nullptr;
+        for (auto&& languageTokenizer : tokenizers) {
+            if (languageTokenizer.first == val._language) {
+                tokenizer = languageTokenizer.second.get();
+                break;
+            }
+        }
+        if (!tokenizer) {
+            tokenizers.emplace_back(val._language, val._language->createTokenizer());
+            tokenizer = tokenizers.back().second.get();
+        }
+        _scoreStringV2(tokenizer, val._text, term_freqs, val._weight);
     }
 }
 
@@ -192,7 +248,8 @@ void FTSSpec::_scoreStringV2(FTSTokenizer* tokenizer,
                              StringData raw,
                              TermFrequencyMap* docScores,
                              double weight) const {
-    ScoreHelperMap terms;
+    TermArena arena(raw.size());
+    UnownedStringMap<ScoreHelperStruct> terms;
 
     unsigned numTokens = 0;
 
@@ -201,7 +258,12 @@ void FTSSpec::_scoreStringV2(FTSTokenizer* tokenizer,
     while (tokenizer->moveNext()) {
         StringData term = tokenizer->get();
 
-        ScoreHelperStruct& data = terms[term];
+        auto termIt = terms.find(term);
+        if (termIt == terms.end()) {
+            // The tokenizer reuses the memory of 'term', so key on a copy of it.
+            termIt = terms.try_emplace(arena.copy(term)).first;
+        }
+        ScoreHelperStruct& data = termIt->second;
 
         if (data.exp) {
             data.exp *= 2;
@@ -213,8 +275,8 @@ void FTSSpec::_scoreStringV2(FTSTokenizer* tokenizer,
         numTokens++;
     }
 
-    for (ScoreHelperMap::const_iterator i = terms.begin(); i != terms.end(); ++i) {
-        const string& term = i->first;
+    for (auto i = terms.begin(); i != terms.end(); ++i) {
+        StringData term = i->first;
         const ScoreHelperStruct& data = i->second;
 
         // in order to adjust weights as a function of term count as it
@@ -227,10 +289,10 @@ void FTSSpec::_scoreStringV2(FTSTokenizer* tokenizer,
         // if term is identical to the raw form of the
         // field (untokenized) give it a small boost.
         double adjustment = 1;
-        if (raw.size() == term.length() && raw.equalCaseInsensitive(term))
+        if (raw.size() == term.size() && raw.equalCaseInsensitive(term))
             adjustment += 0.1;
 
-        double& score = (*docScores)[term];
+        double& score = (*docScores)[term.toString()];
         score += (weight * data.freq * coeff * adjustment);
         verify(score <= MAX_WEIGHT);
     }
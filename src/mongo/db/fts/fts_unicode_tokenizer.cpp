@@ -35,6 +35,7 @@
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/stop_words.h"
 #include "mongo/db/fts/tokenizer.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/stringutils.h"
@@ -44,6 +45,34 @@ namespace fts {
 
 using std::string;
 
+namespace {
+
+/**
+ * Returns whether 'str' is made only of ASCII characters. NUL is not counted as one, since the UTF8
+ * decoder stops at it.
+ */
+bool isAsciiWithoutNul(StringData str) {
+    const char* it = str.rawData();
+    const char* end = it + str.size();
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    using unicode::ByteVector;
+    for (; end - it >= ByteVector::size; it += ByteVector::size) {
+        auto word = ByteVector::load(it);
+        if (word.maskHigh() || word.compareEQ(0).maskAny()) {
+            return false;
+        }
+    }
+#endif
+    for (; it != end; ++it) {
+        if (*it == 0 || static_cast<unsigned char>(*it) > 0x7f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
 UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
     : _language(language),
       _stemmer(language),
@@ -57,7 +86,15 @@ UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
 void UnicodeFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _pos = 0;
-    _document.resetData(document);  // Validates that document is valid UTF8.
+
+    // ASCII is valid UTF8, and its characters need no decoding.
+    _isAscii = isAsciiWithoutNul(document);
+    if (_isAscii) {
+        _asciiDocument.assign(document.rawData(), document.size());
+    } else {
+        _asciiDocument.clear();
+        _document.resetData(document);  // Validates that document is valid UTF8.
+    }
 
     // Skip any leading delimiters (and handle the case where the document is entirely delimiters).
     _skipDelimiters();
@@ -65,16 +102,20 @@ void UnicodeFTSTokenizer::reset(StringData document, Options options) {
 
 bool UnicodeFTSTokenizer::moveNext() {
     while (true) {
-        if (_pos >= _document.size()) {
+        if (_pos >= (_isAscii ? _asciiDocument.size() : _document.size())) {
             _word = "";
             return false;
         }
 
         // Traverse through non-delimiters and build the next token.
         size_t start = _pos++;
-        while (_pos < _document.size() &&
-               (!unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage))) {
-            ++_pos;
+        if (_isAscii) {
+            _skipAsciiNonDelimiters();
+        } else {
+            while (_pos < _document.size() &&
+                   (!unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage))) {
+                ++_pos;
+            }
         }
         const size_t len = _pos - start;
 
@@ -82,15 +123,21 @@ bool UnicodeFTSTokenizer::moveNext() {
         _skipDelimiters();
 
         // Stop words are case-sensitive and diacritic sensitive, so we need them to be lower cased
-        // but with diacritics not removed to check against the stop word list.
-        _word = _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
+        // but with diacritics not removed to check against the stop word list. Lower casing ASCII
+        // is the same as case folding it, which is vectorized.
+        const StringData asciiToken =
+            _isAscii ? StringData(_asciiDocument).substr(start, len) : StringData();
+        _word = _isAscii
+            ? unicode::String::caseFoldAndStripDiacritics(
+                  &_wordBuf, asciiToken, unicode::String::kDiacriticSensitive, _caseFoldMode)
+            : _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
 
         if ((_options & kFilterStopWords) && _stopWords->isStopWord(_word)) {
             continue;
         }
 
         if (_options & kGenerateCaseSensitiveTokens) {
-            _word = _document.substrToBuf(&_wordBuf, start, len);
+            _word = _isAscii ? asciiToken : _document.substrToBuf(&_wordBuf, start, len);
         }
 
         // The stemmer is diacritic sensitive, so stem the word before removing diacritics.
@@ -111,11 +158,50 @@ StringData UnicodeFTSTokenizer::get() const {
 }
 
 void UnicodeFTSTokenizer::_skipDelimiters() {
+    if (_isAscii) {
+        _skipAsciiDelimiters();
+        return;
+    }
+
     while (_pos < _document.size() &&
            unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage)) {
         ++_pos;
     }
 }
 
+void UnicodeFTSTokenizer::_skipAsciiNonDelimiters() {
+    const size_t size = _asciiDocument.size();
+    while (_pos < size) {
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+        using unicode::ByteVector;
+        if (size - _pos >= size_t(ByteVector::size)) {
+            // Letters and digits are never delimiters, so skip over runs of them 16 bytes at a
+            // time. The bytes are all ASCII, so signed comparisons are fine.
+            auto word = ByteVector::load(_asciiDocument.data() + _pos);
+            ByteVector notAlphanumeric = word.compareLT('0') |
+                (word.compareGT('9') & word.compareLT('A')) |
+                (word.compareGT('Z') & word.compareLT('a')) | word.compareGT('z');
+            uint32_t alphanumericBytes =
+                ByteVector::countInitialZeros(notAlphanumeric.maskAny());
+            _pos += alphanumericBytes;
+            if (alphanumericBytes == ByteVector::size) {
+                continue;
+            }
+        }
+#endif
+        if (unicode::codepointIsDelimiter(_asciiDocument[_pos], _delimListLanguage)) {
+            return;
+        }
+        ++_pos;
+    }
+}
+
+void UnicodeFTSTokenizer::_skipAsciiDelimiters() {
+    while (_pos < _asciiDocument.size() &&
+           unicode::codepointIsDelimiter(_asciiDocument[_pos], _delimListLanguage)) {
+        ++_pos;
+    }
+}
+
 }  // namespace fts
 }  // namespace mongo
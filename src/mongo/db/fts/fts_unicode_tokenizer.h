@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_tokenizer.h"
@@ -73,12 +75,24 @@ private:
      */
     void _skipDelimiters();
 
+    /**
+     * Helpers for documents that are entirely ASCII, which are tokenized directly from their UTF-8
+     * bytes. They move the tokenizer past the rest of the current token and past all delimiters
+     * respectively.
+     */
+    void _skipAsciiNonDelimiters();
+    void _skipAsciiDelimiters();
+
     const FTSLanguage* const _language;
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
     const unicode::DelimiterListLanguage _delimListLanguage;
     const unicode::CaseFoldMode _caseFoldMode;
 
+    // The document is held in '_asciiDocument' if it is entirely ASCII, and in '_document'
+    // otherwise. '_pos' counts bytes in the former and codepoints in the latter.
+    bool _isAscii = false;
+    std::string _asciiDocument;
     unicode::String _document;
     size_t _pos;
     StringData _word;
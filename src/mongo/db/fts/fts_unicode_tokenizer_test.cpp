@@ -241,5 +241,56 @@ TEST(FtsUnicodeTokenizer, FrenchStopWordsAndDiacriticSensitive) {
     ASSERT_EQUALS("excit", terms[4]);
 }
 
+// Ensure that documents made only of ASCII, which skip decoding to UTF-32, are tokenized the same
+// way as documents that have other characters. Some tokens are longer than a 16 byte vector.
+TEST(FtsUnicodeTokenizer, AsciiMatchesNonAscii) {
+    const std::string ascii =
+        "  INTERNATIONALIZATION of Mark's dog-running!! 42 Counterrevolutionaries, "
+        "don't `carets^ and_underscores Illinois\tIS\nHERE ";
+    const std::vector<FTSTokenizer::Options> optionsList = {
+        FTSTokenizer::kNone,
+        FTSTokenizer::kFilterStopWords,
+        FTSTokenizer::kGenerateCaseSensitiveTokens,
+        FTSTokenizer::kGenerateDiacriticSensitiveTokens,
+        FTSTokenizer::kFilterStopWords | FTSTokenizer::kGenerateCaseSensitiveTokens |
+            FTSTokenizer::kGenerateDiacriticSensitiveTokens,
+    };
+
+    for (auto language : {"english", "french", "turkish"}) {
+        for (auto options : optionsList) {
+            std::vector<std::string> asciiTerms = tokenizeString(ascii.c_str(), language, options);
+            std::vector<std::string> terms =
+                tokenizeString((ascii + "z\xc3\xa8bre").c_str(), language, options);
+
+            ASSERT_EQUALS(asciiTerms.size() + 1, terms.size());
+            terms.pop_back();
+            ASSERT(asciiTerms == terms);
+        }
+    }
+}
+
+// Ensure that a tokenizer can be reset between ASCII and non-ASCII documents.
+TEST(FtsUnicodeTokenizer, ResetBetweenAsciiAndNonAscii) {
+    StatusWithFTSLanguage swl = FTSLanguage::make("english", TEXT_INDEX_VERSION_3);
+    ASSERT_OK(swl);
+    UnicodeFTSTokenizer tokenizer(swl.getValue());
+
+    tokenizer.reset("caf\xc3\xa9 running", FTSTokenizer::kNone);
+    ASSERT(tokenizer.moveNext());
+    ASSERT_EQUALS("cafe", tokenizer.get());
+
+    tokenizer.reset("Dogs running", FTSTokenizer::kNone);
+    ASSERT(tokenizer.moveNext());
+    ASSERT_EQUALS("dog", tokenizer.get());
+    ASSERT(tokenizer.moveNext());
+    ASSERT_EQUALS("run", tokenizer.get());
+    ASSERT_FALSE(tokenizer.moveNext());
+
+    tokenizer.reset("\xc3\xa9t\xc3\xa9", FTSTokenizer::kNone);
+    ASSERT(tokenizer.moveNext());
+    ASSERT_EQUALS("ete", tokenizer.get());
+    ASSERT_FALSE(tokenizer.moveNext());
+}
+
 }  // namespace fts
 }  // namespace mongo
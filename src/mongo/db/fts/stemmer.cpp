@@ -29,15 +29,109 @@
 */
 
 #include <cstdlib>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/concurrency/threadlocal.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
 namespace fts {
 
-Stemmer::Stemmer(const FTSLanguage* language) {
+namespace {
+
+/**
+ * The stems of the most recently stemmed words of one language.
+ */
+class StemCache {
+    MONGO_DISALLOW_COPYING(StemCache);
+
+public:
+    static const size_t kMaxEntries = 4096;
+
+    StemCache() = default;
+
+    /**
+     * Returns the cached stem of 'word' and marks it as the most recently used, or returns nullptr
+     * if 'word' is not cached.
+     */
+    const std::string* find(StringData word) {
+        auto it = _index.find(word);
+        if (it == _index.end()) {
+            return nullptr;
+        }
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return &it->second->stem;
+    }
+
+    /**
+     * Caches 'stem' as the stem of 'word', evicting the least recently used entry if the cache is
+     * full.
+     */
+    void add(StringData word, StringData stem) {
+        if (_index.size() < kMaxEntries) {
+            _entries.emplace_front();
+        } else {
+            // Reuse the least recently used entry, and with it the memory of its strings.
+            _index.erase(_entries.back().word);
+            _entries.splice(_entries.begin(), _entries, std::prev(_entries.end()));
+        }
+
+        Entry& entry = _entries.front();
+        entry.word.assign(word.rawData(), word.size());
+        entry.stem.assign(stem.rawData(), stem.size());
+        _index[entry.word] = _entries.begin();
+    }
+
+private:
+    struct Entry {
+        std::string word;
+        std::string stem;
+    };
+
+    // Ordered from the most to the least recently used. The keys of '_index' point into the words
+    // of these entries, which list nodes never move.
+    std::list<Entry> _entries;
+    UnownedStringMap<std::list<Entry>::iterator> _index;
+};
+
+/**
+ * The stem caches of the current thread, one for each language stemmed on it.
+ */
+class ThreadStemCaches {
+public:
+    StemCache* get(const FTSLanguage* language) {
+        for (auto&& cache : _caches) {
+            if (cache.first == language) {
+                return cache.second.get();
+            }
+        }
+        _caches.emplace_back(language, stdx::make_unique<StemCache>());
+        return _caches.back().second.get();
+    }
+
+private:
+    std::vector<std::pair<const FTSLanguage*, std::unique_ptr<StemCache>>> _caches;
+};
+
+thread_specific_ptr<ThreadStemCaches> threadStemCaches;
+
+StemCache* getStemCache(const FTSLanguage* language) {
+    if (!threadStemCaches.get()) {
+        threadStemCaches.reset(new ThreadStemCaches());
+    }
+    return threadStemCaches->get(language);
+}
+
+}  // namespace
+
+Stemmer::Stemmer(const FTSLanguage* language) : _language(language) {
     _stemmer = NULL;
     if (language->str() != "none")
         _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
@@ -54,6 +148,12 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    StemCache* cache = getStemCache(_language);
+    if (const std::string* cachedStem = cache->find(word)) {
+        _stem.assign(*cachedStem);
+        return _stem;
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -62,7 +162,9 @@ StringData Stemmer::stem(StringData word) const {
         invariant(false);
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    StringData stem((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    cache->add(word, stem);
+    return stem;
 }
 }
 }
@@ -31,6 +31,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
@@ -54,6 +56,9 @@ public:
     /**
      * Stems an input word.
      *
+     * The stems of recently seen words are kept in a cache that is shared by the Stemmers of the
+     * same language on the current thread, so that repeated words skip the Snowball stemmer.
+     *
      * The returned StringData is valid until the next call to any method on this object. Since the
      * input may be returned unmodified, the output's lifetime may also expire when the input's
      * does.
@@ -61,7 +66,12 @@ public:
     StringData stem(StringData word) const;
 
 private:
+    const FTSLanguage* const _language;
     struct sb_stemmer* _stemmer;
+
+    // Holds the result of the last call to stem(), since the cache entry it came from may be
+    // evicted by another Stemmer.
+    mutable std::string _stem;
 };
 }
 }
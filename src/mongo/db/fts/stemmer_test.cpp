@@ -29,6 +29,9 @@
 */
 
 
+#include <string>
+#include <vector>
+
 #include "mongo/unittest/unittest.h"
 
 #include "mongo/db/fts/fts_spec.h"
@@ -48,5 +51,30 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+// Stems are cached per thread and language, so stemming words again, from another Stemmer or after
+// the cache has evicted them, must give the same results.
+TEST(English, CachedStems) {
+    Stemmer first(&languageEnglishV2);
+    Stemmer second(&languageEnglishV2);
+    ASSERT_EQUALS("run", first.stem("running"));
+    ASSERT_EQUALS("run", second.stem("running"));
+
+    StringData stem = first.stem("running");
+    ASSERT_EQUALS("jump", second.stem("jumping"));
+    ASSERT_EQUALS("run", stem);
+
+    std::vector<std::string> stems;
+    for (int i = 0; i < 5000; i++) {
+        const std::string word = "walking" + std::to_string(i);
+        stems.push_back(second.stem(word).toString());
+    }
+    for (int i = 0; i < 5000; i++) {
+        const std::string word = "walking" + std::to_string(i);
+        ASSERT_EQUALS(stems[i], first.stem(word));
+        ASSERT_EQUALS("walk", second.stem("walking"));
+    }
+    ASSERT_EQUALS("run", first.stem("running"));
+}
 }
 }
@@ -71,10 +71,71 @@ bool isMultikeyFromPaths(const MultikeyPaths& multikeyPaths) {
                        [](const std::set<std::size_t>& components) { return !components.empty(); });
 }
 
+/**
+ * Adds the path components of 'from' that cause an index to be multikey to those of 'into'.
+ */
+void mergeMultikeyPaths(MultikeyPaths* into, const MultikeyPaths& from) {
+    if (from.empty()) {
+        return;
+    }
+
+    if (into->empty()) {
+        *into = from;
+        return;
+    }
+
+    invariant(into->size() == from.size());
+    for (size_t i = 0; i < from.size(); ++i) {
+        (*into)[i].insert(from[i].begin(), from[i].end());
+    }
+}
+
 }  // namespace
 
 MONGO_EXPORT_SERVER_PARAMETER(failIndexKeyTooLong, bool, true);
 
+// Threads an index build's external sort uses to sort its keys and merge the runs it spills.
+int internalIndexBuildSorterThreads = 1;
+class ExportedIndexBuildSorterThreadsParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupOnly> {
+public:
+    ExportedIndexBuildSorterThreadsParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupOnly>(
+              ServerParameterSet::getGlobal(),
+              "internalIndexBuildSorterThreads",
+              &internalIndexBuildSorterThreads) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        if (potentialNewValue < 1 || potentialNewValue > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "internalIndexBuildSorterThreads must be between 1 and 128");
+        }
+
+        return Status::OK();
+    }
+
+} exportedIndexBuildSorterThreadsParam;
+
+// The most runs an index build's external sort merges at once. 0 merges them all in one pass.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalIndexBuildSorterMergeFanIn, int, 0);
+
+// How the runs an index build's external sort spills are compressed.
+std::string internalIndexBuildSorterSpillCompressor = "snappy";
+class ExportedIndexBuildSorterSpillCompressorParameter
+    : public ExportedServerParameter<std::string, ServerParameterType::kStartupOnly> {
+public:
+    ExportedIndexBuildSorterSpillCompressorParameter()
+        : ExportedServerParameter<std::string, ServerParameterType::kStartupOnly>(
+              ServerParameterSet::getGlobal(),
+              "internalIndexBuildSorterSpillCompressor",
+              &internalIndexBuildSorterSpillCompressor) {}
+
+    virtual Status validate(const std::string& potentialNewValue) {
+        return parseSorterCompressor(potentialNewValue).getStatus();
+    }
+
+} exportedIndexBuildSorterSpillCompressorParam;
+
 //
 // Comparison for external sorter interface
 //
@@ -395,45 +456,50 @@ Status IndexAccessMethod::compact(OperationContext* txn) {
     return this->_newInterface->compact(txn);
 }
 
-std::unique_ptr<IndexAccessMethod::BulkBuilder> IndexAccessMethod::initiateBulk() {
-    return std::unique_ptr<BulkBuilder>(new BulkBuilder(this, _descriptor));
+std::unique_ptr<IndexAccessMethod::BulkBuilder> IndexAccessMethod::initiateBulk(
+    size_t numPartitions) {
+    return std::unique_ptr<BulkBuilder>(new BulkBuilder(this, _descriptor, numPartitions));
 }
 
 IndexAccessMethod::BulkBuilder::BulkBuilder(const IndexAccessMethod* index,
-                                            const IndexDescriptor* descriptor)
-    : _sorter(Sorter::make(
-          SortOptions()
-              .TempDir(storageGlobalParams.dbpath + "/_tmp")
-              .ExtSortAllowed()
-              .MaxMemoryUsageBytes(100 * 1024 * 1024),
-          BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version()))),
-      _real(index) {}
+                                            const IndexDescriptor* descriptor,
+                                            size_t numPartitions)
+    : _partitions(std::max<size_t>(1, numPartitions)), _real(index) {
+    const SortOptions opts =
+        SortOptions()
+            .TempDir(storageGlobalParams.dbpath + "/_tmp")
+            .ExtSortAllowed()
+            .MaxMemoryUsageBytes(100 * 1024 * 1024 / _partitions.size())
+            .NumThreads(internalIndexBuildSorterThreads)
+            .MergeFanIn(std::max(0, internalIndexBuildSorterMergeFanIn))
+            .SpillCompressor(fassertStatusOK(
+                40321, parseSorterCompressor(internalIndexBuildSorterSpillCompressor)));
+
+    for (auto&& partition : _partitions) {
+        partition.sorter.reset(Sorter::make(
+            opts, BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version())));
+    }
+}
 
 Status IndexAccessMethod::BulkBuilder::insert(OperationContext* txn,
                                               const BSONObj& obj,
                                               const RecordId& loc,
                                               const InsertDeleteOptions& options,
-                                              int64_t* numInserted) {
+                                              int64_t* numInserted,
+                                              size_t partition) {
+    invariant(partition < _partitions.size());
+    Partition& target = _partitions[partition];
+
     BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     MultikeyPaths multikeyPaths;
     _real->getKeys(obj, &keys, &multikeyPaths);
 
-    _everGeneratedMultipleKeys = _everGeneratedMultipleKeys || (keys.size() > 1);
-
-    if (!multikeyPaths.empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
-            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
-                _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
-            }
-        }
-    }
+    target.everGeneratedMultipleKeys = target.everGeneratedMultipleKeys || (keys.size() > 1);
+    mergeMultikeyPaths(&target.indexMultikeyPaths, multikeyPaths);
 
     for (BSONObjSet::iterator it = keys.begin(); it != keys.end(); ++it) {
-        _sorter->add(*it, loc);
-        _keysInserted++;
+        target.sorter->add(*it, loc);
+        target.keysInserted++;
     }
 
     if (NULL != numInserted) {
@@ -451,12 +517,33 @@ Status IndexAccessMethod::commitBulk(OperationContext* txn,
                                      set<RecordId>* dupsToDrop) {
     Timer timer;
 
-    std::unique_ptr<BulkBuilder::Sorter::Iterator> i(bulk->_sorter->done());
+    int64_t keysInserted = 0;
+    bool everGeneratedMultipleKeys = false;
+    MultikeyPaths indexMultikeyPaths;
+    std::vector<std::shared_ptr<BulkBuilder::Sorter::Iterator>> partitionIters;
+    for (auto&& partition : bulk->_partitions) {
+        partitionIters.emplace_back(partition.sorter->done());
+        keysInserted += partition.keysInserted;
+        everGeneratedMultipleKeys =
+            everGeneratedMultipleKeys || partition.everGeneratedMultipleKeys;
+        mergeMultikeyPaths(&indexMultikeyPaths, partition.indexMultikeyPaths);
+    }
+
+    std::shared_ptr<BulkBuilder::Sorter::Iterator> i;
+    if (partitionIters.size() == 1) {
+        i = partitionIters.front();
+    } else {
+        i.reset(BulkBuilder::Sorter::Iterator::merge(
+            partitionIters,
+            SortOptions(),
+            BtreeExternalSortComparison(_descriptor->keyPattern(), _descriptor->version())));
+    }
+    partitionIters.clear();
 
     stdx::unique_lock<Client> lk(*txn->getClient());
     ProgressMeterHolder pm(*txn->setMessage_inlock("Index Bulk Build: (2/3) btree bottom up",
                                                    "Index: (2/3) BTree Bottom Up Progress",
-                                                   bulk->_keysInserted,
+                                                   keysInserted,
                                                    10));
     lk.unlock();
 
@@ -465,8 +552,8 @@ Status IndexAccessMethod::commitBulk(OperationContext* txn,
     MONGO_WRITE_CONFLICT_RETRY_LOOP_BEGIN {
         WriteUnitOfWork wunit(txn);
 
-        if (bulk->_everGeneratedMultipleKeys || isMultikeyFromPaths(bulk->_indexMultikeyPaths)) {
-            _btreeState->setMultikey(txn, bulk->_indexMultikeyPaths);
+        if (everGeneratedMultipleKeys || isMultikeyFromPaths(indexMultikeyPaths)) {
+            _btreeState->setMultikey(txn, indexMultikeyPaths);
         }
 
         builder.reset(_newInterface->getBulkBuilder(txn, dupsAllowed));
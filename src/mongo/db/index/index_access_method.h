@@ -30,6 +30,7 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
@@ -200,31 +201,51 @@ public:
     public:
         /**
          * Insert into the BulkBuilder as-if inserting into an IndexAccessMethod.
+         *
+         * The keys are collected by the given partition. Inserts into different partitions may
+         * run concurrently on different threads, but a partition must only be used by one thread
+         * at a time. The OperationContext is not used.
          */
         Status insert(OperationContext* txn,
                       const BSONObj& obj,
                       const RecordId& loc,
                       const InsertDeleteOptions& options,
-                      int64_t* numInserted);
+                      int64_t* numInserted,
+                      size_t partition = 0);
+
+        size_t numPartitions() const {
+            return _partitions.size();
+        }
 
     private:
         friend class IndexAccessMethod;
 
         using Sorter = mongo::Sorter<BSONObj, RecordId>;
 
-        BulkBuilder(const IndexAccessMethod* index, const IndexDescriptor* descriptor);
+        /**
+         * The keys of the documents inserted into one partition, and what they showed about the
+         * index being multikey. commitBulk() merges all the partitions.
+         */
+        struct Partition {
+            std::unique_ptr<Sorter> sorter;
+            int64_t keysInserted = 0;
 
-        std::unique_ptr<Sorter> _sorter;
-        const IndexAccessMethod* _real;
-        int64_t _keysInserted = 0;
+            // Set to true if at least one document causes IndexAccessMethod::getKeys() to return
+            // a BSONObjSet with size strictly greater than one.
+            bool everGeneratedMultipleKeys = false;
 
-        // Set to true if at least one document causes IndexAccessMethod::getKeys() to return a
-        // BSONObjSet with size strictly greater than one.
-        bool _everGeneratedMultipleKeys = false;
+            // Holds the path components that cause this index to be multikey. The
+            // 'indexMultikeyPaths' vector remains empty if this index doesn't support path-level
+            // multikey tracking.
+            MultikeyPaths indexMultikeyPaths;
+        };
 
-        // Holds the path components that cause this index to be multikey. The '_indexMultikeyPaths'
-        // vector remains empty if this index doesn't support path-level multikey tracking.
-        MultikeyPaths _indexMultikeyPaths;
+        BulkBuilder(const IndexAccessMethod* index,
+                    const IndexDescriptor* descriptor,
+                    size_t numPartitions);
+
+        std::vector<Partition> _partitions;
+        const IndexAccessMethod* _real;
     };
 
     /**
@@ -233,8 +254,11 @@ public:
      * This can return NULL, meaning bulk mode is not available.
      *
      * It is only legal to initiate bulk when the index is new and empty.
+     *
+     * The BulkBuilder accepts keys from 'numPartitions' threads at once. The memory it may use
+     * before spilling keys to disk is shared between the partitions.
      */
-    std::unique_ptr<BulkBuilder> initiateBulk();
+    std::unique_ptr<BulkBuilder> initiateBulk(size_t numPartitions = 1);
 
     /**
      * Call this when you are ready to finish your bulk work.
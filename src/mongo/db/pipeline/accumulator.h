@@ -59,6 +59,14 @@ public:
         processInternal(input, merging);
     }
 
+    /** Process 'count' consecutive inputs, in order, as if by calling process() on each of them.
+     *  Accumulators with a cheap per-value update override this to keep their running state in
+     *  locals across the whole batch instead of paying a virtual call per input.
+     */
+    void processBatch(const Value* inputs, size_t count, bool merging) {
+        processBatchInternal(inputs, count, merging);
+    }
+
     /** Marks the end of the evaluate() phase and return accumulated result.
      *  toBeMerged should be true when the outputs will be merged by process().
      */
@@ -98,6 +106,13 @@ protected:
     /// Update subclass's internal state based on input
     virtual void processInternal(const Value& input, bool merging) = 0;
 
+    /// Batch form of processInternal(). The default just applies processInternal() to each input.
+    virtual void processBatchInternal(const Value* inputs, size_t count, bool merging) {
+        for (size_t i = 0; i < count; ++i) {
+            processInternal(inputs[i], merging);
+        }
+    }
+
     /**
      * Accumulators which need to update their internal state when attaching to a new
      * ExpressionContext should override this method.
@@ -197,6 +212,9 @@ public:
         return true;
     }
 
+protected:
+    void processBatchInternal(const Value* inputs, size_t count, bool merging) final;
+
 private:
     BSONType totalType = NumberInt;
     DoubleDoubleSummation nonDecimalTotal;
@@ -226,6 +244,9 @@ public:
         return true;
     }
 
+protected:
+    void processBatchInternal(const Value* inputs, size_t count, bool merging) final;
+
 private:
     Value _val;
     const Sense _sense;
@@ -271,6 +292,9 @@ public:
 
     static boost::intrusive_ptr<Accumulator> create();
 
+protected:
+    void processBatchInternal(const Value* inputs, size_t count, bool merging) final;
+
 private:
     /**
      * The total of all values is partitioned between those that are decimals, and those that are
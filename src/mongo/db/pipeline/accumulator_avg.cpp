@@ -92,6 +92,38 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatchInternal(const Value* inputs, size_t count, bool merging) {
+    if (merging) {
+        for (size_t i = 0; i < count; ++i) {
+            processInternal(inputs[i], merging);
+        }
+        return;
+    }
+
+    long long numAdded = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Value& input = inputs[i];
+        switch (input.getType()) {
+            case NumberDecimal:
+                _decimalTotal = _decimalTotal.add(input.getDecimal());
+                _isDecimal = true;
+                break;
+            case NumberLong:
+                _nonDecimalTotal.addLong(input.getLong());
+                break;
+            case NumberInt:
+            case NumberDouble:
+                _nonDecimalTotal.addDouble(input.getDouble());
+                break;
+            default:
+                dassert(!input.numeric());
+                continue;
+        }
+        numAdded++;
+    }
+    _count += numAdded;
+}
+
 intrusive_ptr<Accumulator> AccumulatorAvg::create() {
     return new AccumulatorAvg();
 }
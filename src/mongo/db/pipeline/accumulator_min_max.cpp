@@ -61,6 +61,23 @@ void AccumulatorMinMax::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorMinMax::processBatchInternal(const Value* inputs, size_t count, bool merging) {
+    // Find the winner of the batch by index and only copy it into '_val' once at the end.
+    const ValueComparator& comparator = getExpressionContext()->getValueComparator();
+    const Value* best = _val.missing() ? nullptr : &_val;
+    for (size_t i = 0; i < count; ++i) {
+        const Value& input = inputs[i];
+        if (input.nullish())
+            continue;
+        if (!best || comparator.compare(*best, input) * _sense > 0)
+            best = &input;
+    }
+    if (best && best != &_val) {
+        _val = *best;
+        _memUsageBytes = sizeof(*this) + _val.getApproximateSize() - sizeof(Value);
+    }
+}
+
 Value AccumulatorMinMax::getValue(bool toBeMerged) const {
     if (_val.missing()) {
         return Value(BSONNULL);
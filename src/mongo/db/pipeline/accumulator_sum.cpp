@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/summation.h"
 
 namespace mongo {
@@ -84,6 +85,35 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorSum::processBatchInternal(const Value* inputs, size_t count, bool merging) {
+    // Runs of integral inputs are summed exactly in a plain 64-bit register and only folded into
+    // the double-double total on overflow or when a value of another type needs the slow path.
+    int64_t longTotal = 0;
+    bool sawLong = false;
+    for (size_t i = 0; i < count; ++i) {
+        const Value& input = inputs[i];
+        const BSONType type = input.getType();
+        if (type == NumberInt || type == NumberLong) {
+            if (type == NumberLong)
+                sawLong = true;
+            const int64_t val = input.coerceToLong();
+            int64_t newTotal;
+            if (mongoSignedAddOverflow64(longTotal, val, &newTotal)) {
+                nonDecimalTotal.addLong(longTotal);
+                newTotal = val;
+            }
+            longTotal = newTotal;
+            continue;
+        }
+        nonDecimalTotal.addLong(longTotal);
+        longTotal = 0;
+        processInternal(input, merging);
+    }
+    nonDecimalTotal.addLong(longTotal);
+    if (sawLong)
+        totalType = Value::getWidestNumeric(totalType, NumberLong);
+}
+
 intrusive_ptr<Accumulator> AccumulatorSum::create() {
     return new AccumulatorSum();
 }
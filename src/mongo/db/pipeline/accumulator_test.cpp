@@ -95,6 +95,31 @@ static void assertExpectedResults(
                 ASSERT_VALUE_EQ(op.second, result);
                 ASSERT_EQUALS(op.second.getType(), result.getType());
             }
+
+            // Asserts that result equals expected result when the input, and the partial results
+            // of each input on a separate shard, are fed in as batches.
+            {
+                boost::intrusive_ptr<Accumulator> accum = factory();
+                accum->injectExpressionContext(expCtx);
+                accum->processBatch(op.first.data(), op.first.size(), false);
+                Value result = accum->getValue(false);
+                ASSERT_VALUE_EQ(op.second, result);
+                ASSERT_EQUALS(op.second.getType(), result.getType());
+
+                std::vector<Value> partials;
+                for (auto&& val : op.first) {
+                    boost::intrusive_ptr<Accumulator> shard = factory();
+                    shard->injectExpressionContext(expCtx);
+                    shard->processBatch(&val, 1, false);
+                    partials.push_back(shard->getValue(true));
+                }
+                accum = factory();
+                accum->injectExpressionContext(expCtx);
+                accum->processBatch(partials.data(), partials.size(), true);
+                result = accum->getValue(false);
+                ASSERT_VALUE_EQ(op.second, result);
+                ASSERT_EQUALS(op.second.getType(), result.getType());
+            }
         } catch (...) {
             log() << "failed with arguments: " << Value(op.first);
             throw;
@@ -307,6 +332,13 @@ TEST(Accumulators, Sum) {
          // Two longs overflow into a double.
          {{Value(numeric_limits<long long>::max()), Value(numeric_limits<long long>::max())},
           Value(static_cast<double>(numeric_limits<long long>::max()) * 2)},
+         // Longs that overflow part way through still produce an exact long total.
+         {{Value(numeric_limits<long long>::max()),
+           Value(numeric_limits<long long>::max()),
+           Value(-numeric_limits<long long>::max()),
+           Value(-numeric_limits<long long>::max()),
+           Value(3)},
+          Value(3LL)},
          // A long and a double do not trigger a long overflow.
          {{Value(numeric_limits<long long>::max()), Value(1.0)},
           Value(numeric_limits<long long>::max() + 1.0)},
@@ -51,6 +51,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/granularity_rounder.h"
+#include "mongo/db/pipeline/group_table.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/value.h"
@@ -59,6 +60,7 @@
 #include "mongo/db/sorter/sorter.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/intrusive_counter.h"
 
 namespace mongo {
@@ -667,10 +669,13 @@ private:
 class DocumentSourceGroup final : public DocumentSource, public SplittableDocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<Accumulator>>;
-    using GroupsMap = ValueUnorderedMap<Accumulators>;
+    using GroupsMap = GroupTable<Accumulators>;
 
     static const size_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
+    // Number of partitions, by hash of the group key, that an unsorted $group spills to disk.
+    static const size_t kNumSpillPartitions = 16;
+
     // Virtuals from DocumentSource.
     boost::intrusive_ptr<DocumentSource> optimize() final;
     GetDepsReturn getDependencies(DepsTracker* deps) const final;
@@ -760,9 +765,53 @@ private:
      * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
      * does not exhaust the previous stage before returning, and thus does not maintain as large a
      * store of documents at any one time, only an unsorted group can spill to disk.
+     *
+     * Only used when a single spilled partition does not fit in memory when it is read back.
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    /**
+     * Frees memory by writing out the groups of whole hash partitions, as in hybrid hash
+     * aggregation. The groups of partitions that have already been spilled are written first,
+     * followed by the largest partitions still held in memory until at most half of
+     * '_maxMemoryUsageBytes' remains in use. Partitions never spilled keep being aggregated in
+     * memory.
+     */
+    void spillPartitions();
+
+    /**
+     * Writes the groups of every partition 'p' with 'partitions[p]' set to a single run, ordered
+     * by partition, marks those partitions as spilled and removes their groups from '_groups'.
+     * 'usage' is the memory used by the groups of each partition.
+     */
+    void writePartitions(const std::vector<bool>& partitions, const std::vector<size_t>& usage);
+
+    /**
+     * Replaces the contents of '_groups' by the groups of the next spilled partition, built by
+     * merging the partial results read back from each run. If the partition does not fit in
+     * memory by itself, sets up '_sorterIterator' to merge sorted runs of it instead. Returns
+     * false if there are no more spilled partitions.
+     */
+    bool loadNextSpilledPartition();
+
+    /**
+     * Feeds the operands buffered in '_batchInputs' to the accumulators of their groups. The rows
+     * are first regrouped column by column so that each accumulator of each group sees all of its
+     * inputs from the batch, in arrival order, in a single call to Accumulator::processBatch().
+     * Must be called before anything that invalidates the pointers in '_batchGroups'.
+     *
+     * When merging, the distinct groups of a large batch are partitioned across up to
+     * '_mergeThreads' threads. Every group is updated by exactly one thread.
+     */
+    void processInputBatch();
+
+    /**
+     * Runs applyPartition(0) through applyPartition(numPartitions - 1) concurrently, one of them on
+     * the calling thread and the rest on '_mergePool', and returns once all of them have finished.
+     * Rethrows the first error raised by any partition.
+     */
+    void runPartitioned(size_t numPartitions, const stdx::function<void(size_t)>& applyPartition);
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
     /**
@@ -806,18 +855,44 @@ private:
     boost::optional<GroupsMap> _groups;
 
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
-    bool _spilled;
 
-    // Only used when '_spilled' is false.
+    // Iterates over '_groups' once the input has been exhausted.
     GroupsMap::iterator groupsIterator;
 
-    // Only used when '_spilled' is true.
+    // A run written by writePartitions(), along with the number of groups it holds for each
+    // partition. The groups are stored in order of partition.
+    struct SpilledRun {
+        std::shared_ptr<Sorter<Value, Value>::Iterator> iterator;
+        std::vector<size_t> groupsPerPartition;
+    };
+    std::vector<SpilledRun> _spilledRuns;
+
+    // Which partitions have been written to disk, and the next one loadNextSpilledPartition()
+    // reads back.
+    std::vector<bool> _spilledPartitions;
+    size_t _nextSpilledPartition = 0;
+
+    // Only used while returning a spilled partition that had to be sorted.
     std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
     const bool _extSortAllowed;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
     // Only used when '_sorted' is true.
     boost::optional<Document> _firstDocOfNextGroup;
+
+    // Number of input documents whose accumulator updates are deferred and applied together by
+    // processInputBatch() when building an unsorted $group. Zero disables batching.
+    const size_t _batchSize;
+
+    // The group each buffered document belongs to, and the evaluated accumulator operands of each
+    // buffered document, stored row by row with one Value per accumulator.
+    std::vector<Accumulators*> _batchGroups;
+    std::vector<Value> _batchInputs;
+
+    // Threads a merging $group uses to apply each batch. The pool holds the threads beyond the
+    // calling one and is started the first time a batch is large enough to be partitioned.
+    const size_t _mergeThreads;
+    std::unique_ptr<ThreadPool> _mergePool;
 };
 
 /**
@@ -1837,6 +1912,23 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Joins 'inputDoc' with the documents in the foreign collection by running a query for its
+     * local value alone.
+     */
+    Document performLookup(Document inputDoc);
+
+    /**
+     * Joins every document in 'inputs' with the documents in the foreign collection by running a
+     * single query for all of their local values, then matching each foreign document back to the
+     * inputs whose local value it joins with. The joined documents are appended to
+     * '_batchedOutput' in input order.
+     *
+     * If the combined query would be too large, or the foreign documents of the batch take up too
+     * much memory, 'inputs' are instead appended to '_unbatchedInputs' to be joined one at a time.
+     */
+    void performBatchedLookup(std::vector<Document> inputs);
+
     NamespaceString _fromNs;
     FieldPath _as;
     FieldPath _localField;
@@ -1863,6 +1955,15 @@ private:
     boost::intrusive_ptr<Pipeline> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // The following members are used to hold onto state across getNext() calls when input
+    // documents are joined in batches. '_unbatchedInputs' holds the inputs of a batch that was too
+    // large to join at once. '_pendingInputResult' holds a result received from our source after a
+    // batch was filled: a pause or EOF, which is returned once the batch has been drained, or an
+    // input document, which starts the next batch.
+    std::deque<Document> _batchedOutput;
+    std::deque<Document> _unbatchedInputs;
+    boost::optional<GetNextResult> _pendingInputResult;
 };
 
 class DocumentSourceGraphLookUp final : public DocumentSourceNeedsMongod {
@@ -1896,6 +1997,8 @@ public:
 
     void doReattachToOperationContext(OperationContext* opCtx) final;
 
+    static const size_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
+
     static boost::intrusive_ptr<DocumentSourceGraphLookUp> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         NamespaceString fromNs,
@@ -1906,7 +2009,8 @@ public:
         boost::optional<BSONObj> additionalFilter,
         boost::optional<FieldPath> depthField,
         boost::optional<long long> maxDepth,
-        boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc);
+        boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc,
+        size_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes);
 
     static boost::intrusive_ptr<DocumentSource> createFromBson(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
@@ -1933,15 +2037,21 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
-     *
-     * Fills 'cached' with any values that were retrieved from the cache.
+     * Removes the values of '_frontier' which are present in the cache, filling 'cached' with the
+     * documents that were retrieved from the cache for them.
+     */
+    void removeCachedValuesFromFrontier(BSONObjSet* cached);
+
+    /**
+     * Prepares the next query to execute on the 'from' collection wrapped in a $match, using the
+     * values of 'queried' starting at '*nextToQuery'. Each query covers a bounded number of values
+     * so that a large frontier is searched with several queries of reasonable size.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Advances '*nextToQuery' past the values included in the query. Must not be called once
+     * '*nextToQuery' has reached the end of 'queried'.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(BSONObjSet* cached);
+    BSONObj makeMatchStage(const ValueUnorderedSet& queried,
+                           ValueUnorderedSet::const_iterator* nextToQuery);
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -1969,10 +2079,36 @@ private:
 
     /**
      * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'. If disk use
+     * is allowed, the documents in '_visited' are spilled before the limit is enforced.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents held in '_visited' to disk as a run sorted by '_id'. Their '_id' values
+     * remain in '_visited', mapped to an empty object, so that they are not visited again.
+     */
+    void spillVisited();
+
+    /**
+     * Called once the search for the current input is complete. If any of the results were spilled
+     * during the search, spills the remaining ones as well and sets up '_spilledResults' to read
+     * them back.
+     */
+    void finishSpilledSearch();
+
+    /**
+     * Returns whether any of the results of the last search have yet to be consumed by
+     * popResult().
+     */
+    bool hasMoreResults() const;
+
+    /**
+     * Removes and returns one of the results of the last search. Must only be called if
+     * hasMoreResults() returns true.
+     */
+    BSONObj popResult();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -1998,7 +2134,7 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -2018,6 +2154,14 @@ private:
     // to getNext().
     LookupSetCache _cache;
 
+    // Runs of visited documents that were written to disk during the current search, each sorted by
+    // '_id'.
+    std::vector<std::shared_ptr<Sorter<Value, BSONObj>::Iterator>> _visitedSpills;
+
+    // If the current search spilled to disk, all of its results are read back through this iterator
+    // rather than from '_visited'.
+    std::unique_ptr<Sorter<Value, BSONObj>::Iterator> _spilledResults;
+
     // When we have internalized a $unwind, we must keep track of the input document, since we will
     // need it for multiple "getNext()" calls.
     boost::optional<Document> _input;
@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -50,6 +51,26 @@ namespace dps = ::mongo::dotted_path_support;
 
 REGISTER_DOCUMENT_SOURCE(graphLookup, DocumentSourceGraphLookUp::createFromBson);
 
+namespace {
+
+// The maximum number of values from the frontier included in a single query against the 'from'
+// collection. Larger frontiers are searched with several queries.
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGraphLookupQueryBatchSize, int, 10000);
+
+// Keeps the $in list of a single query well below the maximum size of a BSON object.
+const size_t kMaxQueryValueBytes = BSONObjMaxUserSize / 2;
+
+class VisitedSpillComparator {
+public:
+    typedef std::pair<Value, BSONObj> Data;
+
+    int operator()(const Data& lhs, const Data& rhs) const {
+        return ValueComparator::kInstance.compare(lhs.first, rhs.first);
+    }
+};
+
+}  // namespace
+
 const char* DocumentSourceGraphLookUp::getSourceName() const {
     return "$graphLookup";
 }
@@ -72,11 +93,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasMoreResults()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popResult()));
     }
 
     MutableDocument output(*_input);
@@ -95,7 +114,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasMoreResults()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -111,7 +130,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasMoreResults()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -125,13 +144,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popResult()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -142,9 +159,29 @@ void DocumentSourceGraphLookUp::dispose() {
     _cache.clear();
     _frontier->clear();
     _visited.clear();
+    _visitedSpills.clear();
+    _spilledResults.reset();
     pSource->dispose();
 }
 
+bool DocumentSourceGraphLookUp::hasMoreResults() const {
+    if (_spilledResults) {
+        return _spilledResults->more();
+    }
+    return !_visited.empty();
+}
+
+BSONObj DocumentSourceGraphLookUp::popResult() {
+    if (_spilledResults) {
+        return _spilledResults->next().second;
+    }
+
+    auto it = _visited.begin();
+    BSONObj result = std::move(it->second);
+    _visited.erase(it);
+    return result;
+}
+
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
     long long depth = 0;
     bool shouldPerformAnotherQuery;
@@ -153,7 +190,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         BSONObjSet cached = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        removeCachedValuesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier->swap(queried);
@@ -168,12 +205,12 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
-
+        // Query for all keys that were in the frontier and not in the cache, populating '_frontier'
+        // for the next iteration of search.
+        auto nextToQuery = queried.cbegin();
+        while (nextToQuery != queried.cend()) {
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = makeMatchStage(queried, &nextToQuery);
             auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
             while (auto next = pipeline->getNext()) {
                 uassert(40271,
@@ -187,8 +224,8 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
                 shouldPerformAnotherQuery =
                     addToVisitedAndFrontier(result.getOwned(), depth) || shouldPerformAnotherQuery;
                 addToCache(result, queried);
+                checkMemoryUsage();
             }
-            checkMemoryUsage();
         }
 
         ++depth;
@@ -278,7 +315,7 @@ void DocumentSourceGraphLookUp::addToCache(const BSONObj& result,
     }
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(BSONObjSet* cached) {
+void DocumentSourceGraphLookUp::removeCachedValuesFromFrontier(BSONObjSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier->begin(); it != _frontier->end();) {
         if (auto entry = _cache[*it]) {
@@ -296,6 +333,12 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(B
             it = std::next(it);
         }
     }
+}
+
+BSONObj DocumentSourceGraphLookUp::makeMatchStage(const ValueUnorderedSet& queried,
+                                                  ValueUnorderedSet::const_iterator* nextToQuery) {
+    invariant(*nextToQuery != queried.cend());
+    const size_t maxValues = std::max(internalDocumentSourceGraphLookupQueryBatchSize.load(), 1);
 
     // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
     //
@@ -316,8 +359,15 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(B
                     BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
                     {
                         BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : *_frontier) {
+                        size_t numValues = 0;
+                        size_t valueBytes = 0;
+                        while (*nextToQuery != queried.cend() && numValues < maxValues &&
+                               valueBytes < kMaxQueryValueBytes) {
+                            const Value& value = **nextToQuery;
                             in << value;
+                            ++numValues;
+                            valueBytes += value.getApproximateSize();
+                            ++*nextToQuery;
                         }
                     }
                 }
@@ -325,12 +375,13 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(B
         }
     }
 
-    return _frontier->empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return match.obj();
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
     // Make sure _input is set before calling performSearch().
     invariant(_input);
+    _spilledResults.reset();
 
     _variables->setRoot(*_input);
     Value startingValue = _startWith->evaluateInternal(_variables.get());
@@ -348,6 +399,23 @@ void DocumentSourceGraphLookUp::performSearch() {
     }
 
     doBreadthFirstSearch();
+    finishSpilledSearch();
+}
+
+void DocumentSourceGraphLookUp::finishSpilledSearch() {
+    if (_visitedSpills.empty()) {
+        return;
+    }
+
+    // The search is complete, so '_visited' is no longer needed to de-duplicate results. Spill the
+    // documents still held in memory and read all of the results back from disk.
+    spillVisited();
+    _visited.clear();
+    _visitedUsageBytes = 0;
+
+    _spilledResults.reset(Sorter<Value, BSONObj>::Iterator::merge(
+        _visitedSpills, SortOptions(), VisitedSpillComparator()));
+    _visitedSpills.clear();
 }
 
 Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::optimizeAt(
@@ -378,13 +446,50 @@ BSONObjSet DocumentSourceGraphLookUp::getOutputSorts() {
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if ((_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes &&
+        pExpCtx->extSortAllowed && !pExpCtx->inRouter) {
+        // Only the '_id' values of the visited documents need to stay in memory.
+        spillVisited();
+    }
+
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
 
+void DocumentSourceGraphLookUp::spillVisited() {
+    std::vector<ValueUnorderedMap<BSONObj>::iterator> toSpill;
+    for (auto it = _visited.begin(); it != _visited.end(); ++it) {
+        if (!it->second.isEmpty()) {
+            toSpill.push_back(it);
+        }
+    }
+
+    if (toSpill.empty()) {
+        return;
+    }
+
+    std::sort(toSpill.begin(),
+              toSpill.end(),
+              [](const ValueUnorderedMap<BSONObj>::iterator& lhs,
+                 const ValueUnorderedMap<BSONObj>::iterator& rhs) {
+                  return ValueComparator::kInstance.evaluate(lhs->first < rhs->first);
+              });
+
+    SortedFileWriter<Value, BSONObj> writer(SortOptions().TempDir(pExpCtx->tempDir));
+    for (auto&& it : toSpill) {
+        writer.addAlreadySorted(it->first, it->second);
+
+        // Documents from the 'from' collection always contain an _id, so an empty object marks a
+        // visited document which has been spilled.
+        invariant(static_cast<size_t>(it->second.objsize()) <= _visitedUsageBytes);
+        _visitedUsageBytes -= it->second.objsize();
+        it->second = BSONObj();
+    }
+    _visitedSpills.emplace_back(writer.done());
+}
+
 void DocumentSourceGraphLookUp::serializeToArray(std::vector<Value>& array, bool explain) const {
     // Serialize default options.
     MutableDocument spec(DOC("from" << _from.coll() << "as" << _as.fullPath() << "connectToField"
@@ -483,7 +588,8 @@ intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
     boost::optional<BSONObj> additionalFilter,
     boost::optional<FieldPath> depthField,
     boost::optional<long long> maxDepth,
-    boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc) {
+    boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc,
+    size_t maxMemoryUsageBytes) {
     intrusive_ptr<DocumentSourceGraphLookUp> source(
         new DocumentSourceGraphLookUp(expCtx,
                                       std::move(fromNs),
@@ -496,6 +602,7 @@ intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
                                       maxDepth,
                                       unwindSrc));
     source->_variables.reset(new Variables());
+    source->_maxMemoryUsageBytes = maxMemoryUsageBytes;
 
     source->injectExpressionContext(expCtx);
     return source;
@@ -615,3 +722,6 @@ intrusive_ptr<DocumentSource> DocumentSourceGraphLookUp::createFromBson(
     return std::move(newSource);
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
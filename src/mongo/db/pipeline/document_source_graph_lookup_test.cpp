@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/stub_mongod_interface.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
@@ -246,6 +247,92 @@ TEST_F(DocumentSourceGraphLookUpTest,
     }
 }
 
+/**
+ * Returns the contents of a 'from' collection forming a chain 0 -> 1 -> ... -> 'length' - 1, where
+ * each document is padded to roughly 'paddingBytes' in size.
+ */
+std::deque<DocumentSource::GetNextResult> makeChainWithPadding(int length, size_t paddingBytes) {
+    const std::string padding(paddingBytes, 'x');
+    std::deque<DocumentSource::GetNextResult> chain;
+    for (int i = 0; i < length; ++i) {
+        chain.push_back(Document{{"_id", i}, {"to", i}, {"from", i + 1}, {"padding", padding}});
+    }
+    return chain;
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillVisitedDocumentsWhenDiskUseIsAllowed) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->extSortAllowed = true;
+
+    const int chainLength = 20;
+    const size_t maxMemoryUsageBytes = 1000;
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}}};
+    auto inputMock = DocumentSourceMock::create(std::move(inputs));
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->resolvedNamespaces[fromNs.coll()] = {fromNs, std::vector<BSONObj>{}};
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(expCtx,
+                                                              fromNs,
+                                                              "results",
+                                                              "from",
+                                                              "to",
+                                                              ExpressionFieldPath::create("_id"),
+                                                              boost::none,
+                                                              boost::none,
+                                                              boost::none,
+                                                              boost::none,
+                                                              maxMemoryUsageBytes);
+    graphLookupStage->setSource(inputMock.get());
+    graphLookupStage->injectMongodInterface(std::make_shared<MockMongodImplementation>(
+        makeChainWithPadding(chainLength, maxMemoryUsageBytes / 2)));
+
+    // The visited documents take up many times the memory limit, but only their _ids need to
+    // stay in memory.
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto resultsValue = next.getDocument().getField("results");
+    ASSERT(resultsValue.isArray());
+    auto resultsArray = resultsValue.getArray();
+    ASSERT_EQ(static_cast<size_t>(chainLength), resultsArray.size());
+    for (int i = 0; i < chainLength; ++i) {
+        ASSERT(std::any_of(resultsArray.begin(), resultsArray.end(), [i](const Value& result) {
+            return result["_id"].getInt() == i;
+        }));
+    }
+
+    ASSERT(graphLookupStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldErrorWhenExceedingMemoryLimitWithoutDiskUse) {
+    auto expCtx = getExpCtx();
+    expCtx->extSortAllowed = false;
+
+    const size_t maxMemoryUsageBytes = 1000;
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}}};
+    auto inputMock = DocumentSourceMock::create(std::move(inputs));
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->resolvedNamespaces[fromNs.coll()] = {fromNs, std::vector<BSONObj>{}};
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(expCtx,
+                                                              fromNs,
+                                                              "results",
+                                                              "from",
+                                                              "to",
+                                                              ExpressionFieldPath::create("_id"),
+                                                              boost::none,
+                                                              boost::none,
+                                                              boost::none,
+                                                              boost::none,
+                                                              maxMemoryUsageBytes);
+    graphLookupStage->setSource(inputMock.get());
+    graphLookupStage->injectMongodInterface(std::make_shared<MockMongodImplementation>(
+        makeChainWithPadding(20, maxMemoryUsageBytes / 2)));
+
+    ASSERT_THROWS_CODE(graphLookupStage->getNext(), UserException, 40099);
+}
+
 TEST_F(DocumentSourceGraphLookUpTest, ShouldPropagatePauses) {
     auto expCtx = getExpCtx();
 
@@ -37,7 +37,9 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -48,6 +50,79 @@ using std::vector;
 
 REGISTER_DOCUMENT_SOURCE(group, DocumentSourceGroup::createFromBson);
 
+namespace {
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalDocumentSourceGroupBatchSize, int, 1024);
+
+// Threads a merging $group uses to apply each batch of partial results to its groups. The merging
+// half of a split pipeline otherwise folds the results of every shard on a single thread.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalDocumentSourceGroupMergeThreads, int, 1);
+
+// Fewest distinct groups of a batch given to each merge thread. Smaller batches use fewer threads.
+const size_t kMinGroupsPerMergeThread = 64;
+
+/**
+ * Returns the partial results of 'accumulators' in the form they are written to disk: nothing when
+ * there are no accumulators, the single Value of a single accumulator, or else an array with one
+ * Value per accumulator.
+ */
+Value getMergeableState(const DocumentSourceGroup::Accumulators& accumulators) {
+    switch (accumulators.size()) {
+        case 0:  // no values, essentially a distinct
+            return Value();
+        case 1:  // just one value, use optimized serialization as single Value
+            return accumulators[0]->getValue(/*toBeMerged=*/true);
+        default: {  // multiple values, serialize as array-typed Value
+            vector<Value> accums;
+            for (auto&& accumulator : accumulators) {
+                accums.push_back(accumulator->getValue(/*toBeMerged=*/true));
+            }
+            return Value(std::move(accums));
+        }
+    }
+}
+
+/**
+ * Merges partial results produced by getMergeableState() into 'accumulators'.
+ */
+void mergeState(const Value& state, const DocumentSourceGroup::Accumulators& accumulators) {
+    switch (accumulators.size()) {  // mirrors switch in getMergeableState()
+        case 1:                     // Single accumulators serialize as a single Value.
+            accumulators[0]->process(state, true);
+        case 0:  // No accumulators so no Values.
+            break;
+        default: {  // Multiple accumulators serialize as an array of Values.
+            const vector<Value>& accumulatorStates = state.getArray();
+            for (size_t i = 0; i < accumulators.size(); i++) {
+                accumulators[i]->process(accumulatorStates[i], true);
+            }
+        }
+    }
+}
+
+/**
+ * Returns the spill partition of a group whose key hashes to 'hash'. The hash is scrambled with a
+ * different multiplier than GroupTable uses to choose a slot, so that the groups of one partition
+ * still spread over the whole table when the partition is read back.
+ */
+size_t getSpillPartition(size_t hash) {
+    return static_cast<size_t>((static_cast<uint64_t>(hash) * 0xC2B2AE3D27D4EB4FULL) >> 32) %
+        DocumentSourceGroup::kNumSpillPartitions;
+}
+
+/**
+ * Returns the memory used by a group, as accounted for in '_memoryUsageBytes'.
+ */
+size_t getMemoryUsage(const DocumentSourceGroup::GroupsMap::value_type& group) {
+    size_t usage = group.first.getApproximateSize();
+    for (auto&& accumulator : group.second) {
+        usage += accumulator->memUsageForSorter();
+    }
+    return usage;
+}
+
+}  // namespace
+
 const char* DocumentSourceGroup::getSourceName() const {
     return "$group";
 }
@@ -67,40 +142,37 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNext() {
         accum->reset();  // Prep accumulators for a new group.
     }
 
-    if (_spilled) {
-        return getNextSpilled();
-    } else if (_streaming) {
+    if (_streaming) {
         return getNextStreaming();
-    } else {
-        return getNextStandard();
     }
+
+    // The groups that were never spilled are returned first, followed by each spilled partition in
+    // turn.
+    while (!_sorterIterator && groupsIterator == _groups->end()) {
+        if (!loadNextSpilledPartition()) {
+            return GetNextResult::makeEOF();
+        }
+    }
+    return _sorterIterator ? getNextSpilled() : getNextStandard();
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
-    // We aren't streaming, and we have spilled to disk.
+    // We aren't streaming, and the current partition was too large to merge in memory.
     if (!_sorterIterator)
         return GetNextResult::makeEOF();
 
     _currentId = _firstPartOfNextGroup.first;
-    const size_t numAccumulators = vpAccumulatorFactory.size();
     while (pExpCtx->getValueComparator().evaluate(_currentId == _firstPartOfNextGroup.first)) {
         // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
         // At loop exit, it is the first value to be processed in the next group.
-        switch (numAccumulators) {  // mirrors switch in spill()
-            case 1:                 // Single accumulators serialize as a single Value.
-                _currentAccumulators[0]->process(_firstPartOfNextGroup.second, true);
-            case 0:  // No accumulators so no Values.
-                break;
-            default: {  // Multiple accumulators serialize as an array of Values.
-                const vector<Value>& accumulatorStates = _firstPartOfNextGroup.second.getArray();
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators[i]->process(accumulatorStates[i], true);
-                }
-            }
-        }
+        mergeState(_firstPartOfNextGroup.second, _currentAccumulators);
 
         if (!_sorterIterator->more()) {
-            dispose();
+            _sorterIterator.reset();
+            _sortedFiles.clear();
+            if (_nextSpilledPartition == _spilledPartitions.size()) {
+                dispose();
+            }
             break;
         }
 
@@ -111,14 +183,16 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
-    // Not spilled, and not streaming.
-    if (_groups->empty())
+    // Not streaming, and the groups are held in memory.
+    if (groupsIterator == _groups->end())
         return GetNextResult::makeEOF();
 
     Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->inShard);
 
-    if (++groupsIterator == _groups->end())
+    if (++groupsIterator == _groups->end() &&
+        _nextSpilledPartition == _spilledPartitions.size()) {
         dispose();
+    }
 
     return std::move(out);
 }
@@ -168,14 +242,20 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
 
 void DocumentSourceGroup::dispose() {
     // Free our resources.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _groups = GroupsMap(pExpCtx->getValueComparator());
     _sorterIterator.reset();
+    _sortedFiles.clear();
+    _spilledRuns.clear();
+    _nextSpilledPartition = _spilledPartitions.size();
 
     // Make us look done.
     groupsIterator = _groups->end();
 
     _firstDocOfNextGroup = boost::none;
 
+    _batchGroups.clear();
+    _batchInputs.clear();
+
     // Free our source's resources.
     pSource->dispose();
 }
@@ -197,7 +277,7 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
 
 void DocumentSourceGroup::doInjectExpressionContext() {
     // Groups map must respect new comparator.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _groups = GroupsMap(pExpCtx->getValueComparator());
 
     for (auto&& idExpr : _idExpressions) {
         idExpr->injectExpressionContext(pExpCtx);
@@ -289,8 +369,9 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _inputSort(BSONObj()),
       _streaming(false),
       _initialized(false),
-      _spilled(false),
-      _extSortAllowed(pExpCtx->extSortAllowed && !pExpCtx->inRouter) {}
+      _extSortAllowed(pExpCtx->extSortAllowed && !pExpCtx->inRouter),
+      _batchSize(std::max(0, internalDocumentSourceGroupBatchSize)),
+      _mergeThreads(std::max(1, internalDocumentSourceGroupMergeThreads)) {}
 
 void DocumentSourceGroup::addAccumulator(AccumulationStatement accumulationStatement) {
     vFieldName.push_back(accumulationStatement.fieldName);
@@ -456,26 +537,6 @@ void getFieldPathMap(ExpressionObject* expressionObj,
         }
     }
 }
-
-void getFieldPathListForSpilled(ExpressionObject* expressionObj,
-                                std::string prefix,
-                                std::vector<std::string>* fields) {
-    // Given an expression, attempt to compute a vector of strings, each representing the path
-    // through the object to a leaf. For example, for the expression represented by
-    // {x: 2, y: {z: "$a.b"}}, the output would be ["x", "y.z"].
-    for (auto&& it : expressionObj->getChildExpressions()) {
-        intrusive_ptr<Expression> childExp = it.second;
-        ExpressionObject* expObj = dynamic_cast<ExpressionObject*>(childExp.get());
-
-        std::string newPrefix = prefix.empty() ? it.first : prefix + "." + it.first;
-
-        if (expObj) {
-            getFieldPathListForSpilled(expObj, newPrefix, fields);
-        } else {
-            fields->push_back(newPrefix);
-        }
-    }
-}
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
@@ -519,8 +580,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                     "Exceeded memory limit for $group, but didn't allow external sort."
                     " Pass allowDiskUse:true to opt in.",
                     _extSortAllowed);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
+            processInputBatch();
+            spillPartitions();
         }
 
         _variables->setRoot(input.releaseDocument());
@@ -528,11 +589,11 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         Value id = computeId(_variables.get());
 
         // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
+        // accumulator.
+        auto insertResult = _groups->insert(id);
+        vector<intrusive_ptr<Accumulator>>& group = insertResult.first->second;
+        const size_t hash = insertResult.first->hash;
+        const bool inserted = insertResult.second;
 
         if (inserted) {
             _memoryUsageBytes += id.getApproximateSize();
@@ -542,32 +603,60 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             for (size_t i = 0; i < numAccumulators; i++) {
                 group.push_back(vpAccumulatorFactory[i]());
                 group.back()->injectExpressionContext(pExpCtx);
+                if (_batchSize) {
+                    // processInputBatch() only accounts for the change in usage.
+                    _memoryUsageBytes += group.back()->memUsageForSorter();
+                }
             }
-        } else {
+        } else if (!_batchSize) {
             for (size_t i = 0; i < numAccumulators; i++) {
                 // subtract old mem usage. New usage added back after processing.
                 _memoryUsageBytes -= group[i]->memUsageForSorter();
             }
         }
 
-        /* tickle all the accumulators for the group we found */
         dassert(numAccumulators == group.size());
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(vpExpression[i]->evaluate(_variables.get()), _doingMerge);
-            _memoryUsageBytes += group[i]->memUsageForSorter();
+        if (_batchSize) {
+            // Only evaluate the operands here. The accumulators are updated once the batch fills,
+            // and until then the buffered operands count against the memory limit.
+            _batchGroups.push_back(&group);
+            for (size_t i = 0; i < numAccumulators; i++) {
+                _batchInputs.push_back(vpExpression[i]->evaluate(_variables.get()));
+                _memoryUsageBytes += _batchInputs.back().getApproximateSize();
+            }
+        } else {
+            /* tickle all the accumulators for the group we found */
+            for (size_t i = 0; i < numAccumulators; i++) {
+                group[i]->process(vpExpression[i]->evaluate(_variables.get()), _doingMerge);
+                _memoryUsageBytes += group[i]->memUsageForSorter();
+            }
         }
 
         // We are done with the ROOT document so release it.
         _variables->clearRoot();
 
+        if (_batchGroups.size() >= _batchSize) {
+            processInputBatch();
+        }
+
         if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
+            // In debug mode, spill the partition of every duplicate id to stress merge logic.
             if (!inserted &&                 // is a dup
                 !pExpCtx->inRouter &&        // can't spill to disk in router
                 !_extSortAllowed &&          // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
-
-                _sortedFiles.push_back(spill());
+                _spilledRuns.size() < 20) {  // don't open too many FDs
+
+                processInputBatch();
+                const size_t partition = getSpillPartition(hash);
+                vector<bool> partitions(kNumSpillPartitions, false);
+                partitions[partition] = true;
+                vector<size_t> usage(kNumSpillPartitions, 0);
+                for (auto&& entry : *_groups) {
+                    if (getSpillPartition(entry.hash) == partition) {
+                        usage[partition] += getMemoryUsage(entry);
+                    }
+                }
+                writePartitions(partitions, usage);
             }
         }
     }
@@ -580,33 +669,27 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             return input;  // Propagate pause.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
-            // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
-                _spilled = true;
-                if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
-                }
-
-                // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
-
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators.push_back(vpAccumulatorFactory[i]());
-                    _currentAccumulators.back()->injectExpressionContext(pExpCtx);
+            // Apply whatever is left of the last batch before anything reads the groups.
+            processInputBatch();
+
+            // The groups of spilled partitions still in memory are written out as well, so that
+            // every spilled partition can be read back from disk alone.
+            if (!_spilledPartitions.empty()) {
+                vector<size_t> usage(kNumSpillPartitions, 0);
+                for (auto&& entry : *_groups) {
+                    usage[getSpillPartition(entry.hash)] += getMemoryUsage(entry);
                 }
+                writePartitions(_spilledPartitions, usage);
 
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
-            } else {
-                // start the group iterator
-                groupsIterator = _groups->begin();
+                _nextSpilledPartition = std::find(_spilledPartitions.begin(),
+                                                  _spilledPartitions.end(),
+                                                  true) -
+                    _spilledPartitions.begin();
             }
 
+            // start the group iterator
+            groupsIterator = _groups->begin();
+
             // This must happen last so that, unless control gets here, we will re-enter
             // initialization after getting a GetNextResult::ResultState::kPauseExecution.
             _initialized = true;
@@ -616,6 +699,121 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+void DocumentSourceGroup::processInputBatch() {
+    const size_t numAccumulators = vpAccumulatorFactory.size();
+    const size_t numRows = _batchGroups.size();
+    if (numRows == 0) {
+        return;
+    }
+    dassert(_batchInputs.size() == numRows * numAccumulators);
+
+    // Number the distinct groups of this batch densely, in order of first appearance.
+    vector<Accumulators*> groups;
+    vector<size_t> rowGroup(numRows);
+    stdx::unordered_map<Accumulators*, size_t> groupOrdinals;
+    for (size_t row = 0; row < numRows; row++) {
+        auto it = groupOrdinals.emplace(_batchGroups[row], groups.size()).first;
+        if (it->second == groups.size()) {
+            groups.push_back(_batchGroups[row]);
+        }
+        rowGroup[row] = it->second;
+    }
+
+    // Counting sort of the rows by group: the inputs of group 'g' end up in the half-open range
+    // [groupStart[g], groupStart[g + 1]) of a column, still in arrival order.
+    vector<size_t> groupStart(groups.size() + 1, 0);
+    for (size_t row = 0; row < numRows; row++) {
+        groupStart[rowGroup[row] + 1]++;
+    }
+    for (size_t g = 0; g < groups.size(); g++) {
+        groupStart[g + 1] += groupStart[g];
+    }
+
+    vector<vector<Value>> columns(numAccumulators, vector<Value>(numRows));
+    vector<size_t> nextSlot;
+    for (size_t i = 0; i < numAccumulators; i++) {
+        nextSlot.assign(groupStart.begin(), groupStart.end() - 1);
+        for (size_t row = 0; row < numRows; row++) {
+            Value& input = _batchInputs[row * numAccumulators + i];
+            _memoryUsageBytes -= input.getApproximateSize();
+            columns[i][nextSlot[rowGroup[row]]++] = std::move(input);
+        }
+    }
+
+    // Groups are independent of each other, so when merging, the groups of the batch are dealt out
+    // to the partitions by their ordinal. Each partition tracks the memory usage of its own
+    // accumulators before and after processing them.
+    size_t numPartitions = 1;
+    if (_doingMerge) {
+        numPartitions = std::max(
+            size_t(1), std::min(_mergeThreads, groups.size() / kMinGroupsPerMergeThread));
+    }
+    vector<size_t> usageBefore(numPartitions, 0);
+    vector<size_t> usageAfter(numPartitions, 0);
+    auto applyPartition = [&](size_t partition) {
+        for (size_t g = partition; g < groups.size(); g += numPartitions) {
+            for (size_t i = 0; i < numAccumulators; i++) {
+                Accumulator* accumulator = (*groups[g])[i].get();
+                usageBefore[partition] += accumulator->memUsageForSorter();
+                accumulator->processBatch(
+                    &columns[i][groupStart[g]], groupStart[g + 1] - groupStart[g], _doingMerge);
+                usageAfter[partition] += accumulator->memUsageForSorter();
+            }
+        }
+    };
+
+    if (numPartitions == 1) {
+        applyPartition(0);
+    } else {
+        runPartitioned(numPartitions, applyPartition);
+    }
+
+    for (size_t partition = 0; partition < numPartitions; partition++) {
+        // subtract old mem usage. New usage added back after processing.
+        _memoryUsageBytes -= usageBefore[partition];
+        _memoryUsageBytes += usageAfter[partition];
+    }
+
+    _batchGroups.clear();
+    _batchInputs.clear();
+}
+
+void DocumentSourceGroup::runPartitioned(size_t numPartitions,
+                                         const stdx::function<void(size_t)>& applyPartition) {
+    invariant(numPartitions <= _mergeThreads);
+    if (!_mergePool) {
+        ThreadPool::Options options;
+        options.poolName = "DocumentSourceGroupMerge";
+        options.threadNamePrefix = "groupMerge-";
+        options.minThreads = _mergeThreads - 1;
+        options.maxThreads = _mergeThreads - 1;
+        _mergePool = stdx::make_unique<ThreadPool>(options);
+        _mergePool->startup();
+    }
+
+    stdx::mutex mutex;
+    Status status = Status::OK();
+    auto runPartition = [&](size_t partition) {
+        try {
+            applyPartition(partition);
+        } catch (const DBException& ex) {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            if (status.isOK()) {
+                status = ex.toStatus();
+            }
+        }
+    };
+
+    for (size_t partition = 1; partition < numPartitions; partition++) {
+        auto task = [&runPartition, partition] { runPartition(partition); };
+        fassertStatusOK(40323, _mergePool->schedule(task));
+    }
+    runPartition(0);
+    _mergePool->waitForIdle();
+
+    uassertStatusOK(status);
+}
+
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
     ptrs.reserve(_groups->size());
@@ -626,34 +824,167 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
 
     SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
-    switch (vpAccumulatorFactory.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                             // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+    for (size_t i = 0; i < ptrs.size(); i++) {
+        writer.addAlreadySorted(ptrs[i]->first, getMergeableState(ptrs[i]->second));
+    }
+
+    _groups->clear();
+
+    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+}
+
+void DocumentSourceGroup::spillPartitions() {
+    vector<size_t> usage(kNumSpillPartitions, 0);
+    size_t totalUsage = 0;
+    for (auto&& entry : *_groups) {
+        const size_t groupUsage = getMemoryUsage(entry);
+        usage[getSpillPartition(entry.hash)] += groupUsage;
+        totalUsage += groupUsage;
+    }
+
+    if (_spilledPartitions.empty()) {
+        _spilledPartitions.assign(kNumSpillPartitions, false);
+    }
+
+    // Groups of partitions that are already on disk gain nothing from staying in memory.
+    vector<bool> partitions(_spilledPartitions);
+    for (size_t p = 0; p < kNumSpillPartitions; p++) {
+        if (partitions[p]) {
+            totalUsage -= usage[p];
+        }
+    }
+
+    // Then spill the largest remaining partitions, leaving room to keep aggregating the rest.
+    while (totalUsage > _maxMemoryUsageBytes / 2) {
+        size_t largest = kNumSpillPartitions;
+        for (size_t p = 0; p < kNumSpillPartitions; p++) {
+            if (!partitions[p] && (largest == kNumSpillPartitions || usage[p] > usage[largest])) {
+                largest = p;
             }
+        }
+        if (largest == kNumSpillPartitions) {
             break;
+        }
+        partitions[largest] = true;
+        totalUsage -= usage[largest];
+    }
 
-        case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+    writePartitions(partitions, usage);
+}
+
+void DocumentSourceGroup::writePartitions(const vector<bool>& partitions,
+                                          const vector<size_t>& usage) {
+    if (_spilledPartitions.empty()) {
+        _spilledPartitions.assign(kNumSpillPartitions, false);
+    }
+
+    // Order the groups to write by partition. Within a partition they need not be sorted, since a
+    // spilled partition is merged in memory when it is read back.
+    vector<vector<const GroupsMap::value_type*>> ptrs(kNumSpillPartitions);
+    size_t numGroups = 0;
+    for (auto&& entry : *_groups) {
+        const size_t partition = getSpillPartition(entry.hash);
+        if (partitions[partition]) {
+            ptrs[partition].push_back(&entry);
+            numGroups++;
+        }
+    }
+
+    if (numGroups > 0) {
+        SpilledRun run;
+        SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
+        for (size_t p = 0; p < kNumSpillPartitions; p++) {
+            for (auto&& group : ptrs[p]) {
+                writer.addAlreadySorted(group->first, getMergeableState(group->second));
             }
-            break;
+            run.groupsPerPartition.push_back(ptrs[p].size());
+        }
+        run.iterator.reset(writer.done());
+        _spilledRuns.push_back(std::move(run));
+    }
 
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
+    for (size_t p = 0; p < kNumSpillPartitions; p++) {
+        if (partitions[p]) {
+            _spilledPartitions[p] = true;
+            _memoryUsageBytes -= usage[p];
+        }
+    }
+
+    _groups->eraseIf([&partitions](const GroupsMap::value_type& entry) {
+        return partitions[getSpillPartition(entry.hash)];
+    });
+}
+
+bool DocumentSourceGroup::loadNextSpilledPartition() {
+    if (_nextSpilledPartition >= _spilledPartitions.size()) {
+        return false;
+    }
+    const size_t partition = _nextSpilledPartition;
+    _nextSpilledPartition =
+        std::find(_spilledPartitions.begin() + partition + 1, _spilledPartitions.end(), true) -
+        _spilledPartitions.begin();
+
+    const size_t numAccumulators = vpAccumulatorFactory.size();
+    _groups->clear();
+    _memoryUsageBytes = 0;
+
+    // Each run holds the groups of this partition right after those of the partitions before it,
+    // which have already been read.
+    for (auto&& run : _spilledRuns) {
+        for (size_t i = 0; i < run.groupsPerPartition[partition]; i++) {
+            if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+                // This partition does not fit in memory by itself, so fall back to merging sorted
+                // runs of it.
+                _sortedFiles.push_back(spill());
+                _memoryUsageBytes = 0;
+            }
+
+            pair<Value, Value> spilledGroup = run.iterator->next();
+            auto insertResult = _groups->insert(spilledGroup.first);
+            Accumulators& group = insertResult.first->second;
+            if (insertResult.second) {
+                _memoryUsageBytes += spilledGroup.first.getApproximateSize();
+                group.reserve(numAccumulators);
+                for (size_t j = 0; j < numAccumulators; j++) {
+                    group.push_back(vpAccumulatorFactory[j]());
+                    group.back()->injectExpressionContext(pExpCtx);
+                }
+            } else {
+                for (auto&& accumulator : group) {
+                    _memoryUsageBytes -= accumulator->memUsageForSorter();
                 }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
             }
-            break;
+
+            mergeState(spilledGroup.second, group);
+            for (auto&& accumulator : group) {
+                _memoryUsageBytes += accumulator->memUsageForSorter();
+            }
+        }
     }
 
-    _groups->clear();
+    if (!_sortedFiles.empty()) {
+        if (!_groups->empty()) {
+            _sortedFiles.push_back(spill());
+        }
 
-    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+        _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
+            _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
+
+        // prepare current to accumulate data
+        if (_currentAccumulators.empty()) {
+            _currentAccumulators.reserve(numAccumulators);
+            for (size_t i = 0; i < numAccumulators; i++) {
+                _currentAccumulators.push_back(vpAccumulatorFactory[i]());
+                _currentAccumulators.back()->injectExpressionContext(pExpCtx);
+            }
+        }
+
+        verify(_sorterIterator->more());  // we put data in, we should get something out.
+        _firstPartOfNextGroup = _sorterIterator->next();
+    }
+
+    groupsIterator = _groups->begin();
+    return true;
 }
 
 boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
@@ -729,27 +1060,23 @@ BSONObjSet DocumentSourceGroup::getOutputSorts() {
                        // False negatives are OK.
     }
 
-    if (!(_streaming || _spilled)) {
+    // A spilled $group returns each spilled partition in turn, so its output is not sorted either.
+    if (!_streaming) {
         return SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     }
 
     BSONObjBuilder sortOrder;
 
     if (_idFieldNames.empty()) {
-        if (_spilled) {
-            sortOrder.append("_id", 1);
-        } else {
-            // We have an expression like {_id: "$a"}. Check if this is a FieldPath, and if it is,
-            // get the sort order out of it.
-            if (auto obj = dynamic_cast<ExpressionFieldPath*>(_idExpressions[0].get())) {
-                FieldPath _idSort = obj->getFieldPath();
-
-                sortOrder.append(
-                    "_id",
-                    _inputSort.getIntField(_idSort.getFieldName(_idSort.getPathLength() - 1)));
-            }
+        // We have an expression like {_id: "$a"}. Check if this is a FieldPath, and if it is,
+        // get the sort order out of it.
+        if (auto obj = dynamic_cast<ExpressionFieldPath*>(_idExpressions[0].get())) {
+            FieldPath _idSort = obj->getFieldPath();
+
+            sortOrder.append(
+                "_id", _inputSort.getIntField(_idSort.getFieldName(_idSort.getPathLength() - 1)));
         }
-    } else if (_streaming) {
+    } else {
         // At this point, we know that _streaming is true, so _id must have only contained
         // ExpressionObjects, ExpressionConstants or ExpressionFieldPaths. We now process each
         // '_idExpression'.
@@ -783,21 +1110,6 @@ BSONObjSet DocumentSourceGroup::getOutputSorts() {
 
             sortOrder.append(itr->second, _inputSort.getIntField(sortString));
         }
-    } else {
-        // We are blocking and have spilled to disk.
-        std::vector<std::string> outputSort;
-        for (size_t i = 0; i < _idFieldNames.size(); i++) {
-            intrusive_ptr<Expression> exp = _idExpressions[i];
-            if (auto obj = dynamic_cast<ExpressionObject*>(exp.get())) {
-                // _id is an object containing a nested document, such as: {_id: {x: {y: "$b"}}}.
-                getFieldPathListForSpilled(obj, "_id." + _idFieldNames[i], &outputSort);
-            } else {
-                outputSort.push_back("_id." + _idFieldNames[i]);
-            }
-        }
-        for (auto&& field : outputSort) {
-            sortOrder.append(field, 1);
-        }
     }
 
     return allPrefixes(sortOrder.obj());
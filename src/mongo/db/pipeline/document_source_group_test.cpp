@@ -30,6 +30,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
+#include <limits>
 #include <map>
 #include <string>
 #include <vector>
@@ -47,11 +48,13 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value_comparator.h"
 #include "mongo/db/query/query_test_service_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -191,6 +194,195 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), UserException, 16945);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldAccumulateCorrectlyAcrossManyBatchesAndPauses) {
+    auto expCtx = getExpCtx();
+    expCtx->inRouter = true;  // Disallow the debug build's spill on every duplicate id.
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    auto makeStatement = [&](const char* name, const char* op, const char* path) {
+        return AccumulationStatement{
+            name, AccumulationStatement::getFactory(op), ExpressionFieldPath::parse(path, vps)};
+    };
+    auto group = DocumentSourceGroup::create(expCtx,
+                                             ExpressionFieldPath::parse("$key", vps),
+                                             {makeStatement("sum", "$sum", "$val"),
+                                              makeStatement("bigSum", "$sum", "$big"),
+                                              makeStatement("avg", "$avg", "$val"),
+                                              makeStatement("min", "$min", "$val"),
+                                              makeStatement("max", "$max", "$val")},
+                                             idGen.getIdCount());
+
+    // Enough documents to fill several batches, spread unevenly over a handful of groups, with
+    // pauses in the middle of batches. Every $sum of 'big' overflows a long part of the way
+    // through before being brought back in range by the negative values.
+    const int kNumKeys = 7;
+    const int kNumDocs = 5000;
+    const long long kBig = std::numeric_limits<long long>::max() / 2;
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < kNumDocs; i++) {
+        if (i % 1500 == 700) {
+            inputs.push_back(DocumentSource::GetNextResult::makePauseExecution());
+        }
+        const long long big = (i / kNumKeys) % 4 < 2 ? kBig : -kBig;
+        inputs.push_back(Document{{"key", (i * i) % kNumKeys},
+                                  {"val", i % 3 == 0 ? Value(i) : Value(double(i))},
+                                  {"big", big}});
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    map<int, Document> results;
+    auto next = group->getNext();
+    for (; !next.isEOF(); next = group->getNext()) {
+        if (next.isAdvanced()) {
+            Document doc = next.releaseDocument();
+            results[doc["_id"].getInt()] = doc;
+        }
+    }
+    ASSERT_EQ(results.size(), 4UL);  // The squares modulo 7 are 0, 1, 2 and 4.
+
+    for (auto&& result : results) {
+        double sum = 0;
+        long long bigSum = 0;
+        int count = 0;
+        int minVal = kNumDocs;
+        int maxVal = -1;
+        for (int i = 0; i < kNumDocs; i++) {
+            if ((i * i) % kNumKeys != result.first) {
+                continue;
+            }
+            sum += i;
+            bigSum += (i / kNumKeys) % 4 < 2 ? 1 : -1;
+            count++;
+            minVal = std::min(minVal, i);
+            maxVal = std::max(maxVal, i);
+        }
+        const Document& doc = result.second;
+        ASSERT_VALUE_EQ(doc["sum"], Value(sum));
+        ASSERT_VALUE_EQ(doc["bigSum"], Value(static_cast<double>(bigSum) * kBig));
+        ASSERT_VALUE_EQ(doc["avg"], Value(sum / count));
+        ASSERT_VALUE_EQ(doc["min"], Value(minVal));
+        ASSERT_VALUE_EQ(doc["max"], Value(maxVal));
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldMergePartialResultsOnSeveralThreads) {
+    auto mergeThreadsParam =
+        ServerParameterSet::getGlobal()->getMap()["internalDocumentSourceGroupMergeThreads"];
+    ASSERT(mergeThreadsParam);
+    ASSERT_OK(mergeThreadsParam->setFromString("4"));
+    ON_BLOCK_EXIT([mergeThreadsParam] { invariantOK(mergeThreadsParam->setFromString("1")); });
+
+    auto expCtx = getExpCtx();
+    expCtx->inRouter = true;  // Disallow the debug build's spill on every duplicate id.
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    auto makeStatement = [&](const char* name, const char* op, const char* path) {
+        return AccumulationStatement{
+            name, AccumulationStatement::getFactory(op), ExpressionFieldPath::parse(path, vps)};
+    };
+    auto shardGroup = DocumentSourceGroup::create(expCtx,
+                                                  ExpressionFieldPath::parse("$key", vps),
+                                                  {makeStatement("sum", "$sum", "$val"),
+                                                   makeStatement("vals", "$push", "$val")},
+                                                  idGen.getIdCount());
+    auto mergeSource = shardGroup->getMergeSource();
+    auto mergeGroup = static_cast<DocumentSourceGroup*>(mergeSource.get());
+
+    // Partial results from several shards for enough distinct groups that every batch is split
+    // across all of the merge threads.
+    const int kNumKeys = 3000;
+    const int kNumShards = 4;
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int shard = 0; shard < kNumShards; shard++) {
+        for (int key = 0; key < kNumKeys; key++) {
+            inputs.push_back(Document{{"_id", key},
+                                      {"sum", key * kNumShards + shard},
+                                      {"vals", vector<Value>{Value(shard)}}});
+        }
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    mergeGroup->setSource(mock.get());
+
+    map<int, Document> results;
+    for (auto next = mergeGroup->getNext(); next.isAdvanced(); next = mergeGroup->getNext()) {
+        Document doc = next.releaseDocument();
+        results[doc["_id"].getInt()] = doc;
+    }
+    ASSERT_EQ(results.size(), static_cast<size_t>(kNumKeys));
+
+    for (auto&& result : results) {
+        const int key = result.first;
+        const Document& doc = result.second;
+        int expectedSum = 0;
+        for (int shard = 0; shard < kNumShards; shard++) {
+            expectedSum += key * kNumShards + shard;
+        }
+        ASSERT_VALUE_EQ(doc["sum"], Value(expectedSum));
+        ASSERT_VALUE_EQ(doc["vals"],
+                        Value(vector<Value>{Value(0), Value(1), Value(2), Value(3)}));
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnEveryGroupOnceAfterSpillingPartitions) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->extSortAllowed = true;
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    auto makeStatement = [&](const char* name, const char* op, const char* path) {
+        return AccumulationStatement{
+            name, AccumulationStatement::getFactory(op), ExpressionFieldPath::parse(path, vps)};
+    };
+
+    // Every key appears several times, spread out over the input so that its partial results are
+    // written to more than one run. The larger limit holds some partitions in memory throughout
+    // and lets each spilled partition be merged in memory. With the smaller one, a single
+    // partition does not fit either and has to be sorted.
+    const int kNumKeys = 400;
+    const int kNumRounds = 3;
+    const string padding(100, 'x');
+    for (size_t maxMemoryUsageBytes : {size_t(100 * 1000), size_t(8 * 1000)}) {
+        auto group = DocumentSourceGroup::create(expCtx,
+                                                 ExpressionFieldPath::parse("$key", vps),
+                                                 {makeStatement("sum", "$sum", "$val"),
+                                                  makeStatement("pads", "$push", "$pad")},
+                                                 idGen.getIdCount(),
+                                                 maxMemoryUsageBytes);
+
+        std::deque<DocumentSource::GetNextResult> inputs;
+        for (int round = 0; round < kNumRounds; round++) {
+            for (int key = 0; key < kNumKeys; key++) {
+                inputs.push_back(
+                    Document{{"key", key}, {"val", key * kNumRounds + round}, {"pad", padding}});
+            }
+        }
+        auto mock = DocumentSourceMock::create(inputs);
+        group->setSource(mock.get());
+
+        map<int, Document> results;
+        for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+            Document doc = next.releaseDocument();
+            ASSERT_EQ(results.count(doc["_id"].getInt()), 0UL);
+            results[doc["_id"].getInt()] = doc;
+        }
+        ASSERT_TRUE(group->getNext().isEOF());
+        ASSERT_EQ(results.size(), static_cast<size_t>(kNumKeys));
+
+        for (auto&& result : results) {
+            const int key = result.first;
+            const Document& doc = result.second;
+            const int expectedSum =
+                key * kNumRounds * kNumRounds + kNumRounds * (kNumRounds - 1) / 2;
+            ASSERT_VALUE_EQ(doc["sum"], Value(expectedSum));
+            ASSERT_VALUE_EQ(doc["pads"],
+                            Value(vector<Value>(kNumRounds, Value(StringData(padding)))));
+        }
+    }
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -31,12 +31,16 @@
 #include "document_source.h"
 
 #include "mongo/base/init.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -44,6 +48,8 @@ namespace mongo {
 using boost::intrusive_ptr;
 using std::vector;
 
+namespace dps = ::mongo::dotted_path_support;
+
 DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
                                            std::string as,
                                            std::string localField,
@@ -64,6 +70,16 @@ const char* DocumentSourceLookUp::getSourceName() const {
 
 namespace {
 
+// The number of input documents whose foreign documents are looked up with a single query. A value
+// of 1 runs a separate query for every input document.
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupBatchSize, int, 100);
+
+// Limits on the approximate size of the local values that make up a batch's foreign query, and on
+// the foreign documents buffered for a batch. A batch whose query would exceed BSONObjMaxUserSize
+// or whose foreign documents exceed the second limit is joined one input document at a time.
+const int kMaxBatchLocalValueBytes = BSONObjMaxUserSize / 2;
+const int kMaxBatchForeignBytes = BSONObjMaxInternalSize;
+
 /**
  * Constructs a query of the following shape:
  *  {$or: [
@@ -83,6 +99,25 @@ BSONObj buildEqualityOrQuery(const std::string& fieldName, const vector<Value>&
     return orBuilder.obj();
 }
 
+/**
+ * Returns true if documents joining with 'localValue' can be found by hashing the values of their
+ * foreign field, that is, if an equality match on 'localValue' only ever matches values which
+ * compare equal to it. Null matches missing fields, regular expressions are compared by pattern
+ * and nested arrays are matched as a whole, so inputs with such values are instead checked against
+ * every foreign document of the batch.
+ */
+bool canLookUpByHash(const Value& localValue) {
+    switch (localValue.getType()) {
+        case jstNULL:
+        case Undefined:
+        case RegEx:
+        case Array:
+            return false;
+        default:
+            return true;
+    }
+}
+
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
@@ -102,16 +137,79 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
         return unwindResult();
     }
 
-    auto nextInput = pSource->getNext();
-    if (!nextInput.isAdvanced()) {
-        return nextInput;
-    }
-    auto inputDoc = nextInput.releaseDocument();
-
     // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
     // '_handlingUnwind' would be set to true, and we would not have made it here.
     invariant(!_matchSrc);
 
+    if (!_batchedOutput.empty()) {
+        auto output = std::move(_batchedOutput.front());
+        _batchedOutput.pop_front();
+        return std::move(output);
+    }
+
+    if (!_unbatchedInputs.empty()) {
+        auto input = std::move(_unbatchedInputs.front());
+        _unbatchedInputs.pop_front();
+        return performLookup(std::move(input));
+    }
+
+    if (_pendingInputResult && !_pendingInputResult->isAdvanced()) {
+        auto pendingResult = std::move(*_pendingInputResult);
+        _pendingInputResult = boost::none;
+        return pendingResult;
+    }
+
+    const size_t batchSize = std::max(internalDocumentSourceLookupBatchSize.load(), 1);
+    std::vector<Document> inputs;
+    int localValueBytes = 0;
+    while (inputs.size() < batchSize) {
+        GetNextResult nextInput = GetNextResult::makeEOF();
+        if (_pendingInputResult) {
+            // An input left over from the previous batch.
+            nextInput = std::move(*_pendingInputResult);
+            _pendingInputResult = boost::none;
+        } else {
+            nextInput = pSource->getNext();
+        }
+
+        if (!nextInput.isAdvanced()) {
+            if (inputs.empty()) {
+                return nextInput;
+            }
+            // Join the documents we already have before passing on the pause or EOF.
+            _pendingInputResult = std::move(nextInput);
+            break;
+        }
+
+        const int bytes = static_cast<int>(
+            nextInput.getDocument().getNestedField(_localField).getApproximateSize());
+        if (!inputs.empty() && localValueBytes + bytes > kMaxBatchLocalValueBytes) {
+            // Start the next batch with this input.
+            _pendingInputResult = std::move(nextInput);
+            break;
+        }
+        localValueBytes += bytes;
+        inputs.push_back(nextInput.releaseDocument());
+    }
+
+    if (inputs.size() == 1) {
+        return performLookup(std::move(inputs.front()));
+    }
+
+    performBatchedLookup(std::move(inputs));
+    if (!_batchedOutput.empty()) {
+        auto output = std::move(_batchedOutput.front());
+        _batchedOutput.pop_front();
+        return std::move(output);
+    }
+
+    invariant(!_unbatchedInputs.empty());
+    auto input = std::move(_unbatchedInputs.front());
+    _unbatchedInputs.pop_front();
+    return performLookup(std::move(input));
+}
+
+Document DocumentSourceLookUp::performLookup(Document inputDoc) {
     auto matchStage =
         makeMatchStageFromInput(inputDoc, _localField, _foreignFieldFieldName, BSONObj());
     // We've already allocated space for the trailing $match stage in '_fromPipeline'.
@@ -135,6 +233,177 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     return output.freeze();
 }
 
+void DocumentSourceLookUp::performBatchedLookup(std::vector<Document> inputs) {
+    // Inputs with the same local value share a join predicate, so we only query and match for
+    // each distinct predicate once.
+    struct JoinPredicate {
+        BSONObj matchStage;
+        std::unique_ptr<MatchExpression> matcher;
+        std::vector<Value> results;
+        int objsize = 0;
+    };
+    std::vector<JoinPredicate> predicates;
+    std::vector<size_t> predicateForInput;
+    predicateForInput.reserve(inputs.size());
+    auto predicateIndexes = SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<size_t>();
+
+    // Foreign values which can be looked up by hash, mapped to the predicates they satisfy. The
+    // remaining predicates are checked against every foreign document.
+    auto predicatesByValue = _fromExpCtx->getValueComparator().makeUnorderedValueMap<
+        std::vector<size_t>>();
+    std::vector<size_t> unhashedPredicates;
+
+    // The foreign query is a single $in over the local values of all predicates that an $in can
+    // express, so that it is planned and executed as one index scan. Only predicates on regular
+    // expressions, which $in would use for pattern matching, or on undefined, which $in rejects,
+    // are added as further $or branches.
+    std::vector<Value> inValues;
+    auto seenInValues = ValueComparator::kInstance.makeUnorderedValueSet();
+    BSONArrayBuilder orPredicates;
+    for (auto&& input : inputs) {
+        auto matchStage =
+            makeMatchStageFromInput(input, _localField, _foreignFieldFieldName, BSONObj());
+        auto query = matchStage.firstElement().Obj();
+
+        auto inserted = predicateIndexes.emplace(query, predicates.size());
+        predicateForInput.push_back(inserted.first->second);
+        if (!inserted.second) {
+            continue;
+        }
+
+        const size_t predicateIndex = predicates.size();
+        JoinPredicate predicate;
+        predicate.matchStage = matchStage;
+        predicate.matcher = uassertStatusOK(MatchExpressionParser::parse(
+            query, ExtensionsCallbackNoop(), _fromExpCtx->getCollator()));
+        predicates.push_back(std::move(predicate));
+
+        Value localValue = input.getNestedField(_localField);
+        std::vector<Value> localValues;
+        if (localValue.isArray()) {
+            localValues = localValue.getArray();
+        } else {
+            localValues.push_back(localValue.missing() ? Value(BSONNULL) : localValue);
+        }
+
+        const bool needsOrBranch =
+            std::any_of(localValues.begin(), localValues.end(), [](const Value& value) {
+                return value.getType() == RegEx || value.getType() == Undefined;
+            });
+        if (needsOrBranch) {
+            orPredicates.append(query);
+        } else {
+            for (auto&& value : localValues) {
+                if (seenInValues.insert(value).second) {
+                    inValues.push_back(value);
+                }
+            }
+        }
+
+        const bool hashable = std::all_of(localValues.begin(), localValues.end(), canLookUpByHash);
+        if (!hashable || localValues.empty()) {
+            unhashedPredicates.push_back(predicateIndex);
+            continue;
+        }
+        for (auto&& value : localValues) {
+            auto& indexes = predicatesByValue[value];
+            if (indexes.empty() || indexes.back() != predicateIndex) {
+                indexes.push_back(predicateIndex);
+            }
+        }
+    }
+
+    BSONObj orArray = orPredicates.arr();
+    BSONObjBuilder matchBuilder;
+    {
+        BSONObjBuilder query(matchBuilder.subobjStart("$match"));
+        const bool hasInValues = !inValues.empty();
+        BSONObj inQuery = BSON(_foreignFieldFieldName << BSON("$in" << Value(std::move(inValues))));
+        if (orArray.isEmpty()) {
+            query.appendElements(inQuery);
+        } else {
+            BSONArrayBuilder orBuilder(query.subarrayStart("$or"));
+            if (hasInValues) {
+                orBuilder.append(inQuery);
+            }
+            for (auto&& branch : orArray) {
+                orBuilder.append(branch);
+            }
+        }
+    }
+    BSONObj matchStage = matchBuilder.obj();
+
+    if (matchStage.objsize() > BSONObjMaxUserSize) {
+        _unbatchedInputs.insert(_unbatchedInputs.end(),
+                                std::make_move_iterator(inputs.begin()),
+                                std::make_move_iterator(inputs.end()));
+        return;
+    }
+
+    // We've already allocated space for the trailing $match stage in '_fromPipeline'.
+    _fromPipeline.back() = matchStage;
+    auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+
+    std::vector<size_t> candidates;
+    std::vector<bool> isCandidate(predicates.size(), false);
+    int foreignBytes = 0;
+    while (auto result = pipeline->getNext()) {
+        const BSONObj foreignObj = result->toBson();
+
+        candidates = unhashedPredicates;
+        BSONElementSet foreignValues;
+        dps::extractAllElementsAlongPath(foreignObj, _foreignFieldFieldName, foreignValues);
+        for (auto&& elem : foreignValues) {
+            auto it = predicatesByValue.find(Value(elem));
+            if (it == predicatesByValue.end()) {
+                continue;
+            }
+            for (auto predicateIndex : it->second) {
+                if (!isCandidate[predicateIndex]) {
+                    isCandidate[predicateIndex] = true;
+                    candidates.push_back(predicateIndex);
+                }
+            }
+        }
+
+        bool matchedAny = false;
+        for (auto predicateIndex : candidates) {
+            isCandidate[predicateIndex] = false;
+            auto& predicate = predicates[predicateIndex];
+            if (!predicate.matcher->matchesBSON(foreignObj)) {
+                continue;
+            }
+            matchedAny = true;
+            predicate.objsize += result->getApproximateSize();
+            uassert(4568,
+                    str::stream() << "Total size of documents in " << _fromNs.coll()
+                                  << " matching "
+                                  << predicate.matchStage
+                                  << " exceeds maximum document size",
+                    predicate.objsize <= BSONObjMaxInternalSize);
+            predicate.results.push_back(Value(*result));
+        }
+
+        if (matchedAny) {
+            foreignBytes += static_cast<int>(result->getApproximateSize());
+            if (foreignBytes > kMaxBatchForeignBytes) {
+                // Too much to buffer for the whole batch, so join the inputs one at a time, which
+                // only holds the foreign documents of a single input.
+                _unbatchedInputs.insert(_unbatchedInputs.end(),
+                                        std::make_move_iterator(inputs.begin()),
+                                        std::make_move_iterator(inputs.end()));
+                return;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        MutableDocument output(std::move(inputs[i]));
+        output.setNestedField(_as, Value(predicates[predicateForInput[i]].results));
+        _batchedOutput.push_back(output.freeze());
+    }
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceLookUp::optimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -269,6 +538,9 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::optimizeAt(
 
 void DocumentSourceLookUp::dispose() {
     _pipeline.reset();
+    _batchedOutput.clear();
+    _unbatchedInputs.clear();
+    _pendingInputResult = boost::none;
     pSource->dispose();
 }
 
@@ -157,11 +157,20 @@ public:
         pipeline.getValue()->injectExpressionContext(expCtx);
         pipeline.getValue()->optimizePipeline();
 
+        _rawPipelines.push_back(rawPipeline);
         return pipeline;
     }
 
+    /**
+     * Returns the raw pipelines that makePipeline() has been called with, in order.
+     */
+    const vector<vector<BSONObj>>& getRawPipelines() const {
+        return _rawPipelines;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
+    vector<vector<BSONObj>> _rawPipelines;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -269,5 +278,195 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     ASSERT_TRUE(lookup->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldJoinBatchOfInputsWithSingleForeignQuery) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->resolvedNamespaces[fromNs.coll()] = {fromNs, std::vector<BSONObj>{}};
+
+    // Set up the $lookup stage.
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "x"},
+                                         {"foreignField", "a"},
+                                         {"as", "foreignDocs"}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    // Mock its input without any pauses, so that all of the documents are joined as one batch.
+    auto mockLocalSource = DocumentSourceMock::create({Document{{"x", 1}},
+                                                       Document{{"x", 2}},
+                                                       Document{{"x", 1}},
+                                                       Document{{"y", 0}},
+                                                       Document{{"x", vector<Value>{Value(2),
+                                                                                   Value(3)}}}});
+    lookup->setSource(mockLocalSource.get());
+    lookup->injectExpressionContext(expCtx);
+
+    // Mock out the foreign collection.
+    const Document foreign0{{"_id", 0}, {"a", 1}};
+    const Document foreign1{{"_id", 1}, {"a", vector<Value>{Value(1), Value(2)}}};
+    const Document foreign2{{"_id", 2}};
+    const Document foreign3{{"_id", 3}, {"a", BSONNULL}};
+    const Document foreign4{{"_id", 4}, {"a", 2}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document(foreign0),
+                                                             Document(foreign1),
+                                                             Document(foreign2),
+                                                             Document(foreign3),
+                                                             Document(foreign4)};
+    lookup->injectMongodInterface(
+        std::make_shared<MockMongodInterface>(std::move(mockForeignContents)));
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"x", 1}, {"foreignDocs", vector<Value>{Value(foreign0), Value(foreign1)}}}));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"x", 2}, {"foreignDocs", vector<Value>{Value(foreign1), Value(foreign4)}}}));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"x", 1}, {"foreignDocs", vector<Value>{Value(foreign0), Value(foreign1)}}}));
+
+    // A missing local field joins with foreign documents where the field is null or missing.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"y", 0}, {"foreignDocs", vector<Value>{Value(foreign2), Value(foreign3)}}}));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"x", vector<Value>{Value(2), Value(3)}},
+                  {"foreignDocs", vector<Value>{Value(foreign1), Value(foreign4)}}}));
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldQueryBatchOfScalarAndArrayValuesWithSingleIn) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->resolvedNamespaces[fromNs.coll()] = {fromNs, std::vector<BSONObj>{}};
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "x"},
+                                         {"foreignField", "a"},
+                                         {"as", "foreignDocs"}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource =
+        DocumentSourceMock::create({Document{{"x", 1}},
+                                    Document{{"x", 2}},
+                                    Document{{"x", vector<Value>{Value(2), Value(3)}}}});
+    lookup->setSource(mockLocalSource.get());
+    lookup->injectExpressionContext(expCtx);
+
+    auto mongod = std::make_shared<MockMongodInterface>(deque<DocumentSource::GetNextResult>{});
+    lookup->injectMongodInterface(mongod);
+
+    ASSERT_TRUE(lookup->getNext().isAdvanced());
+    ASSERT_EQUALS(mongod->getRawPipelines().size(), 1U);
+    ASSERT_BSONOBJ_EQ(mongod->getRawPipelines()[0].back(),
+                      BSON("$match" << BSON("a" << BSON("$in" << BSON_ARRAY(1 << 2 << 3)))));
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldQueryRegexValuesOfBatchWithSeparateOrBranches) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->resolvedNamespaces[fromNs.coll()] = {fromNs, std::vector<BSONObj>{}};
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "x"},
+                                         {"foreignField", "a"},
+                                         {"as", "foreignDocs"}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::create(
+        {Document{{"x", 1}}, Document(BSON("x" << BSONRegEx("^ab")))});
+    lookup->setSource(mockLocalSource.get());
+    lookup->injectExpressionContext(expCtx);
+
+    // A regex local value only joins with an equal regex, not with strings matching it.
+    const Document foreign0{{"_id", 0}, {"a", "abc"_sd}};
+    const Document foreign1(BSON("_id" << 1 << "a" << BSONRegEx("^ab")));
+    auto mongod = std::make_shared<MockMongodInterface>(
+        deque<DocumentSource::GetNextResult>{Document(foreign0), Document(foreign1)});
+    lookup->injectMongodInterface(mongod);
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"x", 1}, {"foreignDocs", vector<Value>{}}}));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["foreignDocs"], Value(vector<Value>{Value(foreign1)}));
+
+    ASSERT_EQUALS(mongod->getRawPipelines().size(), 1U);
+    BSONObj match = mongod->getRawPipelines()[0].back()["$match"].Obj();
+    vector<BSONElement> orBranches = match["$or"].Array();
+    ASSERT_EQUALS(orBranches.size(), 2U);
+    ASSERT_BSONOBJ_EQ(orBranches[0].Obj(), BSON("a" << BSON("$in" << BSON_ARRAY(1))));
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldJoinInputsOneAtATimeIfBatchBuffersTooMuch) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->resolvedNamespaces[fromNs.coll()] = {fromNs, std::vector<BSONObj>{}};
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "x"},
+                                         {"foreignField", "a"},
+                                         {"as", "foreignDocs"}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource =
+        DocumentSourceMock::create({Document{{"x", 1}}, Document{{"x", 2}}, Document{{"x", 3}}});
+    lookup->setSource(mockLocalSource.get());
+    lookup->injectExpressionContext(expCtx);
+
+    // Each foreign document fits in a single output, but together they are more than a batch may
+    // buffer.
+    const std::string padding(BSONObjMaxInternalSize / 3 + 1, 'x');
+    deque<DocumentSource::GetNextResult> mockForeignContents;
+    for (int i = 1; i <= 3; ++i) {
+        mockForeignContents.push_back(Document{{"a", i}, {"padding", padding}});
+    }
+    auto mongod = std::make_shared<MockMongodInterface>(std::move(mockForeignContents));
+    lookup->injectMongodInterface(mongod);
+
+    for (int i = 1; i <= 3; ++i) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_VALUE_EQ(next.getDocument()["x"], Value(i));
+        vector<Value> foreignDocs = next.getDocument()["foreignDocs"].getArray();
+        ASSERT_EQUALS(foreignDocs.size(), 1U);
+        ASSERT_VALUE_EQ(foreignDocs[0]["a"], Value(i));
+    }
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    // The batched query was abandoned and each input was joined with a query of its own.
+    ASSERT_EQUALS(mongod->getRawPipelines().size(), 4U);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/server_parameters.h"
 
 namespace mongo {
 
@@ -45,6 +46,13 @@ using std::make_pair;
 using std::string;
 using std::vector;
 
+namespace {
+
+// Threads a $sort uses to sort the documents it buffers and to merge the runs it spills.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalDocumentSourceSortThreads, int, 1);
+
+}  // namespace
+
 DocumentSourceSort::DocumentSourceSort(const intrusive_ptr<ExpressionContext>& pExpCtx)
     : DocumentSource(pExpCtx), _mergingPresorted(false) {}
 
@@ -239,6 +247,7 @@ SortOptions DocumentSourceSort::makeSortOptions() const {
         opts.limit = limitSrc->getLimit();
 
     opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
+    opts.numThreads = std::max(1, internalDocumentSourceSortThreads);
     if (pExpCtx->extSortAllowed && !pExpCtx->inRouter) {
         opts.extSortAllowed = true;
         opts.tempDir = pExpCtx->tempDir;
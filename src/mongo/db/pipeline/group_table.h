@@ -0,0 +1,210 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * An insert-only hash table from Value to T, used to hold the groups of a $group stage.
+ *
+ * The entries live in a deque in insertion order, next to the precomputed hash of their key, so
+ * pointers to them stay valid while the table grows. Lookups linearly probe a separate
+ * power-of-two sized array of small (hash, entry index) slots, and only compare the keys of
+ * entries whose full hash matches. Equality and hashing follow the ValueComparator the table was
+ * built with.
+ */
+template <typename T>
+class GroupTable {
+public:
+    struct Entry {
+        Entry(Value key, size_t keyHash) : first(std::move(key)), second(), hash(keyHash) {}
+
+        Value first;
+        T second;
+        size_t hash;
+    };
+
+    using value_type = Entry;
+    using iterator = typename std::deque<Entry>::iterator;
+    using const_iterator = typename std::deque<Entry>::const_iterator;
+
+    explicit GroupTable(const ValueComparator& comparator) : _comparator(comparator) {}
+
+    /**
+     * Returns the entry for 'key' and false if there is one, or else adds an entry with a
+     * default-constructed T and returns it and true.
+     */
+    std::pair<Entry*, bool> insert(Value key) {
+        const size_t keyHash = _comparator.hash(key);
+        if ((_entries.size() + 1) * kMaxLoadDenominator > _slots.size() * kMaxLoadNumerator) {
+            rehash(_slots.empty() ? kMinSlots : _slots.size() * 2);
+        }
+
+        size_t slot = findSlot(key, keyHash);
+        if (_slots[slot].index != kEmptySlot) {
+            return {&_entries[_slots[slot].index], false};
+        }
+
+        _slots[slot] = Slot{keyHash, _entries.size()};
+        _entries.emplace_back(std::move(key), keyHash);
+        return {&_entries.back(), true};
+    }
+
+    /**
+     * Returns the entry for 'key', or nullptr if there is none.
+     */
+    Entry* find(const Value& key) {
+        if (_entries.empty()) {
+            return nullptr;
+        }
+        size_t slot = findSlot(key, _comparator.hash(key));
+        return _slots[slot].index == kEmptySlot ? nullptr : &_entries[_slots[slot].index];
+    }
+
+    /**
+     * Removes every entry for which 'pred' returns true. The remaining entries keep their relative
+     * order, but pointers and iterators to all entries are invalidated.
+     */
+    template <typename Predicate>
+    void eraseIf(Predicate pred) {
+        if (_entries.empty()) {
+            return;
+        }
+
+        std::deque<Entry> kept;
+        for (auto&& entry : _entries) {
+            if (!pred(entry)) {
+                kept.push_back(std::move(entry));
+            }
+        }
+        _entries.swap(kept);
+        rehash(_slots.size());
+    }
+
+    void clear() {
+        _entries.clear();
+        _slots.clear();
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    iterator begin() {
+        return _entries.begin();
+    }
+
+    iterator end() {
+        return _entries.end();
+    }
+
+    const_iterator begin() const {
+        return _entries.begin();
+    }
+
+    const_iterator end() const {
+        return _entries.end();
+    }
+
+private:
+    struct Slot {
+        size_t hash;
+        size_t index;
+    };
+
+    static const size_t kEmptySlot = static_cast<size_t>(-1);
+    static const size_t kMinSlots = 16;
+    static const size_t kMaxLoadNumerator = 3;
+    static const size_t kMaxLoadDenominator = 4;
+
+    /**
+     * Maps a hash to its home slot. The hash is scrambled with a multiplicative (Fibonacci) hash
+     * and the top bits are used, since Value hashes of small integers differ mostly in their low
+     * bits.
+     */
+    size_t homeSlot(size_t keyHash) const {
+        return static_cast<size_t>((static_cast<uint64_t>(keyHash) * 0x9E3779B97F4A7C15ULL) >>
+                                   _shift);
+    }
+
+    /**
+     * Returns the slot holding 'key', or the empty slot where it would be inserted.
+     */
+    size_t findSlot(const Value& key, size_t keyHash) const {
+        const size_t mask = _slots.size() - 1;
+        for (size_t slot = homeSlot(keyHash);; slot = (slot + 1) & mask) {
+            const Slot& candidate = _slots[slot];
+            if (candidate.index == kEmptySlot ||
+                (candidate.hash == keyHash &&
+                 _comparator.evaluate(_entries[candidate.index].first == key))) {
+                return slot;
+            }
+        }
+    }
+
+    void rehash(size_t numSlots) {
+        invariant(numSlots >= kMinSlots && (numSlots & (numSlots - 1)) == 0);
+        _slots.assign(numSlots, Slot{0, kEmptySlot});
+        _shift = 64;
+        for (size_t n = numSlots; n > 1; n >>= 1) {
+            _shift--;
+        }
+
+        const size_t mask = numSlots - 1;
+        for (size_t index = 0; index < _entries.size(); index++) {
+            size_t slot = homeSlot(_entries[index].hash);
+            while (_slots[slot].index != kEmptySlot) {
+                slot = (slot + 1) & mask;
+            }
+            _slots[slot] = Slot{_entries[index].hash, index};
+        }
+    }
+
+    ValueComparator _comparator;
+    std::deque<Entry> _entries;
+    std::vector<Slot> _slots;
+    int _shift = 64;
+};
+
+}  // namespace mongo
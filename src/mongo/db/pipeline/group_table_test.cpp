@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/group_table.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(GroupTableTest, InsertReturnsExistingEntryForEqualKey) {
+    GroupTable<int> table(ValueComparator(nullptr));
+    auto first = table.insert(Value(1));
+    ASSERT_TRUE(first.second);
+    first.first->second = 10;
+
+    auto second = table.insert(Value(1.0));
+    ASSERT_FALSE(second.second);
+    ASSERT_EQ(second.first, first.first);
+    ASSERT_EQ(second.first->second, 10);
+    ASSERT_EQ(table.size(), 1UL);
+}
+
+TEST(GroupTableTest, EntriesKeepTheirAddressesAndOrderWhileTheTableGrows) {
+    GroupTable<int> table(ValueComparator(nullptr));
+    std::vector<GroupTable<int>::value_type*> entries;
+    for (int i = 0; i < 1000; i++) {
+        auto result = table.insert(Value(i));
+        ASSERT_TRUE(result.second);
+        result.first->second = i;
+        entries.push_back(result.first);
+    }
+
+    int expected = 0;
+    for (auto&& entry : table) {
+        ASSERT_VALUE_EQ(entry.first, Value(expected));
+        ASSERT_EQ(&entry, entries[expected]);
+        expected++;
+    }
+    ASSERT_EQ(expected, 1000);
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(table.find(Value(i)), entries[i]);
+    }
+    ASSERT_FALSE(table.find(Value(1000)));
+}
+
+TEST(GroupTableTest, FollowsTheEquivalenceOfTheComparator) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    ValueComparator comparator(&collator);
+    GroupTable<int> table(comparator);
+    ASSERT_TRUE(table.insert(Value(StringData("foo"))).second);
+    ASSERT_FALSE(table.insert(Value(StringData("bar"))).second);
+    ASSERT_TRUE(table.find(Value(StringData("baz"))));
+    ASSERT_EQ(table.size(), 1UL);
+}
+
+TEST(GroupTableTest, EraseIfKeepsTheOrderOfRemainingEntries) {
+    GroupTable<int> table(ValueComparator(nullptr));
+    for (int i = 0; i < 100; i++) {
+        table.insert(Value(i));
+    }
+
+    table.eraseIf([](const GroupTable<int>::value_type& entry) {
+        return entry.first.getInt() % 3 != 0;
+    });
+    ASSERT_EQ(table.size(), 34UL);
+
+    int expected = 0;
+    for (auto&& entry : table) {
+        ASSERT_VALUE_EQ(entry.first, Value(expected));
+        expected += 3;
+    }
+    ASSERT_FALSE(table.find(Value(1)));
+    ASSERT_TRUE(table.find(Value(99)));
+
+    // Entries can still be added after erasing.
+    ASSERT_TRUE(table.insert(Value(1)).second);
+    ASSERT_FALSE(table.insert(Value(99)).second);
+    ASSERT_EQ(table.size(), 35UL);
+}
+
+}  // namespace
+}  // namespace mongo
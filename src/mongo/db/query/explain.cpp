@@ -391,6 +391,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         bob->append("indexVersion", spec->indexVersion);
 
         if (verbosity >= ExplainCommon::EXEC_STATS) {
+            if (STAGE_GEO_NEAR_2DSPHERE == stats.stageType) {
+                bob->appendBool("densityFromCache", spec->densityFromCache);
+            }
+
             BSONArrayBuilder intervalsBob(bob->subarrayStart("searchIntervals"));
             for (vector<IntervalStats>::const_iterator it = spec->intervalStats.begin();
                  it != spec->intervalStats.end();
@@ -505,8 +509,15 @@ void Explain::statsToBSON(const PlanStageStats& stats,
     } else if (STAGE_TEXT_OR == stats.stageType) {
         TextOrStats* spec = static_cast<TextOrStats*>(stats.specific.get());
 
+        if (spec->topK) {
+            bob->appendNumber("topK", spec->topK);
+        }
+
         if (verbosity >= ExplainCommon::EXEC_STATS) {
             bob->appendNumber("docsExamined", spec->fetches);
+            if (spec->topK) {
+                bob->appendBool("terminatedEarly", spec->terminatedEarly);
+            }
         }
     } else if (STAGE_UPDATE == stats.stageType) {
         UpdateStats* spec = static_cast<UpdateStats*>(stats.specific.get());
@@ -41,4 +41,6 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryS2GeoFinestLevel, int, 23);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryS2GeoCoarsestLevel, int, 0);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryS2GeoMaxCells, int, 20);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalGeoNearQueryAdaptiveSearch, bool, true);
+
 }  // namespace mongo
@@ -59,4 +59,8 @@ extern std::atomic<int> internalQueryS2GeoCoarsestLevel;  // NOLINT
 // What is the maximum cell count that we want? (advisory, not a hard threshold)
 extern std::atomic<int> internalQueryS2GeoMaxCells;  // NOLINT
 
+// Should geoNear on a 2dsphere index size its annuli from the density of the documents it finds,
+// and learn those densities across queries?
+extern std::atomic<bool> internalGeoNearQueryAdaptiveSearch;  // NOLINT
+
 }  // namespace mongo
@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/geo_near_density_cache.h"
+
+#include <cmath>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+boost::optional<double> GeoNearDensityCache::getDensity(StringData indexName,
+                                                        uint64_t cellId) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto indexIt = _densities.find(indexName);
+    if (indexIt == _densities.end()) {
+        return boost::none;
+    }
+
+    auto cellIt = indexIt->second.find(cellId);
+    if (cellIt == indexIt->second.end()) {
+        return boost::none;
+    }
+    return cellIt->second;
+}
+
+void GeoNearDensityCache::recordDensity(StringData indexName, uint64_t cellId, double density) {
+    invariant(density > 0);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto& cells = _densities[indexName];
+    auto cellIt = cells.find(cellId);
+    if (cellIt != cells.end()) {
+        // Densities span many orders of magnitude, so average them geometrically.
+        cellIt->second = std::sqrt(cellIt->second * density);
+        return;
+    }
+
+    if (cells.size() >= kMaxCellsPerIndex) {
+        cells.clear();
+    }
+    cells.emplace(cellId, density);
+}
+
+void GeoNearDensityCache::clear() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _densities.clear();
+}
+
+}  // namespace mongo
@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstdint>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Learns the density of the documents of each geo index of a collection, as seen by the geo near
+ * searches over it. Densities are kept per S2 cell, forming a histogram over the surface of the
+ * earth, so that a search near a point can size its first annulus from what earlier searches near
+ * that point found rather than by probing the index.
+ *
+ * Densities are in documents per square meter. This class is thread-safe.
+ */
+class GeoNearDensityCache {
+    MONGO_DISALLOW_COPYING(GeoNearDensityCache);
+
+public:
+    // The number of cells remembered for each index. The cells of an index are forgotten all at
+    // once when there are more.
+    static const size_t kMaxCellsPerIndex = 4096;
+
+    GeoNearDensityCache() = default;
+
+    /**
+     * Returns the density learned for the index named 'indexName' in the cell 'cellId', if any.
+     */
+    boost::optional<double> getDensity(StringData indexName, uint64_t cellId) const;
+
+    /**
+     * Records that a search in the cell 'cellId' of the index named 'indexName' found documents at
+     * the given density, which must be positive. It is averaged, geometrically, with the density
+     * already learned for the cell.
+     */
+    void recordDensity(StringData indexName, uint64_t cellId, double density);
+
+    /**
+     * Forgets everything learned.
+     */
+    void clear();
+
+private:
+    mutable stdx::mutex _mutex;
+    StringMap<stdx::unordered_map<uint64_t, double>> _densities;
+};
+
+}  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for mongo/db/query/geo_near_density_cache.h
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/geo_near_density_cache.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(GeoNearDensityCacheTest, ReturnsNothingForUnknownCells) {
+    GeoNearDensityCache cache;
+    ASSERT_FALSE(cache.getDensity("loc_2dsphere", 1));
+
+    cache.recordDensity("loc_2dsphere", 1, 0.5);
+    ASSERT_FALSE(cache.getDensity("loc_2dsphere", 2));
+    ASSERT_FALSE(cache.getDensity("other_2dsphere", 1));
+}
+
+TEST(GeoNearDensityCacheTest, AveragesDensitiesGeometrically) {
+    GeoNearDensityCache cache;
+    cache.recordDensity("loc_2dsphere", 1, 0.01);
+    ASSERT_EQUALS(0.01, *cache.getDensity("loc_2dsphere", 1));
+
+    cache.recordDensity("loc_2dsphere", 1, 1);
+    ASSERT_APPROX_EQUAL(0.1, *cache.getDensity("loc_2dsphere", 1), 1e-12);
+
+    // Other indexes and cells are unaffected.
+    cache.recordDensity("other_2dsphere", 1, 100);
+    cache.recordDensity("loc_2dsphere", 2, 100);
+    ASSERT_APPROX_EQUAL(0.1, *cache.getDensity("loc_2dsphere", 1), 1e-12);
+}
+
+TEST(GeoNearDensityCacheTest, ForgetsCellsOfAnIndexWhenFull) {
+    GeoNearDensityCache cache;
+    cache.recordDensity("other_2dsphere", 0, 1);
+    for (uint64_t cellId = 0; cellId < GeoNearDensityCache::kMaxCellsPerIndex; cellId++) {
+        cache.recordDensity("loc_2dsphere", cellId, 1);
+    }
+    ASSERT(cache.getDensity("loc_2dsphere", 0));
+
+    cache.recordDensity("loc_2dsphere", GeoNearDensityCache::kMaxCellsPerIndex, 1);
+    ASSERT_FALSE(cache.getDensity("loc_2dsphere", 0));
+    ASSERT(cache.getDensity("loc_2dsphere", GeoNearDensityCache::kMaxCellsPerIndex));
+    ASSERT(cache.getDensity("other_2dsphere", 0));
+}
+
+TEST(GeoNearDensityCacheTest, ClearForgetsEverything) {
+    GeoNearDensityCache cache;
+    cache.recordDensity("loc_2dsphere", 1, 1);
+    cache.recordDensity("other_2dsphere", 1, 1);
+    cache.clear();
+    ASSERT_FALSE(cache.getDensity("loc_2dsphere", 1));
+    ASSERT_FALSE(cache.getDensity("other_2dsphere", 1));
+}
+
+}  // namespace
+}  // namespace mongo
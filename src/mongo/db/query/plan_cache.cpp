@@ -40,6 +40,7 @@
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -481,9 +482,24 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : _cache(internalQueryCacheSize) {}
+PlanCache::PlanCache() : PlanCache(std::string()) {}
 
-PlanCache::PlanCache(const std::string& ns) : _cache(internalQueryCacheSize), _ns(ns) {}
+PlanCache::PlanCache(const std::string& ns) : _ns(ns) {
+    const size_t cacheSize = std::max(0, internalQueryCacheSize.load());
+
+    // There are never more partitions than entries, so that every partition can hold one.
+    size_t numPartitions = std::max(1, internalQueryCachePartitions.load());
+    numPartitions = std::max(size_t(1), std::min(numPartitions, cacheSize));
+
+    // The partitions together hold exactly 'cacheSize' entries. The first 'cacheSize %
+    // numPartitions' of them hold one entry more than the rest.
+    const size_t partitionSize = cacheSize / numPartitions;
+    const size_t remainder = cacheSize % numPartitions;
+    _partitions.reserve(numPartitions);
+    for (size_t i = 0; i < numPartitions; ++i) {
+        _partitions.push_back(stdx::make_unique<Partition>(partitionSize + (i < remainder)));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
@@ -660,10 +676,13 @@ Status PlanCache::add(const CanonicalQuery& query,
     }
     entry->projection = projBuilder.obj();
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(computeKey(query), entry);
+    PlanCacheKey key = computeKey(query);
+    Partition& partition = _getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, entry);
 
     if (NULL != evictedEntry.get()) {
+        ++partition.stats.evictions;
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
                << "removed least recently used entry " << redact(evictedEntry->toString());
     }
@@ -675,13 +694,16 @@ Status PlanCache::get(const CanonicalQuery& query, CachedSolution** crOut) const
     PlanCacheKey key = computeKey(query);
     verify(crOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = _getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
+        ++partition.stats.misses;
         return cacheStatus;
     }
     invariant(entry);
+    ++partition.stats.hits;
 
     *crOut = new CachedSolution(key, *entry);
 
@@ -695,9 +717,10 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
     std::unique_ptr<PlanCacheEntryFeedback> autoFeedback(feedback);
     PlanCacheKey ck = computeKey(cq);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = _getPartition(ck);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(ck, &entry);
+    Status cacheStatus = partition.cache.get(ck, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -712,13 +735,17 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheKey key = computeKey(canonicalQuery);
+    Partition& partition = _getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        partition->cache.clear();
+    }
     _writeOperations.store(0);
 }
 
@@ -734,9 +761,10 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
     PlanCacheKey key = computeKey(query);
     verify(entryOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = _getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -748,25 +776,48 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
 }
 
 std::vector<PlanCacheEntry*> PlanCache::getAllEntries() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     std::vector<PlanCacheEntry*> entries;
     typedef std::list<std::pair<PlanCacheKey, PlanCacheEntry*>>::const_iterator ConstIterator;
-    for (ConstIterator i = _cache.begin(); i != _cache.end(); i++) {
-        PlanCacheEntry* entry = i->second;
-        entries.push_back(entry->clone());
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        for (ConstIterator i = partition->cache.begin(); i != partition->cache.end(); i++) {
+            PlanCacheEntry* entry = i->second;
+            entries.push_back(entry->clone());
+        }
     }
 
     return entries;
 }
 
 bool PlanCache::contains(const CanonicalQuery& cq) const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.hasKey(computeKey(cq));
+    PlanCacheKey key = computeKey(cq);
+    Partition& partition = _getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.hasKey(key);
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
+}
+
+std::vector<PlanCache::PartitionStats> PlanCache::getPartitionStats() const {
+    std::vector<PartitionStats> stats;
+    stats.reserve(_partitions.size());
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        stats.push_back(partition->stats);
+        stats.back().numEntries = partition->cache.size();
+    }
+    return stats;
+}
+
+PlanCache::Partition& PlanCache::_getPartition(const PlanCacheKey& key) const {
+    return *_partitions[std::hash<PlanCacheKey>()(key) % _partitions.size()];
 }
 
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
@@ -372,6 +372,9 @@ public:
      * Caller owns the result vector and is responsible for cleaning up
      * the cache entry copies.
      * Used by planCacheListQueryShapes and index_filter_commands_test.cpp.
+     *
+     * Entries are grouped by partition, in partition order, and are listed from most to least
+     * recently used within each partition. There is no recency order across partitions.
      */
     std::vector<PlanCacheEntry*> getAllEntries() const;
 
@@ -387,6 +390,23 @@ public:
      */
     size_t size() const;
 
+    /**
+     * Counters for one partition of the cache. 'hits' and 'misses' count lookups made through
+     * get(), and 'evictions' counts entries dropped because the partition was full.
+     */
+    struct PartitionStats {
+        size_t numEntries = 0;
+        long long hits = 0;
+        long long misses = 0;
+        long long evictions = 0;
+    };
+
+    /**
+     * Returns a snapshot of the counters of every partition, in partition order.
+     * Used by planCacheListQueryShapes.
+     */
+    std::vector<PartitionStats> getPartitionStats() const;
+
     /**
      * Updates internal state kept about the collection's indexes.  Must be called when the set
      * of indexes on the associated collection have changed.
@@ -400,10 +420,31 @@ private:
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry> _cache;
+    /**
+     * The entries are spread over several partitions by the hash of their key, each with its own
+     * LRU list and mutex, so that lookups of different query shapes rarely contend with each
+     * other. The capacity of internalQueryCacheSize entries is split evenly between them.
+     *
+     * Eviction is least recently used within a partition. Since a partition evicts once it is
+     * full, a cache whose keys hash unevenly may evict before holding internalQueryCacheSize
+     * entries in total, but it never holds more.
+     */
+    struct Partition {
+        explicit Partition(size_t maxSize) : cache(maxSize) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry> cache;
+
+        // 'numEntries' is not maintained here; it is filled in from 'cache' by
+        // getPartitionStats().
+        PartitionStats stats;
+
+        // Protects 'cache' and 'stats'.
+        stdx::mutex mutex;
+    };
+
+    Partition& _getPartition(const PlanCacheKey& key) const;
 
-    // Protects _cache.
-    mutable stdx::mutex _cacheMutex;
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Counter for write notifications since initialization or last clear() invocation.  Starts
     // at 0.
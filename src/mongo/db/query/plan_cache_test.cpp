@@ -422,6 +422,174 @@ TEST(PlanCacheTest, AddValidSolution) {
     ASSERT_EQUALS(planCache.size(), 1U);
 }
 
+TEST(PlanCacheTest, PartitionStatsCountHitsMissesAndEvictions) {
+    int oldCacheSize = internalQueryCacheSize;
+    int oldCachePartitions = internalQueryCachePartitions;
+    ON_BLOCK_EXIT([oldCacheSize, oldCachePartitions] {
+        internalQueryCacheSize = oldCacheSize;
+        internalQueryCachePartitions = oldCachePartitions;
+    });
+    internalQueryCacheSize = 1;
+    internalQueryCachePartitions = 1;
+
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+
+    CachedSolution* rawCachedSoln;
+    ASSERT_NOT_OK(planCache.get(*cqA, &rawCachedSoln));
+    ASSERT_OK(planCache.add(*cqA, solns, createDecision(1U)));
+    ASSERT_OK(planCache.get(*cqA, &rawCachedSoln));
+    delete rawCachedSoln;
+
+    // The only partition holds a single entry, so adding another shape evicts the first.
+    ASSERT_OK(planCache.add(*cqB, solns, createDecision(1U)));
+    ASSERT_FALSE(planCache.contains(*cqA));
+
+    std::vector<PlanCache::PartitionStats> stats = planCache.getPartitionStats();
+    ASSERT_EQUALS(stats.size(), 1U);
+    ASSERT_EQUALS(stats[0].numEntries, 1U);
+    ASSERT_EQUALS(stats[0].hits, 1);
+    ASSERT_EQUALS(stats[0].misses, 1);
+    ASSERT_EQUALS(stats[0].evictions, 1);
+}
+
+TEST(PlanCacheTest, PartitionsTogetherHoldCacheSizeEntries) {
+    int oldCacheSize = internalQueryCacheSize;
+    int oldCachePartitions = internalQueryCachePartitions;
+    ON_BLOCK_EXIT([oldCacheSize, oldCachePartitions] {
+        internalQueryCacheSize = oldCacheSize;
+        internalQueryCachePartitions = oldCachePartitions;
+    });
+    internalQueryCacheSize = 5;
+    internalQueryCachePartitions = 16;
+
+    PlanCache planCache;
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+
+    // There are no more partitions than entries.
+    ASSERT_EQUALS(planCache.getPartitionStats().size(), 5U);
+
+    for (size_t i = 0; i < 50; ++i) {
+        const std::string field = str::stream() << "f" << i;
+        unique_ptr<CanonicalQuery> cq(canonicalize(BSON(field << 1)));
+        ASSERT_OK(planCache.add(*cq, solns, createDecision(1U)));
+        ASSERT_LESS_THAN_OR_EQUALS(planCache.size(), 5U);
+    }
+}
+
+TEST(PlanCacheTest, CacheOfSizeOneHasOnePartition) {
+    int oldCacheSize = internalQueryCacheSize;
+    int oldCachePartitions = internalQueryCachePartitions;
+    ON_BLOCK_EXIT([oldCacheSize, oldCachePartitions] {
+        internalQueryCacheSize = oldCacheSize;
+        internalQueryCachePartitions = oldCachePartitions;
+    });
+    internalQueryCacheSize = 1;
+    internalQueryCachePartitions = 16;
+
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+
+    ASSERT_OK(planCache.add(*cqA, solns, createDecision(1U)));
+    ASSERT_OK(planCache.add(*cqB, solns, createDecision(1U)));
+    ASSERT_EQUALS(planCache.getPartitionStats().size(), 1U);
+    ASSERT_EQUALS(planCache.size(), 1U);
+    ASSERT_TRUE(planCache.contains(*cqB));
+}
+
+TEST(PlanCacheTest, GetAllEntriesListsPartitionFromMostRecentlyUsed) {
+    int oldCachePartitions = internalQueryCachePartitions;
+    ON_BLOCK_EXIT([oldCachePartitions] { internalQueryCachePartitions = oldCachePartitions; });
+    internalQueryCachePartitions = 1;
+
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    unique_ptr<CanonicalQuery> cqC(canonicalize("{c: 1}"));
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+
+    ASSERT_OK(planCache.add(*cqA, solns, createDecision(1U)));
+    ASSERT_OK(planCache.add(*cqB, solns, createDecision(1U)));
+    ASSERT_OK(planCache.add(*cqC, solns, createDecision(1U)));
+
+    // Looking up 'a' makes it the most recently used entry.
+    CachedSolution* rawCachedSoln;
+    ASSERT_OK(planCache.get(*cqA, &rawCachedSoln));
+    delete rawCachedSoln;
+
+    std::vector<PlanCacheEntry*> entries = planCache.getAllEntries();
+    ASSERT_EQUALS(entries.size(), 3U);
+    ASSERT_BSONOBJ_EQ(entries[0]->query, fromjson("{a: 1}"));
+    ASSERT_BSONOBJ_EQ(entries[1]->query, fromjson("{c: 1}"));
+    ASSERT_BSONOBJ_EQ(entries[2]->query, fromjson("{b: 1}"));
+    for (auto&& entry : entries) {
+        delete entry;
+    }
+}
+
+TEST(PlanCacheTest, EntriesAreSpreadOverPartitions) {
+    int oldCachePartitions = internalQueryCachePartitions;
+    ON_BLOCK_EXIT([oldCachePartitions] { internalQueryCachePartitions = oldCachePartitions; });
+    internalQueryCachePartitions = 4;
+
+    PlanCache planCache;
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+
+    // Each query filters on a different field, so each has a distinct shape.
+    const size_t numShapes = 50;
+    for (size_t i = 0; i < numShapes; ++i) {
+        const std::string field = str::stream() << "f" << i;
+        unique_ptr<CanonicalQuery> cq(canonicalize(BSON(field << 1)));
+        ASSERT_OK(planCache.add(*cq, solns, createDecision(1U)));
+    }
+    ASSERT_EQUALS(planCache.size(), numShapes);
+
+    std::vector<PlanCache::PartitionStats> stats = planCache.getPartitionStats();
+    ASSERT_EQUALS(stats.size(), 4U);
+    size_t totalEntries = 0;
+    size_t nonEmptyPartitions = 0;
+    for (auto&& partitionStats : stats) {
+        ASSERT_EQUALS(partitionStats.evictions, 0);
+        totalEntries += partitionStats.numEntries;
+        nonEmptyPartitions += partitionStats.numEntries > 0;
+    }
+    ASSERT_EQUALS(totalEntries, numShapes);
+    ASSERT_GREATER_THAN(nonEmptyPartitions, 1U);
+
+    std::vector<PlanCacheEntry*> entries = planCache.getAllEntries();
+    ASSERT_EQUALS(entries.size(), numShapes);
+    for (auto&& entry : entries) {
+        delete entry;
+    }
+
+    planCache.clear();
+    ASSERT_EQUALS(planCache.size(), 0U);
+}
+
 /**
  * Each test in the CachePlanSelectionTest suite goes through
  * the following flow:
@@ -599,6 +599,14 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sort->limit = 0;
     }
 
+    // A text search whose results are sorted by text score alone only has to produce the best
+    // 'limit' documents, provided nothing between it and the sort can drop any of them.
+    QuerySolutionNode* sortInput = keyGenNode->children[0];
+    if (sort->limit > 0 && STAGE_TEXT == sortInput->getType() && sortObj.nFields() == 1 &&
+        QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+        static_cast<TextNode*>(sortInput)->topK = sort->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -40,6 +40,8 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationMaxResults, int, 101);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheSize, int, 5000);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCachePartitions, int, 16);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheFeedbacksStored, int, 20);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheEvictionRatio, double, 10.0);
@@ -65,6 +65,10 @@ extern std::atomic<bool> internalQueryPlannerEnableHashIntersection;  // NOLINT
 // How many entries in the cache?
 extern std::atomic<int> internalQueryCacheSize;  // NOLINT
 
+// How many independently locked partitions is each cache split into? Read when a collection's
+// cache is created. A cache never has more partitions than internalQueryCacheSize.
+extern std::atomic<int> internalQueryCachePartitions;  // NOLINT
+
 // How many feedback entries do we collect before possibly evicting from the cache based on bad
 // performance?
 extern std::atomic<int> internalQueryCacheFeedbacksStored;  // NOLINT
@@ -254,6 +254,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // Set when the results are sorted by text score alone and only this many of them are wanted,
+    // which lets the text stage stop reading index keys early. Zero if all results are needed.
+    size_t topK = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sort_key_encoder.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/collation/collation_index_key.h"
+
+namespace mongo {
+
+namespace {
+
+// The number of fields whose directions fit in a single Ordering.
+const size_t kFieldsPerOrdering = 32;
+
+}  // namespace
+
+SortKeyEncoder::SortKeyEncoder(const BSONObj& sortPattern, const CollatorInterface* collator)
+    : _collator(collator), _keyString(KeyString::Version::V1) {
+    BSONObjIterator it(sortPattern);
+    while (it.more()) {
+        BSONObjBuilder groupPattern;
+        for (size_t i = 0; i < kFieldsPerOrdering && it.more(); ++i) {
+            groupPattern.append(it.next());
+        }
+        _orderings.push_back(Ordering::make(groupPattern.obj()));
+    }
+}
+
+bool SortKeyEncoder::encode(const BSONObj& sortKey, RecordId recordId, std::string* out) {
+    out->clear();
+
+    // Every group ends with the same terminator and each encoded value determines its own
+    // length, so concatenating the groups preserves the order of the whole key.
+    BSONObjIterator it(sortKey);
+    for (const Ordering& ordering : _orderings) {
+        _groupBuilder.reset();
+        BSONObjBuilder group(_groupBuilder);
+        for (size_t i = 0; i < kFieldsPerOrdering && it.more(); ++i) {
+            // KeyString requires empty field names.
+            CollationIndexKey::collationAwareIndexKeyAppend(it.next(), _collator, &group);
+        }
+
+        // The type bits of a KeyString only have room for the values of a key that fits in an
+        // index.
+        const BSONObj groupKey = group.done();
+        if (static_cast<size_t>(groupKey.objsize()) > KeyString::TypeBits::kMaxKeyBytes) {
+            out->clear();
+            return false;
+        }
+
+        _keyString.resetToKey(groupKey, ordering);
+        out->append(_keyString.getBuffer(), _keyString.getSize());
+    }
+
+    _keyString.resetToEmpty();
+    _keyString.appendRecordId(recordId);
+    out->append(_keyString.getBuffer(), _keyString.getSize());
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+class CollatorInterface;
+
+/**
+ * Encodes sort keys as KeyString bytes so that sorting stages can order them with a plain byte
+ * comparison instead of BSONObj::woCompare(). Two encodings compare the same way that the keys
+ * they were built from compare under the sort pattern, followed by their RecordIds.
+ *
+ * KeyString can only encode keys that would fit in an index. Callers must keep the sort key of
+ * any document whose key is too large to encode, and compare it with woCompare() instead.
+ */
+class SortKeyEncoder {
+public:
+    /**
+     * 'sortPattern' gives the direction of each sort key field; $meta sorts must already have been
+     * transformed by FindCommon::transformSortSpec(). If 'collator' is non-null, strings are
+     * replaced with its comparison keys before encoding. Keys produced by SortKeyGenerator have
+     * already been mapped through the collator, so their encoder should be given a null collator.
+     */
+    SortKeyEncoder(const BSONObj& sortPattern, const CollatorInterface* collator);
+
+    /**
+     * Replaces the contents of 'out' with the encoding of 'sortKey' followed by 'recordId'. The
+     * elements of 'sortKey' are matched with the sort pattern by position; field names are
+     * ignored.
+     *
+     * Returns false and leaves 'out' empty if 'sortKey' is too large to encode. An encoding is
+     * never empty, so an empty 'out' always marks such a key.
+     */
+    bool encode(const BSONObj& sortKey, RecordId recordId, std::string* out);
+
+private:
+    // KeyString directions are held in an Ordering, which covers at most 32 fields. Longer sort
+    // patterns are split into consecutive groups of fields, each encoded with its own Ordering.
+    std::vector<Ordering> _orderings;
+
+    const CollatorInterface* _collator;
+
+    // Scratch space reused across calls to encode().
+    BufBuilder _groupBuilder;
+    KeyString _keyString;
+};
+
+}  // namespace mongo
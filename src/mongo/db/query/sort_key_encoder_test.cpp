@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for mongo/db/query/sort_key_encoder.h
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sort_key_encoder.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+std::string encode(SortKeyEncoder* encoder,
+                   const BSONObj& sortKey,
+                   RecordId recordId = RecordId()) {
+    std::string out;
+    ASSERT_TRUE(encoder->encode(sortKey, recordId, &out));
+    ASSERT_FALSE(out.empty());
+    return out;
+}
+
+TEST(SortKeyEncoderTest, OrdersKeysByPatternDirections) {
+    SortKeyEncoder encoder(fromjson("{a: 1, b: -1}"), nullptr);
+    ASSERT_LT(encode(&encoder, fromjson("{'': 0, '': 5}")),
+              encode(&encoder, fromjson("{'': 1, '': 2}")));
+    ASSERT_LT(encode(&encoder, fromjson("{'': 1, '': 2}")),
+              encode(&encoder, fromjson("{'': 1, '': 1}")));
+    ASSERT_EQ(encode(&encoder, fromjson("{'': 1, '': 2}")),
+              encode(&encoder, fromjson("{'': 1.0, '': 2}")));
+}
+
+TEST(SortKeyEncoderTest, IgnoresFieldNamesOfSortKey) {
+    SortKeyEncoder encoder(fromjson("{a: 1}"), nullptr);
+    ASSERT_EQ(encode(&encoder, fromjson("{x: 'abc'}")), encode(&encoder, fromjson("{'': 'abc'}")));
+}
+
+TEST(SortKeyEncoderTest, BreaksTiesByRecordId) {
+    SortKeyEncoder encoder(fromjson("{a: -1}"), nullptr);
+    ASSERT_LT(encode(&encoder, fromjson("{'': 1}"), RecordId(1)),
+              encode(&encoder, fromjson("{'': 1}"), RecordId(2)));
+    ASSERT_LT(encode(&encoder, fromjson("{'': 2}"), RecordId(2)),
+              encode(&encoder, fromjson("{'': 1}"), RecordId(1)));
+}
+
+TEST(SortKeyEncoderTest, EncodesStringsByCollationKey) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    SortKeyEncoder encoder(fromjson("{a: 1}"), &collator);
+    ASSERT_LT(encode(&encoder, fromjson("{'': 'ba'}")), encode(&encoder, fromjson("{'': 'ab'}")));
+}
+
+TEST(SortKeyEncoderTest, EncodesPatternsWithMoreThan32Fields) {
+    BSONObjBuilder pattern;
+    BSONObjBuilder smaller;
+    BSONObjBuilder larger;
+    for (int i = 0; i < 40; ++i) {
+        pattern.append(str::stream() << "f" << i, i == 35 ? -1 : 1);
+        smaller.append("", i == 35 ? 2 : 0);
+        larger.append("", i == 35 ? 1 : 0);
+    }
+
+    // Only the descending field in the second group of fields differs.
+    SortKeyEncoder encoder(pattern.obj(), nullptr);
+    ASSERT_LT(encode(&encoder, smaller.obj()), encode(&encoder, larger.obj()));
+}
+
+TEST(SortKeyEncoderTest, DoesNotEncodeKeysLargerThanAnIndexKey) {
+    BSONObjBuilder sortKey;
+    BSONObjBuilder numbers(sortKey.subobjStart(""));
+    for (int i = 0; i < 600; ++i) {
+        numbers.append(str::stream() << "f" << i, i);
+    }
+    numbers.doneFast();
+
+    SortKeyEncoder encoder(fromjson("{a: 1}"), nullptr);
+    std::string out = "previous";
+    ASSERT_FALSE(encoder.encode(sortKey.obj(), RecordId(1), &out));
+    ASSERT_TRUE(out.empty());
+
+    // The encoder is still usable afterwards.
+    ASSERT_LT(encode(&encoder, fromjson("{'': 1}")), encode(&encoder, fromjson("{'': 2}")));
+}
+
+}  // namespace
+}  // namespace mongo
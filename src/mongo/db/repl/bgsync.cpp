@@ -40,6 +40,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/repl/data_replicator_external_state_impl.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_interface_local.h"
@@ -70,6 +71,30 @@ const int kSleepToAllowBatchingMillis = 2;
 const int kSmallBatchLimitBytes = 40000;
 const Milliseconds kRollbackOplogSocketTimeout(10 * 60 * 1000);
 
+// Number of fetched batches which may be waiting to be pushed onto the oplog buffer while the
+// getMore for the next batch is outstanding. Helps secondaries keep up with a distant sync source.
+// Takes effect the next time the oplog fetcher is started.
+std::atomic<int> oplogFetcherPipelineDepth(0);  // NOLINT (server params must use std::atomic)
+class ExportedOplogFetcherPipelineDepthParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedOplogFetcherPipelineDepthParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "oplogFetcherPipelineDepth",
+              &oplogFetcherPipelineDepth) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        if (potentialNewValue < 0 || potentialNewValue > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "oplogFetcherPipelineDepth must be between 0 and 64");
+        }
+
+        return Status::OK();
+    }
+
+} exportedOplogFetcherPipelineDepthParam;
+
 /**
  * Extends DataReplicatorExternalStateImpl to be member state aware.
  */
@@ -376,7 +401,8 @@ void BackgroundSync::_produce(OperationContext* txn) {
                        stdx::placeholders::_1,
                        stdx::placeholders::_2,
                        stdx::placeholders::_3),
-            onOplogFetcherShutdownCallbackFn);
+            onOplogFetcherShutdownCallbackFn,
+            static_cast<std::size_t>(oplogFetcherPipelineDepth.load()));
         oplogFetcher = _oplogFetcher.get();
     } catch (const mongo::DBException& ex) {
         fassertFailedWithStatus(34440, exceptionToStatus());
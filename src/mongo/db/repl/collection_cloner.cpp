@@ -384,6 +384,9 @@ void CollectionCloner::_insertDocumentsCallback(const executor::TaskExecutor::Ca
     _documents.swap(docs);
     _stats.documents += docs.size();
     ++_stats.fetchBatches;
+    for (auto&& doc : docs) {
+        _stats.receivedBytes += doc.objsize();
+    }
     invariant(_collLoader);
     const auto status = _collLoader->insertDocuments(docs.cbegin(), docs.cend());
     lk.unlock();
@@ -446,6 +449,7 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
     builder->appendNumber("documents", documents);
     builder->appendNumber("indexes", indexes);
     builder->appendNumber("fetchedBatches", fetchBatches);
+    builder->appendNumber("receivedBytes", receivedBytes);
     if (start != Date_t()) {
         builder->appendDate("start", start);
         if (end != Date_t()) {
@@ -453,6 +457,12 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
             auto elapsed = end - start;
             long long elapsedMillis = duration_cast<Milliseconds>(elapsed).count();
             builder->appendNumber("elapsedMillis", elapsedMillis);
+            if (elapsedMillis > 0) {
+                builder->appendNumber("documentsPerSecond",
+                                      static_cast<long long>(documents * 1000 / elapsedMillis));
+                builder->appendNumber("bytesPerSecond",
+                                      static_cast<long long>(receivedBytes * 1000 / elapsedMillis));
+            }
         }
     }
 }
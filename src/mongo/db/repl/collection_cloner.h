@@ -67,6 +67,7 @@ public:
         size_t documents{0};
         size_t indexes{0};
         size_t fetchBatches{0};
+        size_t receivedBytes{0};
 
         std::string toString() const;
         BSONObj toBSON() const;
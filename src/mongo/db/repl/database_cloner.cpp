@@ -62,6 +62,31 @@ const char* kOptionsFieldName = "options";
 // The number of attempts for the listCollections commands.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListCollectionsAttempts, int, 3);
 
+// The number of collections in a database which are cloned at the same time during initial sync.
+// Each collection is loaded by its own bulk loader, so raising this overlaps the fetching,
+// inserting and index key generation of several collections. Takes effect for databases whose
+// cloning has not yet started.
+std::atomic<int> initialSyncCollectionClonerConcurrency(1);  // NOLINT (server params must use std::atomic)
+class ExportedInitialSyncCollectionClonerConcurrencyParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedInitialSyncCollectionClonerConcurrencyParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "initialSyncCollectionClonerConcurrency",
+              &initialSyncCollectionClonerConcurrency) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        if (potentialNewValue < 1 || potentialNewValue > 16) {
+            return Status(ErrorCodes::BadValue,
+                          "initialSyncCollectionClonerConcurrency must be between 1 and 16");
+        }
+
+        return Status::OK();
+    }
+
+} exportedInitialSyncCollectionClonerConcurrencyParam;
+
 /**
  * Default listCollections predicate.
  */
@@ -119,6 +144,8 @@ DatabaseCloner::DatabaseCloner(executor::TaskExecutor* executor,
                                   numInitialSyncListCollectionsAttempts,
                                   executor::RemoteCommandRequest::kNoTimeout,
                                   RemoteCommandRetryScheduler::kAllRetriableErrors)),
+      _maxConcurrentCollectionCloners(
+          static_cast<size_t>(initialSyncCollectionClonerConcurrency.load())),
       _startCollectionCloner([](CollectionCloner& cloner) { return cloner.startup(); }) {
     // Fetcher throws an exception on null executor.
     invariant(executor);
@@ -199,6 +226,7 @@ void DatabaseCloner::shutdown() {
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     LockGuard lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
+    stats.activeCollections = _activeCollectionCloners;
     for (auto&& collectionCloner : _collectionCloners) {
         stats.collectionStats.emplace_back(collectionCloner.getStats());
     }
@@ -221,6 +249,13 @@ void DatabaseCloner::setStartCollectionClonerFn(
     _startCollectionCloner = startCollectionCloner;
 }
 
+void DatabaseCloner::setMaxConcurrentCollectionCloners_forTest(
+    size_t maxConcurrentCollectionCloners) {
+    LockGuard lk(_mutex);
+    invariant(maxConcurrentCollectionCloners > 0);
+    _maxConcurrentCollectionCloners = maxConcurrentCollectionCloners;
+}
+
 void DatabaseCloner::_listCollectionsCallback(const StatusWith<Fetcher::QueryResponse>& result,
                                               Fetcher::NextAction* nextAction,
                                               BSONObjBuilder* getMoreBob) {
@@ -346,20 +381,37 @@ void DatabaseCloner::_listCollectionsCallback(const StatusWith<Fetcher::QueryRes
         }
     }
 
-    // Start first collection cloner.
-    _currentCollectionClonerIter = _collectionCloners.begin();
-
-    LOG(1) << "    cloning collection " << _currentCollectionClonerIter->getSourceNamespace();
-
-    Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-    if (!startStatus.isOK()) {
-        LOG(1) << "    failed to start collection cloning on "
-               << _currentCollectionClonerIter->getSourceNamespace() << ": " << redact(startStatus);
+    // Start as many collection cloners as we are allowed to run at once.
+    _nextCollectionClonerIter = _collectionCloners.begin();
+    Status startStatus = _startCollectionCloners_inlock();
+    if (!startStatus.isOK() && _activeCollectionCloners == 0) {
         _finishCallback_inlock(lk, startStatus);
         return;
     }
 }
 
+Status DatabaseCloner::_startCollectionCloners_inlock() {
+    while (_activeCollectionCloners < _maxConcurrentCollectionCloners &&
+           _nextCollectionClonerIter != _collectionCloners.end()) {
+        auto&& cloner = *_nextCollectionClonerIter;
+        LOG(1) << "    cloning collection " << cloner.getSourceNamespace();
+
+        Status startStatus = _startCollectionCloner(cloner);
+        if (!startStatus.isOK()) {
+            LOG(1) << "    failed to start collection cloning on " << cloner.getSourceNamespace()
+                   << ": " << redact(startStatus);
+            // Let the running cloners finish but do not start any more.
+            _nextCollectionClonerIter = _collectionCloners.end();
+            _startCollectionClonerStatus = startStatus;
+            return startStatus;
+        }
+
+        ++_activeCollectionCloners;
+        ++_nextCollectionClonerIter;
+    }
+    return Status::OK();
+}
+
 void DatabaseCloner::_collectionClonerCallback(const Status& status, const NamespaceString& nss) {
     auto newStatus = status;
 
@@ -380,17 +432,18 @@ void DatabaseCloner::_collectionClonerCallback(const Status& status, const Names
     lk.unlock();
     _collectionWork(newStatus, nss);
     lk.lock();
-    _currentCollectionClonerIter++;
+    invariant(_activeCollectionCloners > 0);
+    --_activeCollectionCloners;
 
-    if (_currentCollectionClonerIter != _collectionCloners.end()) {
-        Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-        if (!startStatus.isOK()) {
-            LOG(1) << "    failed to start collection cloning on "
-                   << _currentCollectionClonerIter->getSourceNamespace() << ": "
-                   << redact(startStatus);
-            _finishCallback_inlock(lk, startStatus);
-            return;
-        }
+    // Replace the finished cloner with the next one. A failure to start a cloner is reported once
+    // the cloners that are still running have completed.
+    _startCollectionCloners_inlock();
+    if (_activeCollectionCloners > 0) {
+        return;
+    }
+
+    if (!_startCollectionClonerStatus.isOK()) {
+        _finishCallback_inlock(lk, _startCollectionClonerStatus);
         return;
     }
 
@@ -440,6 +493,7 @@ BSONObj DatabaseCloner::Stats::toBSON() const {
 void DatabaseCloner::Stats::append(BSONObjBuilder* builder) const {
     builder->appendNumber("collections", collections);
     builder->appendNumber("clonedCollections", clonedCollections);
+    builder->appendNumber("activeCollections", activeCollections);
     if (start != Date_t()) {
         builder->appendDate("start", start);
         if (end != Date_t()) {
@@ -67,6 +67,7 @@ public:
         Date_t end;
         size_t collections{0};
         size_t clonedCollections{0};
+        size_t activeCollections{0};
         std::vector<CollectionCloner::Stats> collectionStats;
 
         std::string toString() const;
@@ -161,6 +162,14 @@ public:
      */
     void setStartCollectionClonerFn(const StartCollectionClonerFn& startCollectionCloner);
 
+    /**
+     * Overrides the number of collection cloners that may run at the same time. Defaults to the
+     * value of the 'initialSyncCollectionClonerConcurrency' server parameter at construction.
+     *
+     * For testing only.
+     */
+    void setMaxConcurrentCollectionCloners_forTest(size_t maxConcurrentCollectionCloners);
+
 private:
     /**
      * Read collection names and options from listCollections result.
@@ -175,6 +184,14 @@ private:
      */
     void _collectionClonerCallback(const Status& status, const NamespaceString& nss);
 
+    /**
+     * Starts collection cloners from '_nextCollectionClonerIter' until either all cloners have
+     * been started or '_maxConcurrentCollectionCloners' are running.
+     * Returns the status of the first cloner that could not be started. No further cloners are
+     * started once a start has failed.
+     */
+    Status _startCollectionCloners_inlock();
+
     /**
      * Reports completion status.
      * Sets cloner to inactive.
@@ -221,7 +238,10 @@ private:
     std::vector<BSONObj> _collectionInfos;                               // (M)
     std::vector<NamespaceString> _collectionNamespaces;                  // (M)
     std::list<CollectionCloner> _collectionCloners;                      // (M)
-    std::list<CollectionCloner>::iterator _currentCollectionClonerIter;  // (M)
+    std::list<CollectionCloner>::iterator _nextCollectionClonerIter;     // (M)
+    size_t _activeCollectionCloners = 0;                                 // (M)
+    size_t _maxConcurrentCollectionCloners;                              // (RT)
+    Status _startCollectionClonerStatus = Status::OK();                  // (M)
     std::vector<std::pair<Status, NamespaceString>> _failedNamespaces;   // (M)
     CollectionCloner::ScheduleDbWorkFn
         _scheduleDbWorkFn;  // (RT) Function for scheduling database work using the executor.
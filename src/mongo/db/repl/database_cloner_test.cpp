@@ -30,6 +30,7 @@
 
 #include <list>
 #include <memory>
+#include <set>
 #include <utility>
 
 #include "mongo/db/commands/list_collections_filter.h"
@@ -659,4 +660,65 @@ TEST_F(DatabaseClonerTest, CreateCollections) {
     stats.commitCalled = true;
 }
 
+TEST_F(DatabaseClonerTest, CreateCollectionsConcurrently) {
+    _databaseCloner->setMaxConcurrentCollectionCloners_forTest(2U);
+    ASSERT_OK(_databaseCloner->startup());
+
+    const std::vector<BSONObj> sourceInfos = {BSON("name"
+                                                   << "a"
+                                                   << "options"
+                                                   << BSONObj()),
+                                              BSON("name"
+                                                   << "b"
+                                                   << "options"
+                                                   << BSONObj())};
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        processNetworkResponse(
+            createListCollectionsResponse(0, BSON_ARRAY(sourceInfos[0] << sourceInfos[1])));
+    }
+    ASSERT_EQUALS(getDetectableErrorStatus(), getStatus());
+    ASSERT_TRUE(_databaseCloner->isActive());
+    ASSERT_EQUALS(2U, _databaseCloner->getStats().activeCollections);
+
+    // Both collection cloners are running, so listIndexes is outstanding for both collections
+    // before either of them has received a response.
+    {
+        auto net = getNet();
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+        std::set<std::string> listIndexesCollections;
+        for (int i = 0; i < 2; ++i) {
+            ASSERT_TRUE(net->hasReadyRequests());
+            NetworkOperationIterator noi = net->getNextReadyRequest();
+            auto&& cmdObj = noi->getRequest().cmdObj;
+            ASSERT_EQUALS("listIndexes", std::string(cmdObj.firstElementFieldName()));
+            listIndexesCollections.insert(cmdObj.firstElement().String());
+            scheduleNetworkResponse(noi, createListIndexesResponse(0, BSON_ARRAY(idIndexSpec)));
+        }
+        ASSERT_TRUE(std::set<std::string>({"a", "b"}) == listIndexesCollections);
+        finishProcessingNetworkResponse();
+    }
+    ASSERT_TRUE(_databaseCloner->isActive());
+
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        scheduleNetworkResponse(createCursorResponse(0, BSONArray()));
+        processNetworkResponse(createCursorResponse(0, BSONArray()));
+    }
+
+    _databaseCloner->join();
+    ASSERT_OK(getStatus());
+    ASSERT_FALSE(_databaseCloner->isActive());
+
+    auto stats = _databaseCloner->getStats();
+    ASSERT_EQUALS(2U, stats.clonedCollections);
+    ASSERT_EQUALS(0U, stats.activeCollections);
+
+    ASSERT_EQUALS(2U, _collections.size());
+    ASSERT_OK(_collections[NamespaceString{"db.a"}].status);
+    ASSERT_TRUE(_collections[NamespaceString{"db.a"}].stats.commitCalled);
+    ASSERT_OK(_collections[NamespaceString{"db.b"}].status);
+    ASSERT_TRUE(_collections[NamespaceString{"db.b"}].stats.commitCalled);
+}
+
 }  // namespace
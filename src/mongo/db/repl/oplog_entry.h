@@ -50,7 +50,7 @@ struct OplogEntry {
 
     explicit OplogEntry(BSONObj raw);
 
-    // This member is not parsed from the BSON and is instead populated by fillWriterVectors.
+    // This member is not parsed from the BSON and is instead populated by fillDependencyChains.
     bool isForCappedCollection = false;
 
     bool isCommand() const;
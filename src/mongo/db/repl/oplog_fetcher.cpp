@@ -33,6 +33,7 @@
 #include "mongo/db/repl/oplog_fetcher.h"
 
 #include "mongo/base/counter.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -249,7 +250,8 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
                            std::size_t maxFetcherRestarts,
                            DataReplicatorExternalState* dataReplicatorExternalState,
                            EnqueueDocumentsFn enqueueDocumentsFn,
-                           OnShutdownCallbackFn onShutdownCallbackFn)
+                           OnShutdownCallbackFn onShutdownCallbackFn,
+                           std::size_t pipelineDepth)
     : _executor(executor),
       _source(source),
       _nss(nss),
@@ -261,6 +263,8 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _awaitDataTimeout(calculateAwaitDataTimeout(config)),
       _onShutdownCallbackFn(onShutdownCallbackFn),
       _lastFetched(lastFetched),
+      _lastValidated(lastFetched),
+      _pipelineDepth(pipelineDepth),
       _fetcher(_makeFetcher(_lastFetched.opTime)) {
     uassert(ErrorCodes::BadValue, "null last optime fetched", !lastFetched.opTime.isNull());
     uassert(ErrorCodes::InvalidReplicaSetConfig,
@@ -269,6 +273,22 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
     uassert(ErrorCodes::BadValue, "null enqueueDocuments function", enqueueDocumentsFn);
     uassert(ErrorCodes::BadValue, "null onShutdownCallback function", onShutdownCallbackFn);
 
+    if (_pipelineDepth > 0) {
+        ThreadPool::Options options;
+        options.poolName = "oplogFetcherPipeline";
+        options.threadNamePrefix = "oplogFetcherPipeline-";
+        // A single thread keeps the batches in the order they were fetched.
+        options.minThreads = 0;
+        options.maxThreads = 1;
+        options.onCreateThread = [](const std::string& threadName) {
+            if (hasGlobalServiceContext()) {
+                Client::initThread(threadName.c_str());
+            }
+        };
+        _pipelinePool = stdx::make_unique<ThreadPool>(options);
+        _pipelinePool->startup();
+    }
+
     readersCreatedStats.increment();
 }
 
@@ -297,6 +317,9 @@ void OplogFetcher::shutdown() {
 
 void OplogFetcher::join() {
     _fetcher->join();
+    if (_pipelinePool) {
+        _waitForPipelineToDrain();
+    }
 }
 
 OpTimeWithHash OplogFetcher::getLastOpTimeWithHashFetched() const {
@@ -365,7 +388,7 @@ void OplogFetcher::_callback(const Fetcher::QueryResponseStatus& result,
         LOG(2) << "oplog fetcher read 0 operations from remote oplog";
     }
 
-    auto opTimeWithHash = getLastOpTimeWithHashFetched();
+    auto opTimeWithHash = _lastValidated;
 
     // Check start of remote oplog and, if necessary, stop fetcher to execute rollback.
     if (queryResponse.first) {
@@ -397,17 +420,39 @@ void OplogFetcher::_callback(const Fetcher::QueryResponseStatus& result,
     // Record time for each batch.
     getmoreReplStats.recordMillis(durationCount<Milliseconds>(queryResponse.elapsedMillis));
 
-    // TODO: back pressure handling will be added in SERVER-23499.
-    _enqueueDocumentsFn(firstDocToApply, documents.cend(), info);
+    if (_pipelinePool) {
+        // Hand the batch over to the pipeline thread so that the getMore for the next batch goes
+        // out while these operations are pushed onto the buffer. The documents point into the
+        // response, which does not outlive this callback, so they have to be copied.
+        if (firstDocToApply != documents.cend()) {
+            Fetcher::Documents batch;
+            batch.reserve(std::distance(firstDocToApply, documents.cend()));
+            for (auto it = firstDocToApply; it != documents.cend(); ++it) {
+                batch.push_back(it->getOwned());
+            }
+
+            auto status = _enqueueInPipeline(std::move(batch), info);
+            if (!status.isOK()) {
+                _onShutdown(status, opTimeWithHash);
+                return;
+            }
+
+            opTimeWithHash = info.lastDocument;
+            _lastValidated = opTimeWithHash;
+        }
+    } else {
+        _enqueueDocumentsFn(firstDocToApply, documents.cend(), info);
 
-    // Update last fetched info.
-    if (firstDocToApply != documents.cend()) {
-        opTimeWithHash = info.lastDocument;
-        LOG(3) << "batch resetting last fetched optime: " << opTimeWithHash.opTime
-               << "; hash: " << opTimeWithHash.value;
+        // Update last fetched info.
+        if (firstDocToApply != documents.cend()) {
+            opTimeWithHash = info.lastDocument;
+            LOG(3) << "batch resetting last fetched optime: " << opTimeWithHash.opTime
+                   << "; hash: " << opTimeWithHash.value;
 
-        stdx::unique_lock<stdx::mutex> lock(_mutex);
-        _lastFetched = opTimeWithHash;
+            _lastValidated = opTimeWithHash;
+            stdx::unique_lock<stdx::mutex> lock(_mutex);
+            _lastFetched = opTimeWithHash;
+        }
     }
 
     if (_dataReplicatorExternalState->shouldStopFetching(_fetcher->getSource(), metadata)) {
@@ -442,9 +487,74 @@ void OplogFetcher::_onShutdown(Status status) {
 }
 
 void OplogFetcher::_onShutdown(Status status, OpTimeWithHash opTimeWithHash) {
+    if (_pipelinePool) {
+        // Only report operations which have actually been enqueued.
+        _waitForPipelineToDrain();
+        opTimeWithHash = getLastOpTimeWithHashFetched();
+    }
     _onShutdownCallbackFn(status, opTimeWithHash);
 }
 
+Status OplogFetcher::_enqueueInPipeline(Fetcher::Documents documents, const DocumentsInfo& info) {
+    {
+        stdx::unique_lock<stdx::mutex> lock(_mutex);
+        _pipelineCondition.wait(lock, [this] {
+            return _pipelinedBatches < _pipelineDepth || !_pipelineStatus.isOK();
+        });
+        if (!_pipelineStatus.isOK()) {
+            return _pipelineStatus;
+        }
+        ++_pipelinedBatches;
+    }
+
+    // Shared so that the task stays copyable.
+    auto batch = std::make_shared<Fetcher::Documents>(std::move(documents));
+    auto scheduleStatus = _pipelinePool->schedule([this, batch, info] {
+        Status status = Status::OK();
+        bool failedEarlier;
+        {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            failedEarlier = !_pipelineStatus.isOK();
+        }
+
+        // Once a batch has failed, enqueuing a later one would leave a gap in the buffer.
+        if (!failedEarlier) {
+            try {
+                _enqueueDocumentsFn(batch->cbegin(), batch->cend(), info);
+            } catch (...) {
+                status = exceptionToStatus();
+            }
+        }
+
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        if (!failedEarlier) {
+            if (status.isOK()) {
+                LOG(3) << "batch resetting last fetched optime: " << info.lastDocument.opTime
+                       << "; hash: " << info.lastDocument.value;
+                _lastFetched = info.lastDocument;
+            } else {
+                _pipelineStatus = status;
+            }
+        }
+        --_pipelinedBatches;
+        _pipelineCondition.notify_all();
+    });
+
+    if (!scheduleStatus.isOK()) {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        --_pipelinedBatches;
+        _pipelineCondition.notify_all();
+        return scheduleStatus;
+    }
+
+    return Status::OK();
+}
+
+void OplogFetcher::_waitForPipelineToDrain() {
+    stdx::unique_lock<stdx::mutex> lock(_mutex);
+    _pipelineCondition.wait(lock, [this] { return _pipelinedBatches == 0; });
+}
+
 std::unique_ptr<Fetcher> OplogFetcher::_makeFetcher(OpTime lastFetchedOpTime) {
     return stdx::make_unique<Fetcher>(
         _executor,
@@ -39,7 +39,9 @@
 #include "mongo/db/repl/data_replicator_external_state.h"
 #include "mongo/db/repl/optime_with.h"
 #include "mongo/db/repl/replica_set_config.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/functional.h"
+#include "mongo/util/concurrency/thread_pool.h"
 
 namespace mongo {
 namespace repl {
@@ -67,6 +69,13 @@ using OpTimeWithHash = OpTimeWith<long long>;
  *
  * Issues a getMore command after successfully processing each batch of operations.
  *
+ * With a pipeline depth greater than zero, the getMore for the next batch is issued as soon as a
+ * batch has been validated, and the batch is handed to "enqueueDocumentsFn" on a separate thread,
+ * so that the round trip to the sync source overlaps with pushing operations onto the buffer. At
+ * most "pipelineDepth" batches may be waiting for "enqueueDocumentsFn". Once that many are
+ * pending, for instance because the buffer is full and "enqueueDocumentsFn" is waiting for space,
+ * the next getMore is held back, so the limits of the buffer still throttle fetching.
+ *
  * When there is an error or when it is not possible to issue another getMore request, calls
  * "onShutdownCallbackFn" to signal the end of processing.
  */
@@ -122,6 +131,10 @@ public:
     /**
      * Initializes fetcher with command to tail remote oplog.
      *
+     * "pipelineDepth" is the number of fetched batches which may be waiting to be passed to
+     * "enqueueDocumentsFn" while the next getMore is outstanding. Zero enqueues each batch before
+     * requesting the next one.
+     *
      * Throws a UserException if validation fails on any of the provided arguments.
      */
     OplogFetcher(executor::TaskExecutor* executor,
@@ -132,7 +145,8 @@ public:
                  std::size_t maxFetcherRestarts,
                  DataReplicatorExternalState* dataReplicatorExternalState,
                  EnqueueDocumentsFn enqueueDocumentsFn,
-                 OnShutdownCallbackFn onShutdownCallbackFn);
+                 OnShutdownCallbackFn onShutdownCallbackFn,
+                 std::size_t pipelineDepth = 0);
 
     virtual ~OplogFetcher();
 
@@ -156,7 +170,8 @@ public:
     void shutdown();
 
     /**
-     * Waits until the oplog fetcher is inactive.
+     * Waits until the oplog fetcher is inactive and every fetched batch has been passed to
+     * "enqueueDocumentsFn".
      * It is fine to call this multiple times.
      */
     void join();
@@ -210,6 +225,18 @@ private:
      */
     std::unique_ptr<Fetcher> _makeFetcher(OpTime lastFetchedOpTime);
 
+    /**
+     * Schedules "enqueueDocumentsFn" to be run on 'documents' by the pipeline thread, after
+     * waiting until fewer than "pipelineDepth" batches are pending.
+     * Returns the error of an earlier batch if enqueuing it failed.
+     */
+    Status _enqueueInPipeline(Fetcher::Documents documents, const DocumentsInfo& info);
+
+    /**
+     * Waits until every batch handed to the pipeline thread has been enqueued.
+     */
+    void _waitForPipelineToDrain();
+
     // Protects member data of this OplogFetcher.
     mutable stdx::mutex _mutex;
 
@@ -232,6 +259,25 @@ private:
     // "_enqueueDocumentsFn".
     OpTimeWithHash _lastFetched;
 
+    // Last operation which passed validation. Ahead of '_lastFetched' while validated batches are
+    // waiting in the pipeline. Only accessed from the fetcher callback.
+    OpTimeWithHash _lastValidated;
+
+    const std::size_t _pipelineDepth;
+
+    // Runs "enqueueDocumentsFn" on the batches handed over by the fetcher callback, in order. Null
+    // if "pipelineDepth" is zero.
+    std::unique_ptr<ThreadPool> _pipelinePool;
+
+    // Number of batches handed to the pipeline thread which have not been enqueued yet.
+    std::size_t _pipelinedBatches = 0;
+
+    // Set if "enqueueDocumentsFn" failed on the pipeline thread. No later batch is enqueued.
+    Status _pipelineStatus = Status::OK();
+
+    // Signalled when a batch leaves the pipeline.
+    stdx::condition_variable _pipelineCondition;
+
     std::unique_ptr<Fetcher> _fetcher;
 };
 
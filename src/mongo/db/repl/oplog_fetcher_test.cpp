@@ -37,7 +37,9 @@
 #include "mongo/rpc/metadata.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
 #include "mongo/rpc/metadata/server_selection_metadata.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/unittest/unittest.h"
 
 namespace {
@@ -736,6 +738,67 @@ TEST_F(OplogFetcherTest,
     ASSERT_FALSE(request.cmdObj.hasField("lastKnownCommittedOpTime"));
 }
 
+TEST_F(OplogFetcherTest, PipelinedOplogFetcherRequestsNextBatchBeforeEnqueuingCurrentBatch) {
+    stdx::mutex mutex;
+    stdx::condition_variable condition;
+    bool enqueueAllowed = false;
+    Fetcher::Documents enqueuedDocuments;
+    auto blockingEnqueueDocumentsFn = [&](Fetcher::Documents::const_iterator begin,
+                                          Fetcher::Documents::const_iterator end,
+                                          const OplogFetcher::DocumentsInfo& info) {
+        stdx::unique_lock<stdx::mutex> lock(mutex);
+        condition.wait(lock, [&] { return enqueueAllowed; });
+        enqueuedDocuments.insert(enqueuedDocuments.end(), begin, end);
+    };
+
+    ShutdownState shutdownState;
+    OplogFetcher oplogFetcher(&getExecutor(),
+                              lastFetched,
+                              source,
+                              nss,
+                              _createConfig(true),
+                              0,
+                              dataReplicatorExternalState.get(),
+                              blockingEnqueueDocumentsFn,
+                              stdx::ref(shutdownState),
+                              2U);
+
+    ASSERT_OK(oplogFetcher.startup());
+
+    // The getMore goes out while the first batch is still waiting to be enqueued.
+    CursorId cursorId = 22LL;
+    auto firstEntry = makeNoopOplogEntry(lastFetched);
+    auto secondEntry = makeNoopOplogEntry({{Seconds(456), 0}, lastFetched.opTime.getTerm()}, 200);
+    processNetworkResponse(makeCursorResponse(cursorId, {firstEntry, secondEntry}), true);
+
+    {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        ASSERT_TRUE(enqueuedDocuments.empty());
+        enqueueAllowed = true;
+        condition.notify_all();
+    }
+
+    auto thirdEntry = makeNoopOplogEntry({{Seconds(789), 0}, lastFetched.opTime.getTerm()}, 300);
+    auto fourthEntry = makeNoopOplogEntry({{Seconds(1200), 0}, lastFetched.opTime.getTerm()}, 300);
+    auto request = processNetworkResponse(makeCursorResponse(0, {thirdEntry, fourthEntry}, false));
+    ASSERT_EQUALS(std::string("getMore"), request.cmdObj.firstElementFieldName());
+
+    oplogFetcher.shutdown();
+    oplogFetcher.join();
+
+    // Batches are enqueued in the order they were fetched, and the shutdown callback only sees
+    // the last fetched operation once it has been enqueued.
+    ASSERT_EQUALS(3U, enqueuedDocuments.size());
+    ASSERT_BSONOBJ_EQ(secondEntry, enqueuedDocuments[0]);
+    ASSERT_BSONOBJ_EQ(thirdEntry, enqueuedDocuments[1]);
+    ASSERT_BSONOBJ_EQ(fourthEntry, enqueuedDocuments[2]);
+
+    ASSERT_OK(shutdownState.getStatus());
+    ASSERT_EQUALS(OpTimeWithHash(fourthEntry["h"].numberLong(),
+                                 unittest::assertGet(OpTime::parseFromOplogEntry(fourthEntry))),
+                  shutdownState.getLastFetched());
+}
+
 TEST_F(OplogFetcherTest, ValidateDocumentsReturnsNoSuchKeyIfTimestampIsNotFoundInAnyDocument) {
     auto firstEntry = makeNoopOplogEntry(Seconds(123), 100);
     auto secondEntry = BSON("o" << BSON("msg"
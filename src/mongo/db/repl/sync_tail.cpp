@@ -34,6 +34,7 @@
 #include "mongo/db/repl/sync_tail.h"
 
 #include "third_party/murmurhash3/MurmurHash3.h"
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <memory>
 
@@ -68,7 +69,9 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -437,19 +440,51 @@ void prefetchOps(const MultiApplier::Operations& ops, OldThreadPool* prefetcherP
 }
 
 // Doles out all the work to the writer pool threads.
-// Does not modify writerVectors, but passes non-const pointers to inner vectors into func.
-void applyOps(std::vector<MultiApplier::OperationPtrs>& writerVectors,
+//
+// Rather than giving each thread a fixed share of the chains up front, every thread repeatedly
+// claims the next run of unclaimed chains from 'nextChain' until none are left, so a thread that
+// is done early picks up work that a static assignment would have left queued behind a busy one.
+// Each claim takes a share of the remaining chains that shrinks as the batch drains: early claims
+// are large, so 'func' is called only a few times per thread and can still group inserts, while
+// the small claims at the end even out the finishing times of the threads.
+//
+// The chains in a claim are concatenated before being passed to 'func'. Since a chain is never
+// split, all the operations on one document are applied in order by a single call.
+void applyOps(const std::vector<MultiApplier::OperationPtrs>& chains,
               OldThreadPool* writerPool,
               const MultiApplier::ApplyOperationFn& func,
+              AtomicUInt64* nextChain,
               std::vector<Status>* statusVector) {
-    invariant(writerVectors.size() == statusVector->size());
     TimerHolder timer(&applyBatchStats);
-    for (size_t i = 0; i < writerVectors.size(); i++) {
-        if (!writerVectors[i].empty()) {
-            writerPool->schedule([&func, &writerVectors, statusVector, i] {
-                (*statusVector)[i] = func(&writerVectors[i]);
-            });
-        }
+    const size_t numWorkers = std::min(statusVector->size(), chains.size());
+    for (size_t i = 0; i < numWorkers; i++) {
+        writerPool->schedule([&func, &chains, nextChain, statusVector, numWorkers, i] {
+            MultiApplier::OperationPtrs opsToApply;
+            unsigned long long begin = nextChain->load();
+            while (begin < chains.size()) {
+                const unsigned long long count =
+                    std::max<unsigned long long>(1, (chains.size() - begin) / (2 * numWorkers));
+                const unsigned long long observed = nextChain->compareAndSwap(begin, begin + count);
+                if (observed != begin) {
+                    // Another thread claimed these chains first.
+                    begin = observed;
+                    continue;
+                }
+
+                opsToApply.clear();
+                for (auto chain = chains.begin() + begin; chain != chains.begin() + begin + count;
+                     ++chain) {
+                    opsToApply.insert(opsToApply.end(), chain->begin(), chain->end());
+                }
+
+                Status status = func(&opsToApply);
+                if (!status.isOK()) {
+                    (*statusVector)[i] = status;
+                    return;
+                }
+                begin = nextChain->load();
+            }
+        });
     }
 }
 
@@ -566,16 +601,22 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+// Splits 'ops' into chains of operations that have to be applied in the order they appear in the
+// batch, and that are independent of the operations in every other chain. Operations on the same
+// document share a chain. On storage engines without document level locking, and for capped
+// collections, which must preserve insertion order, all operations on a collection share a chain.
+// Operations whose keys collide in the hash share a chain too, which is safe but less parallel.
+//
 // This only modifies the isForCappedCollection field on each op. It does not alter the ops vector
 // in any other way.
-void fillWriterVectors(OperationContext* txn,
-                       MultiApplier::Operations* ops,
-                       std::vector<MultiApplier::OperationPtrs>* writerVectors) {
+void fillDependencyChains(OperationContext* txn,
+                          MultiApplier::Operations* ops,
+                          std::vector<MultiApplier::OperationPtrs>* chains) {
     const bool supportsDocLocking =
         getGlobalServiceContext()->getGlobalStorageEngine()->supportsDocLocking();
-    const uint32_t numWriters = writerVectors->size();
 
     CachedCollectionProperties collPropertiesCache;
+    stdx::unordered_map<uint32_t, size_t> chainForHash;
 
     for (auto&& op : *ops) {
         StringMapTraits::HashedKey hashedNs(op.ns);
@@ -604,10 +645,11 @@ void fillWriterVectors(OperationContext* txn,
             }
         }
 
-        auto& writer = (*writerVectors)[hash % numWriters];
-        if (writer.empty())
-            writer.reserve(8);  // skip a few growth rounds.
-        writer.push_back(&op);
+        auto inserted = chainForHash.emplace(hash, chains->size());
+        if (inserted.second) {
+            chains->emplace_back();
+        }
+        (*chains)[inserted.first->second].push_back(&op);
     }
 }
 
@@ -1257,20 +1299,21 @@ StatusWith<OpTime> multiApply(OperationContext* txn,
     std::vector<Status> statusVector(workerPool->getNumThreads(), Status::OK());
     {
         // We must wait for the all work we've dispatched to complete before leaving this block
-        // because the spawned threads refer to objects on our stack, including writerVectors.
-        std::vector<MultiApplier::OperationPtrs> writerVectors(workerPool->getNumThreads());
+        // because the spawned threads refer to objects on our stack, including chains.
+        std::vector<MultiApplier::OperationPtrs> chains;
+        AtomicUInt64 nextChain;
         ON_BLOCK_EXIT([&] { workerPool->join(); });
 
         storage->setOplogDeleteFromPoint(txn, ops.front().ts.timestamp());
         scheduleWritesToOplog(txn, workerPool, ops);
-        fillWriterVectors(txn, &ops, &writerVectors);
+        fillDependencyChains(txn, &ops, &chains);
 
         workerPool->join();
 
         storage->setOplogDeleteFromPoint(txn, Timestamp());
         storage->setMinValidToAtLeast(txn, ops.back().getOpTime());
 
-        applyOps(writerVectors, workerPool, applyOperation, &statusVector);
+        applyOps(chains, workerPool, applyOperation, &nextChain, &statusVector);
     }
 
     // If any of the statuses is not ok, return error.
@@ -29,6 +29,7 @@
 #include "mongo/platform/basic.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -601,6 +602,61 @@ TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceH
     ASSERT_BSONOBJ_EQ(op2.raw, operationsWrittenToOplog[1]);
 }
 
+TEST_F(SyncTailTest, MultiApplyAppliesAllOperationsOnADocumentInOrderInASingleCall) {
+    NamespaceString nss("test.t");
+    OldThreadPool writerPool(4);
+
+    stdx::mutex mutex;
+    std::vector<MultiApplier::Operations> operationsApplied;
+    auto applyOperationFn = [&mutex, &operationsApplied](
+        MultiApplier::OperationPtrs* operationsForWriterThreadToApply) -> Status {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        operationsApplied.emplace_back();
+        for (auto&& opPtr : *operationsForWriterThreadToApply) {
+            operationsApplied.back().push_back(*opPtr);
+        }
+        return Status::OK();
+    };
+
+    // Interleave several updates to each of a number of documents.
+    const int numDocs = 20;
+    const int numUpdatesPerDoc = 3;
+    MultiApplier::Operations ops;
+    for (int update = 0; update < numUpdatesPerDoc; ++update) {
+        for (int id = 0; id < numDocs; ++id) {
+            OpTime opTime(Timestamp(Seconds(static_cast<long long>(ops.size()) + 1), 0), 1LL);
+            ops.push_back(makeUpdateDocumentOplogEntry(
+                opTime, nss, BSON("_id" << id), BSON("$set" << BSON("x" << update))));
+        }
+    }
+
+    auto lastOpTime =
+        unittest::assertGet(multiApply(_txn.get(), &writerPool, ops, applyOperationFn));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    // Every operation is applied exactly once, and all the operations on a document are applied
+    // by the same call in the order they appear in the batch.
+    stdx::lock_guard<stdx::mutex> lock(mutex);
+    std::map<int, size_t> callForDoc;
+    std::map<int, std::vector<OpTime>> opTimesForDoc;
+    size_t numApplied = 0;
+    for (size_t call = 0; call < operationsApplied.size(); ++call) {
+        for (auto&& op : operationsApplied[call]) {
+            const int id = op.getIdElement().numberInt();
+            auto inserted = callForDoc.emplace(id, call);
+            ASSERT_EQUALS(call, inserted.first->second);
+            opTimesForDoc[id].push_back(op.getOpTime());
+            ++numApplied;
+        }
+    }
+    ASSERT_EQUALS(ops.size(), numApplied);
+    ASSERT_EQUALS(static_cast<size_t>(numDocs), opTimesForDoc.size());
+    for (auto&& entry : opTimesForDoc) {
+        ASSERT_EQUALS(static_cast<size_t>(numUpdatesPerDoc), entry.second.size());
+        ASSERT_TRUE(std::is_sorted(entry.second.begin(), entry.second.end()));
+    }
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesSyncApplyToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
     auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
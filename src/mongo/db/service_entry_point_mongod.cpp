@@ -93,6 +93,16 @@ using transport::TransportLayer;
 ServiceEntryPointMongod::ServiceEntryPointMongod(TransportLayer* tl) : _tl(tl) {}
 
 void ServiceEntryPointMongod::startSession(Session&& session) {
+    if (session.getTransportLayer()->supportsAsyncWait()) {
+        launchAsyncServiceEntryWorker(std::move(session), [this](Session* session, Message* m) {
+            _nWorkers.fetchAndAdd(1);
+            auto guard = MakeGuard([&] { _nWorkers.fetchAndSubtract(1); });
+
+            _handleMessage(session, m);
+        });
+        return;
+    }
+
     launchWrappedServiceEntryWorkerThread(std::move(session), [this](Session* session) {
         _nWorkers.fetchAndAdd(1);
         auto guard = MakeGuard([&] { _nWorkers.fetchAndSubtract(1); });
@@ -103,59 +113,64 @@ void ServiceEntryPointMongod::startSession(Session&& session) {
 
 void ServiceEntryPointMongod::_sessionLoop(Session* session) {
     Message inMessage;
-    bool inExhaust = false;
     int64_t counter = 0;
 
     while (true) {
-        // 1. Source a Message from the client (unless we are exhausting)
-        if (!inExhaust) {
-            inMessage.reset();
-            auto status = session->sourceMessage(&inMessage).wait();
+        // 1. Source a Message from the client
+        inMessage.reset();
+        auto status = session->sourceMessage(&inMessage).wait();
 
-            if (ErrorCodes::isInterruption(status.code()) ||
-                ErrorCodes::isNetworkError(status.code())) {
-                break;
-            }
+        if (ErrorCodes::isInterruption(status.code()) ||
+            ErrorCodes::isNetworkError(status.code())) {
+            break;
+        }
 
-            // Our session may have been closed internally.
-            if (status == TransportLayer::TicketSessionClosedStatus) {
-                break;
-            }
+        // Our session may have been closed internally.
+        if (status == TransportLayer::TicketSessionClosedStatus) {
+            break;
+        }
 
-            uassertStatusOK(status);
+        uassertStatusOK(status);
+
+        // 2. Handle it, and any exhaust Messages that follow from it
+        _handleMessage(session, &inMessage);
+
+        if ((counter++ & 0xf) == 0) {
+            markThreadIdle();
         }
+    }
+}
 
-        // 2. Pass sourced Message up to mongod
+void ServiceEntryPointMongod::_handleMessage(Session* session, Message* inMessage) {
+    while (true) {
+        // 1. Pass the sourced Message up to mongod
         DbResponse dbresponse;
         {
             auto opCtx = cc().makeOperationContext();
-            assembleResponse(opCtx.get(), inMessage, dbresponse, session->remote());
+            assembleResponse(opCtx.get(), *inMessage, dbresponse, session->remote());
 
             // opCtx must go out of scope here so that the operation cannot show
             // up in currentOp results after the response reaches the client
         }
 
-        // 3. Format our response, if we have one
+        // 2. Format our response, if we have one
         Message& toSink = dbresponse.response;
-        if (!toSink.empty()) {
-            toSink.header().setId(nextMessageId());
-            toSink.header().setResponseToMsgId(inMessage.header().getId());
-
-            // If this is an exhaust cursor, don't source more Messages
-            if (dbresponse.exhaustNS.size() > 0 && setExhaustMessage(&inMessage, dbresponse)) {
-                inExhaust = true;
-            } else {
-                inExhaust = false;
-            }
-
-            // 4. Sink our response to the client
-            uassertStatusOK(session->sinkMessage(toSink).wait());
-        } else {
-            inExhaust = false;
+        if (toSink.empty()) {
+            return;
         }
 
-        if ((counter++ & 0xf) == 0) {
-            markThreadIdle();
+        toSink.header().setId(nextMessageId());
+        toSink.header().setResponseToMsgId(inMessage->header().getId());
+
+        // If this is an exhaust cursor, keep handling getMores without sourcing more Messages
+        const bool inExhaust =
+            dbresponse.exhaustNS.size() > 0 && setExhaustMessage(inMessage, dbresponse);
+
+        // 3. Sink our response to the client
+        uassertStatusOK(session->sinkMessage(toSink).wait());
+
+        if (!inExhaust) {
+            return;
         }
     }
 }
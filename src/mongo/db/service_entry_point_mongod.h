@@ -36,6 +36,8 @@
 
 namespace mongo {
 
+class Message;
+
 namespace transport {
 class Session;
 class TransportLayer;
@@ -43,7 +45,9 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongod. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the
+ * TransportLayer supports asyncWait(), in which case idle sessions hold no thread and Messages
+ * are handled on the TransportLayer's request pool.
  */
 class ServiceEntryPointMongod final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongod);
@@ -62,6 +66,12 @@ public:
 private:
     void _sessionLoop(transport::Session* session);
 
+    /**
+     * Runs a single Message sourced from 'session' and sinks the response, including any
+     * further responses for an exhaust cursor.
+     */
+    void _handleMessage(transport::Session* session, Message* inMessage);
+
     transport::TransportLayer* _tl;
     AtomicWord<std::size_t> _nWorkers;
 };
@@ -48,8 +48,12 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <cstring>
+#include <exception>
 #include <snappy.h>
+#include <system_error>
 #include <vector>
+#include <zlib.h>
 
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
@@ -59,6 +63,9 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/mongos_options.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/destructor_guard.h"
@@ -132,6 +139,179 @@ private:
     const std::string _fileName;
 };
 
+/**
+ * Fewest items given to each thread when sorting in parallel. Smaller inputs use fewer threads.
+ */
+const size_t kMinItemsPerSortThread = 1024;
+
+/**
+ * Runs task(0) through task(numTasks - 1) on up to 'numThreads' threads, one of which is the
+ * calling thread, and returns once they have all finished. If a task throws, the tasks not yet
+ * started are skipped and the first exception is rethrown on the calling thread.
+ */
+inline void runTasks(size_t numThreads,
+                     size_t numTasks,
+                     const stdx::function<void(size_t)>& task) {
+    AtomicUInt64 nextTask;
+    AtomicUInt32 failed;
+    stdx::mutex mutex;
+    std::exception_ptr firstException;
+
+    auto worker = [&] {
+        for (size_t i = nextTask.fetchAndAdd(1); i < numTasks && !failed.load();
+             i = nextTask.fetchAndAdd(1)) {
+            try {
+                task(i);
+            } catch (...) {
+                stdx::lock_guard<stdx::mutex> lk(mutex);
+                if (!firstException)
+                    firstException = std::current_exception();
+                failed.store(1);
+            }
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 1; i < std::min(numThreads, numTasks); i++) {
+        try {
+            threads.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;  // Make do with the threads we already have.
+        }
+    }
+    worker();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    if (firstException)
+        std::rethrow_exception(firstException);
+}
+
+/**
+ * Stable sorts [begin, end) on up to 'numThreads' threads by sorting one slice per thread and
+ * then merging neighbouring slices in rounds that also run in parallel.
+ */
+template <typename RandomIt, typename Less>
+void parallelStableSort(RandomIt begin, RandomIt end, const Less& less, size_t numThreads) {
+    const size_t size = end - begin;
+    const size_t numSlices = std::min(numThreads, size / kMinItemsPerSortThread);
+    if (numSlices < 2) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= numSlices; i++) {
+        bounds.push_back(size * i / numSlices);
+    }
+
+    runTasks(numThreads, numSlices, [&](size_t i) {
+        std::stable_sort(begin + bounds[i], begin + bounds[i + 1], less);
+    });
+
+    while (bounds.size() > 2) {
+        runTasks(numThreads, (bounds.size() - 1) / 2, [&](size_t i) {
+            std::inplace_merge(
+                begin + bounds[2 * i], begin + bounds[2 * i + 1], begin + bounds[2 * i + 2], less);
+        });
+
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != size)
+            merged.push_back(size);
+        bounds.swap(merged);
+    }
+}
+
+/**
+ * Compresses the 'size' bytes at 'data' into 'out'. Returns false if the block should be stored
+ * uncompressed instead, either because 'compressor' is kNone or because it didn't shrink enough.
+ *
+ * A zlib block starts with its uncompressed size, since zlib doesn't record it.
+ */
+inline bool compressBlock(SorterCompressor compressor,
+                          const char* data,
+                          size_t size,
+                          std::string* out) {
+    switch (compressor) {
+        case SorterCompressor::kNone:
+            return false;
+        case SorterCompressor::kSnappy:
+            snappy::Compress(data, size, out);
+            break;
+        case SorterCompressor::kZlib: {
+            const int32_t uncompressedSize = size;
+            uLongf compressedSize = ::compressBound(size);
+            out->resize(sizeof(uncompressedSize) + compressedSize);
+            memcpy(&(*out)[0], &uncompressedSize, sizeof(uncompressedSize));
+            const int ret =
+                ::compress2(reinterpret_cast<Bytef*>(&(*out)[sizeof(uncompressedSize)]),
+                            &compressedSize,
+                            reinterpret_cast<const Bytef*>(data),
+                            size,
+                            Z_BEST_SPEED);
+            massert(40317,
+                    str::stream() << "zlib compression failed with error " << ret,
+                    ret == Z_OK);
+            out->resize(sizeof(uncompressedSize) + compressedSize);
+            break;
+        }
+    }
+    verify(out->size() <= size_t(std::numeric_limits<int32_t>::max()));
+    return out->size() < size / 10 * 9;
+}
+
+/**
+ * Reverses compressBlock(), returning the uncompressed block and setting '*uncompressedSize'.
+ */
+inline std::unique_ptr<char[]> uncompressBlock(SorterCompressor compressor,
+                                               const char* data,
+                                               size_t size,
+                                               size_t* uncompressedSize) {
+    std::unique_ptr<char[]> out;
+    switch (compressor) {
+        case SorterCompressor::kNone:
+            msgasserted(40318, "found a compressed block in an uncompressed file");
+        case SorterCompressor::kSnappy:
+            dassert(snappy::IsValidCompressedBuffer(data, size));
+
+            massert(17061,
+                    "couldn't get uncompressed length",
+                    snappy::GetUncompressedLength(data, size, uncompressedSize));
+
+            out.reset(new char[*uncompressedSize]);
+            massert(17062, "decompression failed", snappy::RawUncompress(data, size, out.get()));
+            break;
+        case SorterCompressor::kZlib: {
+            int32_t expectedSize;
+            massert(40319, "file too short?", size >= sizeof(expectedSize));
+            memcpy(&expectedSize, data, sizeof(expectedSize));
+
+            // A block is written from a BufBuilder, so it can never have been larger than one.
+            massert(40324,
+                    str::stream() << "invalid uncompressed block size " << expectedSize,
+                    expectedSize >= 0 && expectedSize <= BufferMaxSize);
+
+            out.reset(new char[expectedSize]);
+            uLongf outSize = expectedSize;
+            const Bytef* compressed = reinterpret_cast<const Bytef*>(data + sizeof(expectedSize));
+            const int ret = ::uncompress(reinterpret_cast<Bytef*>(out.get()),
+                                         &outSize,
+                                         compressed,
+                                         size - sizeof(expectedSize));
+            massert(40320,
+                    str::stream() << "decompression failed with zlib error " << ret,
+                    ret == Z_OK && outSize == uLongf(expectedSize));
+            *uncompressedSize = outSize;
+            break;
+        }
+    }
+    return out;
+}
+
 /** Returns results from sorted in-memory storage */
 template <typename Key, typename Value>
 class InMemIterator : public SortIteratorInterface<Key, Value> {
@@ -172,8 +352,10 @@ public:
 
     FileIterator(const std::string& fileName,
                  const Settings& settings,
+                 SorterCompressor compressor,
                  std::shared_ptr<FileDeleter> fileDeleter)
         : _settings(settings),
+          _compressor(compressor),
           _done(false),
           _fileName(fileName),
           _fileDeleter(fileDeleter),
@@ -247,17 +429,9 @@ private:
             return;
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
-
         size_t uncompressedSize;
-        massert(17061,
-                "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
-
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
-        massert(17062,
-                "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+        std::unique_ptr<char[]> decompressionBuffer =
+            uncompressBlock(_compressor, _buffer.get(), blockSize, &uncompressedSize);
 
         // hold on to decompressed data and throw out compressed data at block exit
         _buffer.swap(decompressionBuffer);
@@ -281,6 +455,7 @@ private:
     }
 
     const Settings _settings;
+    const SorterCompressor _compressor;
     bool _done;
     std::unique_ptr<char[]> _buffer;
     std::unique_ptr<BufReader> _reader;
@@ -413,6 +588,48 @@ private:
     STLComparator _greater;                      // named so calls make sense
 };
 
+/**
+ * Returns an iterator over the merge of the sorted 'runs'. While there are more than
+ * opts.mergeFanIn runs, groups of at most opts.mergeFanIn neighbouring runs are merged into new
+ * runs on disk, on up to opts.numThreads threads at once, so that the final merge never has more
+ * than opts.mergeFanIn inputs. Groups keep the order of their runs, so equal items come out in the
+ * order they were added.
+ */
+template <typename Key, typename Value, typename Comparator>
+SortIteratorInterface<Key, Value>* mergeRuns(
+    std::vector<std::shared_ptr<SortIteratorInterface<Key, Value>>> runs,
+    const SortOptions& opts,
+    const Comparator& comp,
+    const typename SortedFileWriter<Key, Value>::Settings& settings) {
+    typedef SortIteratorInterface<Key, Value> Iterator;
+
+    while (opts.mergeFanIn >= 2 && runs.size() > opts.mergeFanIn) {
+        const size_t numGroups = (runs.size() + opts.mergeFanIn - 1) / opts.mergeFanIn;
+
+        std::vector<std::unique_ptr<SortedFileWriter<Key, Value>>> writers;
+        for (size_t i = 0; i < numGroups; i++) {
+            writers.emplace_back(new SortedFileWriter<Key, Value>(opts, settings));
+        }
+
+        std::vector<std::shared_ptr<Iterator>> merged(numGroups);
+        runTasks(opts.numThreads, numGroups, [&](size_t i) {
+            std::vector<std::shared_ptr<Iterator>> group(runs.begin() + runs.size() * i / numGroups,
+                                                         runs.begin() +
+                                                             runs.size() * (i + 1) / numGroups);
+            MergeIterator<Key, Value, Comparator> groupIt(group, opts, comp);
+            while (groupIt.more()) {
+                const std::pair<Key, Value> data = groupIt.next();
+                writers[i]->addAlreadySorted(data.first, data.second);
+            }
+            merged[i].reset(writers[i]->done());
+        });
+
+        runs.swap(merged);
+    }
+
+    return Iterator::merge(runs, opts, comp);
+}
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -446,7 +663,7 @@ public:
         }
 
         spill();
-        return Iterator::merge(_iters, _opts, _comp);
+        return mergeRuns(_iters, _opts, _comp, _settings);
     }
 
     // TEMP these are here for compatibility. Will be replaced with a general stats API
@@ -472,7 +689,7 @@ private:
 
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        parallelStableSort(_data.begin(), _data.end(), less, _opts.numThreads);
 
         // Does 2x more compares than stable_sort
         // TODO test on windows
@@ -496,14 +713,39 @@ private:
                           << " Pass allowDiskUse:true to opt in.");
         }
 
-        sort();
+        const size_t numRuns = std::min(_opts.numThreads, _data.size() / kMinItemsPerSortThread);
+        if (numRuns < 2) {
+            sort();
 
-        SortedFileWriter<Key, Value> writer(_opts, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
-        }
+            SortedFileWriter<Key, Value> writer(_opts, _settings);
+            for (; !_data.empty(); _data.pop_front()) {
+                writer.addAlreadySorted(_data.front().first, _data.front().second);
+            }
 
-        _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
+            _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
+        } else {
+            // Each thread sorts a slice of _data and writes it to a run of its own. The runs are
+            // stored in the order of their slices, so merging them keeps the sort stable.
+            std::vector<std::unique_ptr<SortedFileWriter<Key, Value>>> writers;
+            for (size_t i = 0; i < numRuns; i++) {
+                writers.emplace_back(new SortedFileWriter<Key, Value>(_opts, _settings));
+            }
+
+            std::vector<std::shared_ptr<Iterator>> runs(numRuns);
+            STLComparator less(_comp);
+            runTasks(_opts.numThreads, numRuns, [&](size_t i) {
+                auto begin = _data.begin() + _data.size() * i / numRuns;
+                auto end = _data.begin() + _data.size() * (i + 1) / numRuns;
+                std::stable_sort(begin, end, less);
+                for (; begin != end; ++begin) {
+                    writers[i]->addAlreadySorted(begin->first, begin->second);
+                }
+                runs[i].reset(writers[i]->done());
+            });
+
+            _iters.insert(_iters.end(), runs.begin(), runs.end());
+            _data.clear();
+        }
 
         _memUsed = 0;
     }
@@ -645,7 +887,7 @@ public:
         }
 
         spill();
-        return Iterator::merge(_iters, _opts, _comp);
+        return mergeRuns(_iters, _opts, _comp, _settings);
     }
 
     // TEMP these are here for compatibility. Will be replaced with a general stats API
@@ -823,7 +1065,7 @@ inline unsigned nextFileNumber() {
 
 template <typename Key, typename Value>
 SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts, const Settings& settings)
-    : _settings(settings) {
+    : _settings(settings), _compressor(opts.spillCompressor) {
     namespace str = mongoutils::str;
 
     // This should be checked by consumers, but if we get here don't allow writes.
@@ -874,10 +1116,7 @@ void SortedFileWriter<Key, Value>::spill() {
         return;
 
     std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
-    verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
-
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = sorter::compressBlock(_compressor, outBuffer, size, &compressed);
     if (shouldCompress) {
         size = compressed.size();
         outBuffer = const_cast<char*>(compressed.data());
@@ -920,7 +1159,7 @@ template <typename Key, typename Value>
 SortIteratorInterface<Key, Value>* SortedFileWriter<Key, Value>::done() {
     spill();
     _file.close();
-    return new sorter::FileIterator<Key, Value>(_fileName, _settings, _fileDeleter);
+    return new sorter::FileIterator<Key, Value>(_fileName, _settings, _compressor, _fileDeleter);
 }
 
 //
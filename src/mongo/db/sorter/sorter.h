@@ -36,6 +36,8 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
 #include "mongo/bson/util/builder.h"
 
 /**
@@ -81,6 +83,10 @@
  *     }
  *     Ordering _ord;
  * };
+ *
+ * When SortOptions::numThreads is greater than 1, the Sorter calls the comparator and the const
+ * members above from several threads at once, each on different objects. Copies of a Key or Value
+ * may therefore be used on one thread while the object they were copied from is used on another.
  */
 
 namespace mongo {
@@ -89,6 +95,27 @@ namespace sorter {
 class FileDeleter;
 }
 
+/**
+ * How the blocks of a spilled run are compressed on disk. Blocks that do not shrink by at least
+ * 10% are always stored uncompressed.
+ */
+enum class SorterCompressor { kNone, kSnappy, kZlib };
+
+/**
+ * Parses the name of a SorterCompressor: "none", "snappy" or "zlib".
+ */
+inline StatusWith<SorterCompressor> parseSorterCompressor(StringData name) {
+    if (name == "none")
+        return SorterCompressor::kNone;
+    if (name == "snappy")
+        return SorterCompressor::kSnappy;
+    if (name == "zlib")
+        return SorterCompressor::kZlib;
+    return {ErrorCodes::BadValue,
+            "unknown sorter spill compressor '" + name.toString() +
+                "', expected one of 'none', 'snappy' or 'zlib'"};
+}
+
 /**
  * Runtime options that control the Sorter's behavior
  */
@@ -98,8 +125,17 @@ struct SortOptions {
     bool extSortAllowed;         /// If false, uassert if more mem needed than allowed.
     std::string tempDir;         /// Directory to directly place files in.
                                  /// Must be explicitly set if extSortAllowed is true.
-
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    size_t numThreads;           /// Threads used to sort and merge runs. 1 sorts on the caller.
+    size_t mergeFanIn;           /// Most runs merged at once. 0 merges all runs in one pass.
+    SorterCompressor spillCompressor;  /// Compression of spilled runs.
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          numThreads(1),
+          mergeFanIn(0),
+          spillCompressor(SorterCompressor::kSnappy) {}
 
     /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -122,6 +158,21 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& NumThreads(size_t newNumThreads) {
+        numThreads = newNumThreads;
+        return *this;
+    }
+
+    SortOptions& MergeFanIn(size_t newMergeFanIn) {
+        mergeFanIn = newMergeFanIn;
+        return *this;
+    }
+
+    SortOptions& SpillCompressor(SorterCompressor newSpillCompressor) {
+        spillCompressor = newSpillCompressor;
+        return *this;
+    }
 };
 
 /// This is the output from the sorting framework
@@ -200,6 +251,7 @@ private:
     void spill();
 
     const Settings _settings;
+    const SorterCompressor _compressor;
     std::string _fileName;
     std::shared_ptr<sorter::FileDeleter> _fileDeleter;  // Must outlive _file
     std::ofstream _file;
@@ -279,6 +279,43 @@ public:
     }
 };
 
+class SpillCompressorTests {
+public:
+    void run() {
+        ASSERT(SorterCompressor::kNone == unittest::assertGet(parseSorterCompressor("none")));
+        ASSERT(SorterCompressor::kSnappy == unittest::assertGet(parseSorterCompressor("snappy")));
+        ASSERT(SorterCompressor::kZlib == unittest::assertGet(parseSorterCompressor("zlib")));
+        ASSERT_NOT_OK(parseSorterCompressor("zstd").getStatus());
+
+        unittest::TempDir tempDir("spillCompressorTests");
+        const SorterCompressor compressors[] = {
+            SorterCompressor::kNone, SorterCompressor::kSnappy, SorterCompressor::kZlib};
+        for (auto compressor : compressors) {
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(
+                SortOptions().TempDir(tempDir.path()).SpillCompressor(compressor));
+            for (int i = 0; i < 1000 * 1000; i++)
+                sorter.addAlreadySorted(i, -i);
+
+            ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
+                                        make_shared<IntIterator>(0, 1000 * 1000));
+        }
+
+        ASSERT(boost::filesystem::is_empty(tempDir.path()));
+
+        // A zlib block whose recorded size is corrupt is rejected before it is allocated.
+        const int32_t badSizes[] = {-1, BufferMaxSize + 1};
+        for (auto badSize : badSizes) {
+            char block[sizeof(badSize) + 8] = {};
+            memcpy(block, &badSize, sizeof(badSize));
+            size_t uncompressedSize;
+            ASSERT_THROWS_CODE(
+                sorter::uncompressBlock(
+                    SorterCompressor::kZlib, block, sizeof(block), &uncompressedSize),
+                MsgAssertionException,
+                40324);
+        }
+    }
+};
 
 class MergeIteratorTests {
 public:
@@ -524,6 +561,8 @@ public:
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
+
+public:
     SortOptions adjustSortOptions(SortOptions opts) {
         // Make sure our tests will spill or not as desired
         MONGO_STATIC_ASSERT(MEM_LIMIT / 2 > (100 * sizeof(IWPair)));
@@ -544,6 +583,35 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <bool Random = true>
+class ParallelLotsOfDataLittleMemory : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) {
+        // Each spill writes one run per thread, and the runs are merged 8 at a time.
+        return Parent::adjustSortOptions(opts).NumThreads(4).MergeFanIn(8).SpillCompressor(
+            SorterCompressor::kZlib);
+    }
+};
+
+template <bool Random = true>
+class ParallelLotsOfDataInMemory : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) {
+        // Make sure everything is sorted in memory
+        MONGO_STATIC_ASSERT(Parent::NUM_ITEMS * sizeof(IWPair) < 64 * 1024 * 1024);
+
+        return opts.MaxMemoryUsageBytes(64 * 1024 * 1024).NumThreads(4);
+    }
+};
+
+template <long long Limit>
+class ParallelLotsOfDataWithLimit : public LotsOfDataWithLimit<Limit> {
+    typedef LotsOfDataWithLimit<Limit> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return Parent::adjustSortOptions(opts).NumThreads(4).MergeFanIn(8);
+    }
+};
 }
 
 class SorterSuite : public mongo::unittest::Suite {
@@ -553,6 +621,7 @@ public:
     void setupTests() {
         add<InMemIterTests>();
         add<SortedFileWriterAndFileIteratorTests>();
+        add<SpillCompressorTests>();
         add<MergeIteratorTests>();
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
@@ -565,6 +634,10 @@ public:
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::ParallelLotsOfDataLittleMemory</*random=*/false>>();
+        add<SorterTests::ParallelLotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::ParallelLotsOfDataInMemory</*random=*/true>>();
+        add<SorterTests::ParallelLotsOfDataWithLimit<5000>>();  // spills
     }
 };
 
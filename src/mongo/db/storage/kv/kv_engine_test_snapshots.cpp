@@ -31,6 +31,7 @@
 #include <memory>
 #include <string>
 
+#include "mongo/bson/mutable/damage_vector.h"
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/service_context_noop.h"
 #include "mongo/db/storage/kv/kv_engine.h"
@@ -126,6 +127,24 @@ public:
         wuow.commit();
     }
 
+    /**
+     * Overwrites the bytes of record 'id' starting at 'offset' with 'replacement' using
+     * updateWithDamages().
+     */
+    void updateRecordWithDamagesAndCommit(RecordId id, size_t offset, std::string replacement) {
+        auto op = makeOperation();
+        WriteUnitOfWork wuow(op);
+        RecordData oldRec = rs->dataFor(op, id).getOwned();
+        mutablebson::DamageVector damages;
+        mutablebson::DamageEvent damage;
+        damage.sourceOffset = 0;
+        damage.targetOffset = offset;
+        damage.size = replacement.size();
+        damages.push_back(damage);
+        ASSERT_OK(rs->updateWithDamages(op, id, oldRec, replacement.c_str(), damages).getStatus());
+        wuow.commit();
+    }
+
     void deleteRecordAndCommit(RecordId id) {
         auto op = makeOperation();
         WriteUnitOfWork wuow(op);
@@ -335,8 +354,17 @@ TEST_F(SnapshotManagerTests, UpdateAndDelete) {
     updateRecordAndCommit(id, "Cat");
     auto snapCat = prepareAndCreateSnapshot();
 
-    // Untested since no engine currently supports both updateWithDamanges and snapshots.
-    ASSERT(!rs->updateWithDamagesSupported());
+    // Damage updates rewrite the record in place, so each snapshot taken around them must still
+    // see its own version.
+    boost::optional<SnapshotName> snapCow;
+    boost::optional<SnapshotName> snapCod;
+    if (rs->updateWithDamagesSupported()) {
+        updateRecordWithDamagesAndCommit(id, 1, "ow");
+        snapCow = prepareAndCreateSnapshot();
+
+        updateRecordWithDamagesAndCommit(id, 2, "d");
+        snapCod = prepareAndCreateSnapshot();
+    }
 
     deleteRecordAndCommit(id);
     auto snapAfterDelete = prepareAndCreateSnapshot();
@@ -353,6 +381,16 @@ TEST_F(SnapshotManagerTests, UpdateAndDelete) {
     ASSERT_EQ(itCountCommitted(), 1);
     ASSERT_EQ(readStringCommitted(id), "Cat");
 
+    if (snapCow) {
+        snapshotManager->setCommittedSnapshot(*snapCow);
+        ASSERT_EQ(itCountCommitted(), 1);
+        ASSERT_EQ(readStringCommitted(id), "Cow");
+
+        snapshotManager->setCommittedSnapshot(*snapCod);
+        ASSERT_EQ(itCountCommitted(), 1);
+        ASSERT_EQ(readStringCommitted(id), "Cod");
+    }
+
     snapshotManager->setCommittedSnapshot(snapAfterDelete);
     ASSERT_EQ(itCountCommitted(), 0);
     ASSERT(!readRecordCommitted(id));
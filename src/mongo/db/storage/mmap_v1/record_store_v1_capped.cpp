@@ -593,7 +593,7 @@ std::unique_ptr<SeekableRecordCursor> CappedRecordStoreV1::getCursor(OperationCo
 }
 
 vector<std::unique_ptr<RecordCursor>> CappedRecordStoreV1::getManyCursors(
-    OperationContext* txn) const {
+    OperationContext* txn, size_t numCursorsHint) const {
     vector<std::unique_ptr<RecordCursor>> cursors;
 
     if (!_details->capLooped()) {
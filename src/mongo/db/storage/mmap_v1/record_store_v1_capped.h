@@ -67,7 +67,8 @@ public:
     std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* txn,
                                                     bool forward) const final;
 
-    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn) const final;
+    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn,
+                                                              size_t numCursorsHint) const final;
 
     // Start from firstExtent by default.
     DiskLoc firstRecord(OperationContext* txn, const DiskLoc& startExtent = DiskLoc()) const;
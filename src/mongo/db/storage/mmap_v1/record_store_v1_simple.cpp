@@ -242,7 +242,7 @@ std::unique_ptr<SeekableRecordCursor> SimpleRecordStoreV1::getCursor(OperationCo
 }
 
 vector<std::unique_ptr<RecordCursor>> SimpleRecordStoreV1::getManyCursors(
-    OperationContext* txn) const {
+    OperationContext* txn, size_t numCursorsHint) const {
     vector<std::unique_ptr<RecordCursor>> cursors;
     const Extent* ext;
     for (DiskLoc extLoc = details()->firstExtent(txn); !extLoc.isNull(); extLoc = ext->xnext) {
@@ -56,7 +56,8 @@ public:
     std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* txn,
                                                     bool forward) const final;
 
-    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn) const final;
+    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn,
+                                                              size_t numCursorsHint) const final;
 
     virtual Status truncate(OperationContext* txn);
 
@@ -491,8 +491,12 @@ public:
     /**
      * Returns many RecordCursors that partition the RecordStore into many disjoint sets.
      * Iterating all returned RecordCursors is equivalent to iterating the full store.
+     *
+     * 'numCursorsHint' is the number of cursors the caller would like to iterate in parallel.
+     * Implementations are free to return more or fewer cursors than requested.
      */
-    virtual std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn) const {
+    virtual std::vector<std::unique_ptr<RecordCursor>> getManyCursors(
+        OperationContext* txn, size_t numCursorsHint) const {
         std::vector<std::unique_ptr<RecordCursor>> out(1);
         out[0] = getCursor(txn);
         return out;
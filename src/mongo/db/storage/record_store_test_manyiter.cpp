@@ -59,7 +59,7 @@ TEST(RecordStoreTestHarness, GetManyIteratorsEmpty) {
 
     {
         ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
-        for (auto&& cursor : rs->getManyCursors(opCtx.get())) {
+        for (auto&& cursor : rs->getManyCursors(opCtx.get(), 4)) {
             ASSERT(!cursor->next());
             ASSERT(!cursor->next());
         }
@@ -102,7 +102,7 @@ TEST(RecordStoreTestHarness, GetManyIteratorsNonEmpty) {
     set<RecordId> remain(locs, locs + nToInsert);
     {
         ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
-        for (auto&& cursor : rs->getManyCursors(opCtx.get())) {
+        for (auto&& cursor : rs->getManyCursors(opCtx.get(), 4)) {
             while (auto record = cursor->next()) {
                 ASSERT_EQ(remain.erase(record->id), size_t(1));
             }
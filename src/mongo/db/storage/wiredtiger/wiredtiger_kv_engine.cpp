@@ -64,11 +64,13 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/concurrency/ticketholder_tuner.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 #if !defined(__has_feature)
 #define __has_feature(x) 0
@@ -169,8 +171,75 @@ TicketHolder openReadTransaction(128);
 TicketServerParameter openReadTransactionParam(&openReadTransaction,
                                                "wiredTigerConcurrentReadTransactions");
 
+// When set, the sizes given by the two parameters above are only starting points, and the ticket
+// pools are resized continuously according to the throughput and latency they deliver.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactions, bool, false);
+
+TicketHolderTuner::Options makeTunerOptions(const TicketHolder& holder) {
+    // Let the pool shrink well below, and grow well above, the configured size.
+    const int initialSize = holder.outof();
+    TicketHolderTuner::Options options;
+    options.minTickets = std::min(options.minTickets, initialSize);
+    options.maxTickets = 4 * initialSize;
+    return options;
+}
+
 }  // namespace
 
+class WiredTigerKVEngine::WiredTigerTicketTuner : public BackgroundJob {
+public:
+    WiredTigerTicketTuner()
+        : BackgroundJob(false /* deleteSelf */),
+          _readTuner(&openReadTransaction, makeTunerOptions(openReadTransaction)),
+          _writeTuner(&openWriteTransaction, makeTunerOptions(openWriteTransaction)) {}
+
+    virtual string name() const {
+        return "WTTicketTuner";
+    }
+
+    virtual void run() {
+        LOG(1) << "starting " << name() << " thread";
+
+        Timer interval;
+        while (!_shuttingDown.load()) {
+            sleepmillis(kSamplePeriodMillis);
+            _readTuner.sample();
+            _writeTuner.sample();
+
+            const long long elapsedMicros = interval.micros();
+            if (elapsedMicros >= kTuningPeriodMillis * 1000) {
+                _readTuner.tune(elapsedMicros);
+                _writeTuner.tune(elapsedMicros);
+                interval.reset();
+            }
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+    void appendReadStats(BSONObjBuilder* builder) const {
+        _readTuner.appendStats(builder);
+    }
+
+    void appendWriteStats(BSONObjBuilder* builder) const {
+        _writeTuner.appendStats(builder);
+    }
+
+private:
+    // The number of tickets in use is sampled this often, and the pools are resized based on
+    // what was seen over each tuning period.
+    static const int kSamplePeriodMillis = 10;
+    static const int kTuningPeriodMillis = 1000;
+
+    TicketHolderTuner _readTuner;
+    TicketHolderTuner _writeTuner;
+    std::atomic<bool> _shuttingDown{false};  // NOLINT
+};
+
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
                                        const std::string& path,
                                        ClockSource* cs,
@@ -276,6 +345,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sizeStorer->fillCache();
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
+
+    if (wiredTigerAdaptiveConcurrentTransactions) {
+        _ticketTuner = stdx::make_unique<WiredTigerTicketTuner>();
+        _ticketTuner->go();
+    }
 }
 
 
@@ -287,13 +361,17 @@ WiredTigerKVEngine::~WiredTigerKVEngine() {
     _sessionCache.reset(NULL);
 }
 
-void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
+void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) const {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
         BSONObjBuilder bbb(bb.subobjStart("write"));
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        if (_ticketTuner) {
+            BSONObjBuilder tunerBuilder(bbb.subobjStart("adaptive"));
+            _ticketTuner->appendWriteStats(&tunerBuilder);
+        }
         bbb.done();
     }
     {
@@ -301,6 +379,10 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        if (_ticketTuner) {
+            BSONObjBuilder tunerBuilder(bbb.subobjStart("adaptive"));
+            _ticketTuner->appendReadStats(&tunerBuilder);
+        }
         bbb.done();
     }
     bb.done();
@@ -314,6 +396,8 @@ void WiredTigerKVEngine::cleanShutdown() {
         // these must be the last things we do before _conn->close();
         if (_journalFlusher)
             _journalFlusher->shutdown();
+        if (_ticketTuner)
+            _ticketTuner->shutdown();
         _sizeStorer.reset();
         _sessionCache->shuttingDown();
 
@@ -149,10 +149,11 @@ public:
      */
     static bool initRsOplogBackgroundThread(StringData ns);
 
-    static void appendGlobalStats(BSONObjBuilder& b);
+    void appendGlobalStats(BSONObjBuilder& b) const;
 
 private:
     class WiredTigerJournalFlusher;
+    class WiredTigerTicketTuner;
 
     Status _salvageIfNeeded(const char* uri);
     void _checkIdentPath(StringData ident);
@@ -176,6 +177,7 @@ private:
     bool _ephemeral;
     bool _readOnly;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
+    std::unique_ptr<WiredTigerTicketTuner> _ticketTuner;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -87,6 +87,15 @@ bool shouldUseOplogHack(OperationContext* opCtx, const std::string& uri) {
     return (appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
 
+// The number of random samples taken per requested range when splitting a record store for
+// getManyCursors(). Oversampling keeps the ranges roughly equal in size despite skew in the
+// shape of the tree.
+const size_t kRandomSamplesPerRange = 10;
+
+// Record stores with fewer than this many records per requested range are scanned by a single
+// cursor, since the cost of sampling would outweigh any benefit from scanning in parallel.
+const int64_t kMinRecordsPerRange = 100;
+
 }  // namespace
 
 MONGO_FP_DECLARE(WTWriteConflictException);
@@ -438,6 +447,20 @@ public:
         _cursor.emplace(rs.getURI(), rs.tableId(), true, txn);
     }
 
+    /**
+     * Constructs a forward cursor that only returns records in the range [rangeStart, rangeEnd).
+     * A null RecordId leaves that side of the range unbounded.
+     */
+    Cursor(OperationContext* txn,
+           const WiredTigerRecordStore& rs,
+           const RecordId& rangeStart,
+           const RecordId& rangeEnd)
+        : Cursor(txn, rs, /*forward=*/true) {
+        invariant(rangeStart.isNull() || rangeEnd.isNull() || rangeStart < rangeEnd);
+        _rangeStart = rangeStart;
+        _rangeEnd = rangeEnd;
+    }
+
     boost::optional<Record> next() final {
         if (_eof)
             return {};
@@ -468,6 +491,21 @@ public:
             }
         }
 
+        if (_lastReturnedId.isNull() && !_rangeStart.isNull()) {
+            // Position the cursor at the first record in our range.
+            c->set_key(c, _makeKey(_rangeStart));
+            int cmp;
+            int seekRet = WT_OP_CHECK(c->search_near(c, &cmp));
+            if (seekRet == WT_NOTFOUND) {
+                _eof = true;
+                return {};
+            }
+            invariantWTOK(seekRet);
+
+            // If we landed before the start of the range, the next record is the first one in it.
+            mustAdvance = (cmp < 0);
+        }
+
         if (mustAdvance) {
             // Nothing after the next line can throw WCEs.
             // Note that an unpositioned (or eof) WT_CURSOR returns the first/last entry in the
@@ -502,6 +540,11 @@ public:
             throw WriteConflictException();
         }
 
+        if (!_rangeEnd.isNull() && id >= _rangeEnd) {
+            _eof = true;
+            return {};
+        }
+
         if (!isVisible(id)) {
             _eof = true;
             return {};
@@ -634,6 +677,10 @@ private:
     bool _eof = false;
     RecordId _lastReturnedId;  // If null, need to seek to first/last record.
     const RecordId _readUntilForOplog;
+
+    // Bounds of the range this cursor is restricted to. A null RecordId means unbounded.
+    RecordId _rangeStart;
+    RecordId _rangeEnd;
 };
 
 StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj options) {
@@ -1441,7 +1488,7 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* txn,
 }
 
 bool WiredTigerRecordStore::updateWithDamagesSupported() const {
-    return false;
+    return true;
 }
 
 StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
@@ -1450,7 +1497,35 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const RecordData& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
-    MONGO_UNREACHABLE;
+    // WiredTiger has no way to write part of a value, so the damages are applied to a copy of the
+    // old record which is then written back. This still spares the update framework from
+    // rebuilding the whole document, and since damages never change the size of the record there
+    // is no need to look up the old value or adjust the data size.
+    const int len = oldRec.size();
+    SharedBuffer data = SharedBuffer::allocate(len);
+    char* root = data.get();
+    std::memcpy(root, oldRec.data(), len);
+
+    mutablebson::DamageVector::const_iterator where = damages.begin();
+    const mutablebson::DamageVector::const_iterator end = damages.end();
+    for (; where != end; ++where) {
+        invariant(where->targetOffset + where->size <= static_cast<size_t>(len));
+        const char* sourcePtr = damageSource + where->sourceOffset;
+        char* targetPtr = root + where->targetOffset;
+        std::memcpy(targetPtr, sourcePtr, where->size);
+    }
+
+    WiredTigerCursor curwrap(_uri, _tableId, true, txn);
+    curwrap.assertInActiveTxn();
+    WT_CURSOR* c = curwrap.get();
+    invariant(c);
+    c->set_key(c, _makeKey(id));
+    WiredTigerItem value(root, len);
+    c->set_value(c, value.Get());
+    int ret = WT_OP_CHECK(c->insert(c));
+    invariantWTOK(ret);
+
+    return RecordData(std::move(data), len);
 }
 
 void WiredTigerRecordStore::_oplogSetStartHack(WiredTigerRecoveryUnit* wru) const {
@@ -1486,12 +1561,65 @@ std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursorWithOptions(
 }
 
 std::vector<std::unique_ptr<RecordCursor>> WiredTigerRecordStore::getManyCursors(
-    OperationContext* txn) const {
-    std::vector<std::unique_ptr<RecordCursor>> cursors(1);
-    cursors[0] = stdx::make_unique<Cursor>(txn, *this, /*forward=*/true);
+    OperationContext* txn, size_t numCursorsHint) const {
+    std::vector<std::unique_ptr<RecordCursor>> cursors;
+
+    // Capped collections rely on a single forward cursor to enforce their visibility rules, so
+    // they are never split.
+    const std::vector<RecordId> splitPoints =
+        _isCapped ? std::vector<RecordId>() : _sampleSplitPoints(txn, numCursorsHint);
+
+    RecordId rangeStart;
+    for (auto&& splitPoint : splitPoints) {
+        cursors.push_back(stdx::make_unique<Cursor>(txn, *this, rangeStart, splitPoint));
+        rangeStart = splitPoint;
+    }
+    cursors.push_back(stdx::make_unique<Cursor>(txn, *this, rangeStart, RecordId()));
     return cursors;
 }
 
+std::vector<RecordId> WiredTigerRecordStore::_sampleSplitPoints(OperationContext* txn,
+                                                                size_t numRanges) const {
+    if (numRanges <= 1 ||
+        numRecords(txn) < kMinRecordsPerRange * static_cast<int64_t>(numRanges)) {
+        return {};
+    }
+
+    // Inform the random cursor of the number of samples we intend to take. This allows it to
+    // account for skew in the tree shape.
+    const size_t numSamples = kRandomSamplesPerRange * numRanges;
+    const std::string extraConfig = str::stream() << "next_random_sample_size=" << numSamples;
+
+    auto cursor = getRandomCursorWithOptions(txn, extraConfig);
+    std::vector<RecordId> samples;
+    samples.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        samples.push_back(record->id);
+    }
+
+    if (samples.empty()) {
+        return {};
+    }
+
+    // Random cursors may return the same record more than once.
+    std::sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+
+    // Choose evenly spaced samples as the boundaries between consecutive ranges.
+    std::vector<RecordId> splitPoints;
+    for (size_t i = 1; i < numRanges; ++i) {
+        const RecordId& candidate = samples[i * samples.size() / numRanges];
+        if (splitPoints.empty() || splitPoints.back() < candidate) {
+            splitPoints.push_back(candidate);
+        }
+    }
+    return splitPoints;
+}
+
 Status WiredTigerRecordStore::truncate(OperationContext* txn) {
     WiredTigerCursor startWrap(_uri, _tableId, true, txn);
     WT_CURSOR* start = startWrap.get();
@@ -153,7 +153,12 @@ public:
     std::unique_ptr<RecordCursor> getRandomCursorWithOptions(OperationContext* txn,
                                                              StringData extraConfig) const;
 
-    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn) const final;
+    /**
+     * Splits non-capped record stores into up to 'numCursorsHint' disjoint RecordId ranges, using
+     * a random cursor to choose the split points.
+     */
+    std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* txn,
+                                                              size_t numCursorsHint) const final;
 
     virtual Status truncate(OperationContext* txn);
 
@@ -267,6 +272,13 @@ private:
     RecordData _getData(const WiredTigerCursor& cursor) const;
     void _oplogSetStartHack(WiredTigerRecoveryUnit* wru) const;
 
+    /**
+     * Returns at most 'numRanges' - 1 sorted, distinct RecordIds which divide the record store
+     * into approximately equally sized ranges. Returns an empty vector if the record store is too
+     * small to be worth splitting.
+     */
+    std::vector<RecordId> _sampleSplitPoints(OperationContext* txn, size_t numRanges) const;
+
     const std::string _uri;
     const uint64_t _tableId;  // not persisted
 
@@ -30,6 +30,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -983,6 +984,70 @@ TEST(WiredTigerRecordStoreTest, CappedCursorYieldFirst) {
     ASSERT(!cursor->next());
 }
 
+// Verify that getManyCursors() splits a large record store into disjoint ranges which together
+// cover every record exactly once.
+TEST(WiredTigerRecordStoreTest, GetManyCursorsSplitsIntoRanges) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore("a.b"));
+
+    const int nToInsert = 2000;
+    std::set<RecordId> remain;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < nToInsert; i++) {
+            stringstream ss;
+            ss << "record " << i;
+            string data = ss.str();
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, false);
+            ASSERT_OK(res.getStatus());
+            remain.insert(res.getValue());
+        }
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursors = rs->getManyCursors(opCtx.get(), 4);
+    ASSERT_GT(cursors.size(), 1U);
+    ASSERT_LTE(cursors.size(), 4U);
+
+    RecordId lastIdInPreviousRange;
+    for (auto&& cursor : cursors) {
+        RecordId lastId;
+        while (auto record = cursor->next()) {
+            ASSERT_GT(record->id, lastIdInPreviousRange);
+            ASSERT_GT(record->id, lastId);
+            ASSERT_EQ(remain.erase(record->id), size_t(1));
+            lastId = record->id;
+        }
+        ASSERT(!cursor->next());
+        if (!lastId.isNull()) {
+            lastIdInPreviousRange = lastId;
+        }
+    }
+    ASSERT(remain.empty());
+}
+
+// Small record stores should not be split.
+TEST(WiredTigerRecordStoreTest, GetManyCursorsSmallRecordStore) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore("a.b"));
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->insertRecord(opCtx.get(), "a", 2, false).getStatus());
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursors = rs->getManyCursors(opCtx.get(), 4);
+    ASSERT_EQ(cursors.size(), 1U);
+    ASSERT(cursors[0]->next());
+    ASSERT(!cursors[0]->next());
+}
+
 BSONObj makeBSONObjWithSize(const Timestamp& opTime, int size, char fill = 'x') {
     BSONObj objTemplate = BSON("ts" << opTime << "str"
                                     << "");
@@ -74,7 +74,12 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* txn,
         bob.append("reason", status.reason());
     }
 
-    WiredTigerKVEngine::appendGlobalStats(bob);
+    _engine->appendGlobalStats(bob);
+
+    {
+        BSONObjBuilder sessionCacheBuilder(bob.subobjStart("sessionCache"));
+        WiredTigerRecoveryUnit::get(txn)->getSessionCache()->appendStats(&sessionCacheBuilder);
+    }
 
     return bob.obj();
 }
@@ -36,6 +36,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -233,6 +234,13 @@ void WiredTigerSessionCache::closeAllCursors() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
+    for (auto&& partition : _partitions) {
+        scoped_spinlock lock(partition.lock);
+        for (auto&& session : partition.sessions) {
+            session->closeAllCursors();
+        }
+    }
+
     stdx::lock_guard<stdx::mutex> lock(_cacheLock);
     for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
         (*i)->closeAllCursors();
@@ -249,6 +257,15 @@ void WiredTigerSessionCache::closeAll() {
         _sessions.swap(swap);
     }
 
+    // releaseSession() checks the epoch while holding the lock of the partition it caches a
+    // session in, so once the epoch is bumped, emptying each partition under its lock leaves no
+    // session of an older epoch behind.
+    for (auto&& partition : _partitions) {
+        scoped_spinlock lock(partition.lock);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
+    }
+
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
         delete (*i);
     }
@@ -263,18 +280,43 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
+    // Look in this thread's partition first, then in the others, skipping any that are busy.
+    // Within a partition, take the most recently used session so that if we discard sessions,
+    // we're discarding older ones.
+    const unsigned ownPartition = getCounterPartitionForCurrentThread() % kNumSessionPartitions;
+    for (unsigned i = 0; i < kNumSessionPartitions; i++) {
+        SessionPartition& partition = _partitions[(ownPartition + i) % kNumSessionPartitions];
+        stdx::unique_lock<SpinLock> lock(partition.lock, stdx::try_to_lock);
+        if (!lock.owns_lock()) {
+            _partitionLockContended.increment();
+            continue;
+        }
+        if (!partition.sessions.empty()) {
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
+            lock.unlock();
+
+            if (i == 0) {
+                _sessionsFromOwnPartition.increment();
+            } else {
+                _sessionsFromOtherPartition.increment();
+            }
+            return UniqueWiredTigerSession(cachedSession);
+        }
+    }
+
     {
         stdx::lock_guard<stdx::mutex> lock(_cacheLock);
         if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
             WiredTigerSession* cachedSession = _sessions.back();
             _sessions.pop_back();
+            _sessionsFromOverflow.increment();
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
     // Outside of the cache partition lock, but on release will be put back on the cache
+    _sessionsOpened.increment();
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -318,10 +360,23 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     uint64_t currentEpoch = _epoch.load();
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
-            returnedToCache = true;
-            _sessions.push_back(session);
+        SessionPartition& partition =
+            _partitions[getCounterPartitionForCurrentThread() % kNumSessionPartitions];
+        stdx::unique_lock<SpinLock> partitionLock(partition.lock, stdx::try_to_lock);
+        if (partitionLock.owns_lock()) {
+            if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
+                returnedToCache = true;
+                partition.sessions.push_back(session);
+            }
+        } else {
+            // Rather than wait for the partition, put the session on the overflow list.
+            _partitionLockContended.increment();
+            stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+            if (session->_getEpoch() == _epoch.load()) {
+                returnedToCache = true;
+                _sessions.push_back(session);
+                _sessionsReleasedToOverflow.increment();
+            }
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -333,6 +388,14 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
         _engine->dropSomeQueuedIdents();
 }
 
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) const {
+    builder->append("sessionsFromOwnPartition", _sessionsFromOwnPartition.get());
+    builder->append("sessionsFromOtherPartition", _sessionsFromOtherPartition.get());
+    builder->append("sessionsFromOverflow", _sessionsFromOverflow.get());
+    builder->append("sessionsOpened", _sessionsOpened.get());
+    builder->append("sessionsReleasedToOverflow", _sessionsReleasedToOverflow.get());
+    builder->append("partitionLockContended", _partitionLockContended.get());
+}
 
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<stdx::mutex> lk(_journalListenerMutex);
@@ -33,6 +33,7 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
 #include <wiredtiger.h>
@@ -41,10 +42,12 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/partitioned_counter.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -204,7 +207,24 @@ public:
         return _cursorEpoch.load();
     }
 
+    /**
+     * Appends counters describing how sessions were obtained and returned, and how often the
+     * cache partitions were found busy, for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    // Idle sessions are spread over this many partitions. Each thread returns sessions to, and
+    // first looks for sessions in, the partition picked by getCounterPartitionForCurrentThread().
+    enum { kNumSessionPartitions = 16 };
+
+    // Best effort alignment so that each partition sits on its own cache line.
+    struct MONGO_COMPILER_ALIGN_TYPE(128) SessionPartition {
+        SpinLock lock;
+        std::vector<WiredTigerSession*> sessions;
+    };
+
+
     WiredTigerKVEngine* _engine;  // not owned, might be NULL
     WT_CONNECTION* _conn;         // not owned
     WiredTigerSnapshotManager _snapshotManager;
@@ -215,10 +235,25 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
+    // The partitions never block: a thread that finds one locked moves on to the next one, and
+    // returns its session to the overflow list under '_cacheLock' if its own partition is busy.
+    SessionPartition _partitions[kNumSessionPartitions];
+
     stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
     SessionCache _sessions;
 
+    // Where getSession() found a session to reuse, or that it had to open a new one.
+    PartitionedCounter64 _sessionsFromOwnPartition;
+    PartitionedCounter64 _sessionsFromOtherPartition;
+    PartitionedCounter64 _sessionsFromOverflow;
+    PartitionedCounter64 _sessionsOpened;
+
+    // Sessions releaseSession() put on the overflow list, and attempts to lock a partition that
+    // found it busy.
+    PartitionedCounter64 _sessionsReleasedToOverflow;
+    PartitionedCounter64 _partitionLockContended;
+
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
 
@@ -0,0 +1,116 @@
+// wiredtiger_session_cache_test.cpp
+
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerSessionCacheTest : public unittest::Test {
+public:
+    WiredTigerSessionCacheTest() : _dbpath("wt_test") {
+        int ret = wiredtiger_open(_dbpath.path().c_str(), NULL, "create,", &_conn);
+        ASSERT_OK(wtRCToStatus(ret));
+        _sessionCache.reset(new WiredTigerSessionCache(_conn));
+    }
+
+    ~WiredTigerSessionCacheTest() {
+        _sessionCache.reset();
+        _conn->close(_conn, NULL);
+    }
+
+    WiredTigerSessionCache* getSessionCache() {
+        return _sessionCache.get();
+    }
+
+    long long getStat(const std::string& name) {
+        BSONObjBuilder builder;
+        _sessionCache->appendStats(&builder);
+        return builder.obj()[name].numberLong();
+    }
+
+private:
+    unittest::TempDir _dbpath;
+    WT_CONNECTION* _conn = nullptr;
+    std::unique_ptr<WiredTigerSessionCache> _sessionCache;
+};
+
+TEST_F(WiredTigerSessionCacheTest, ReusesSessionReleasedOnSameThread) {
+    WiredTigerSession* first = getSessionCache()->getSession().get();
+    ASSERT_EQ(getStat("sessionsOpened"), 1);
+
+    UniqueWiredTigerSession second = getSessionCache()->getSession();
+    ASSERT_EQ(second.get(), first);
+    ASSERT_EQ(getStat("sessionsOpened"), 1);
+    ASSERT_EQ(getStat("sessionsFromOwnPartition"), 1);
+}
+
+TEST_F(WiredTigerSessionCacheTest, ReusesSessionReleasedOnAnotherThread) {
+    WiredTigerSession* released = nullptr;
+    stdx::thread thread([&] { released = getSessionCache()->getSession().get(); });
+    thread.join();
+
+    // The other thread returned its session to its own partition, which is found when this
+    // thread's partition turns out to be empty.
+    UniqueWiredTigerSession session = getSessionCache()->getSession();
+    ASSERT_EQ(session.get(), released);
+    ASSERT_EQ(getStat("sessionsOpened"), 1);
+    ASSERT_EQ(getStat("sessionsFromOwnPartition") + getStat("sessionsFromOtherPartition"), 1);
+}
+
+TEST_F(WiredTigerSessionCacheTest, CloseAllDiscardsCachedAndOutstandingSessions) {
+    // Leave one session cached and one outstanding across closeAll().
+    UniqueWiredTigerSession cached = getSessionCache()->getSession();
+    UniqueWiredTigerSession outstanding = getSessionCache()->getSession();
+    cached.reset();
+    ASSERT_EQ(getStat("sessionsOpened"), 2);
+
+    getSessionCache()->closeAll();
+    outstanding.reset();
+
+    // Neither session may be handed out again.
+    UniqueWiredTigerSession session = getSessionCache()->getSession();
+    UniqueWiredTigerSession another = getSessionCache()->getSession();
+    ASSERT_EQ(getStat("sessionsOpened"), 4);
+    ASSERT_EQ(getStat("sessionsFromOwnPartition") + getStat("sessionsFromOtherPartition"), 0);
+}
+
+}  // namespace
+}  // namespace mongo
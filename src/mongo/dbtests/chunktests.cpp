@@ -68,6 +68,7 @@ public:
         }
 
         _chunkRangeMap = _constructRanges(_chunkMap);
+        _routingIndex.assign(_chunkMap);
     }
 };
 
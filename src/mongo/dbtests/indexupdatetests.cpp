@@ -510,6 +510,82 @@ public:
     }
 };
 
+/** A foreground build generating keys on several threads indexes every document once. */
+class InsertBuildParallelKeyGeneration : public IndexBuildBase {
+public:
+    void run() {
+        // Enough documents for a few batches of key generation.
+        const int32_t nDocs = 40 * 1000;
+        int32_t nTagged = 0;
+        for (int32_t i = 0; i < nDocs; ++i) {
+            BSONObjBuilder doc;
+            doc.append("_id", i);
+            doc.append("a", i);
+            doc.append("tags", BSON_ARRAY(i % 7 << i % 11));
+            if (i % 2 == 0) {
+                doc.append("b", i);
+            }
+            _client.insert(_ns, doc.obj());
+            if (i % 7 == 3 || i % 11 == 3) {
+                ++nTagged;
+            }
+        }
+
+        MultiIndexBlock indexer(&_txn, collection());
+        indexer.setKeyGenerationThreads(4);
+
+        std::vector<BSONObj> specs;
+        specs.push_back(BSON("name"
+                             << "a_1"
+                             << "ns"
+                             << _ns
+                             << "key"
+                             << BSON("a" << 1)
+                             << "v"
+                             << static_cast<int>(kIndexVersion)));
+        specs.push_back(BSON("name"
+                             << "tags_1"
+                             << "ns"
+                             << _ns
+                             << "key"
+                             << BSON("tags" << 1)
+                             << "v"
+                             << static_cast<int>(kIndexVersion)));
+        specs.push_back(BSON("name"
+                             << "b_1"
+                             << "ns"
+                             << _ns
+                             << "key"
+                             << BSON("b" << 1)
+                             << "v"
+                             << static_cast<int>(kIndexVersion)
+                             << "partialFilterExpression"
+                             << BSON("b" << BSON("$exists" << true))));
+
+        ASSERT_OK(indexer.init(specs).getStatus());
+        ASSERT_OK(indexer.insertAllDocumentsInCollection());
+        {
+            WriteUnitOfWork wunit(&_txn);
+            indexer.commit();
+            wunit.commit();
+        }
+
+        IndexCatalog* catalog = collection()->getIndexCatalog();
+        ASSERT_FALSE(catalog->isMultikey(&_txn, catalog->findIndexByName(&_txn, "a_1")));
+        ASSERT_TRUE(catalog->isMultikey(&_txn, catalog->findIndexByName(&_txn, "tags_1")));
+
+        ASSERT_EQUALS(nDocs,
+                      _client.query(_ns, Query(BSON("a" << GTE << 0)).hint(BSON("a" << 1)))
+                          ->itcount());
+        ASSERT_EQUALS(nTagged,
+                      _client.query(_ns, Query(BSON("tags" << 3)).hint(BSON("tags" << 1)))
+                          ->itcount());
+        ASSERT_EQUALS(nDocs / 2,
+                      _client.query(_ns, Query(BSON("b" << GTE << 0)).hint(BSON("b" << 1)))
+                          ->itcount());
+    }
+};
+
 /** Index creation is killed if mayInterrupt is true. */
 class InsertBuildIndexInterrupt : public IndexBuildBase {
 public:
@@ -1031,6 +1107,7 @@ public:
         add<InsertBuildEnforceUnique<false>>();
         add<InsertBuildFillDups<true>>();
         add<InsertBuildFillDups<false>>();
+        add<InsertBuildParallelKeyGeneration>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIndexInterruptDisallowed>();
         add<InsertBuildIdIndexInterrupt>();
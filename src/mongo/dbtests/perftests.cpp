@@ -46,11 +46,13 @@
 #include <iostream>
 #include <mutex>
 
+#include "mongo/bson/bson_validate.h"
 #include "mongo/config.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/storage/mmap_v1/dur_stats.h"
 #include "mongo/db/storage/mmap_v1/mmap.h"
@@ -450,6 +452,142 @@ public:
     }
 };
 
+/**
+ * Validates a batch of documents shaped like typical inserts: flat records mixing numeric, string,
+ * date and ObjectId fields, and records holding an array of embedded documents.
+ */
+class ValidateBSONBase : public B {
+public:
+    virtual int howLongMillis() {
+        return 500;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+    void prep() {
+        _docs.clear();
+        for (int i = 0; i < 100; i++) {
+            BSONObjBuilder b;
+            b.append("_id", OID::gen());
+            b.append("name", str::stream() << "customer number " << i);
+            b.append("age", i % 90);
+            b.append("balance", i * 10.25);
+            b.append("created", Date_t::fromMillisSinceEpoch(1000LL * i));
+            b.append("active", i % 2 == 0);
+            if (i % 2) {
+                BSONArrayBuilder orders(b.subarrayStart("orders"));
+                for (int j = 0; j < 10; j++) {
+                    orders.append(BSON("sku" << j << "qty" << i + j << "price" << j * 1.5));
+                }
+                orders.done();
+            }
+            _docs.push_back(b.obj());
+        }
+    }
+    void timed() {
+        for (const auto& doc : _docs) {
+            invariantOK(validate(doc.objdata(), doc.objsize()));
+        }
+    }
+
+protected:
+    virtual Status validate(const char* buf, uint64_t maxLength) = 0;
+
+private:
+    vector<BSONObj> _docs;
+};
+class validatebsonspeed : public ValidateBSONBase {
+public:
+    string name() {
+        return "validateBSON";
+    }
+    Status validate(const char* buf, uint64_t maxLength) {
+        return validateBSON(buf, maxLength, BSONVersion::kLatest);
+    }
+};
+class validatebsonelementwisespeed : public ValidateBSONBase {
+public:
+    string name() {
+        return "validateBSONElementwise";
+    }
+    Status validate(const char* buf, uint64_t maxLength) {
+        return validateBSONElementwise(buf, maxLength, BSONVersion::kLatest);
+    }
+};
+
+/**
+ * Scores a batch of documents for a text index, as an index build does: tokenizing, filtering stop
+ * words and stemming each text field. The documents reuse a small vocabulary, like natural text.
+ */
+class FTSScoreDocumentBase : public B {
+public:
+    FTSScoreDocumentBase()
+        : _spec(assertGet(fts::FTSSpec::fixSpec(
+              BSON("key" << BSON("title"
+                                 << "text"
+                                 << "body"
+                                 << "text"))))) {}
+    virtual int howLongMillis() {
+        return 500;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+    void prep() {
+        const vector<string> vocabulary = words();
+        _docs.clear();
+        for (int i = 0; i < 100; i++) {
+            StringBuilder title;
+            StringBuilder body;
+            for (size_t j = 0; j < 200; j++) {
+                const string& word = vocabulary[(i * 31 + j * j) % vocabulary.size()];
+                if (j < 8) {
+                    title << word << " ";
+                }
+                body << word << (j % 12 == 11 ? ". " : " ");
+            }
+            _docs.push_back(BSON("title" << title.str() << "body" << body.str()));
+        }
+    }
+    void timed() {
+        for (const auto& doc : _docs) {
+            fts::TermFrequencyMap termFrequencies;
+            _spec.scoreDocument(doc, &termFrequencies);
+        }
+    }
+
+protected:
+    virtual vector<string> words() = 0;
+
+private:
+    const fts::FTSSpec _spec;
+    vector<BSONObj> _docs;
+};
+class ftsscoreasciispeed : public FTSScoreDocumentBase {
+public:
+    string name() {
+        return "ftsScoreDocumentAscii";
+    }
+    vector<string> words() {
+        return {"The",     "quick",   "brown",    "fox",      "jumps",     "over",  "the",
+                "lazy",    "dog",     "Running",  "runners",  "indexing",  "of",    "documents",
+                "queries", "Mark's",  "database", "searched", "searching", "and",   "stemmed",
+                "words",   "is",      "being",    "written",  "quickly",   "Texts", "library"};
+    }
+};
+class ftsscorenonasciispeed : public FTSScoreDocumentBase {
+public:
+    string name() {
+        return "ftsScoreDocumentNonAscii";
+    }
+    vector<string> words() {
+        return {"Le",     "renard",    "brun",    "rapide",  "saute",   "par-dessus", "le",
+                "chien",  "paresseux", "été",     "déjà",    "Ça",      "marché",     "élève",
+                "écrits", "données",   "requête", "café",    "naïve",   "über",       "straße",
+                "and",    "stemmed",   "words",   "written", "quickly", "Texts",      "library"};
+    }
+};
+
 
 class All : public Suite {
 public:
@@ -463,6 +601,10 @@ public:
         add<boosttimed_mutexspeed>();
         add<stdmutexspeed>();
         add<stdtimed_mutexspeed>();
+        add<validatebsonspeed>();
+        add<validatebsonelementwisespeed>();
+        add<ftsscoreasciispeed>();
+        add<ftsscorenonasciispeed>();
     }
 } myall;
 }
@@ -38,6 +38,7 @@
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/merge_sort.h"
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/plan_executor.h"
@@ -103,6 +104,44 @@ public:
         return endKeyBob.obj();
     }
 
+    /**
+     * Merges 'inputs', each already in sort order, with a MergeSortStage over QueuedDataStage
+     * children, and returns the results in the order the stage produces them.
+     */
+    std::vector<BSONObj> mergeQueued(const MergeSortStageParams& msparams,
+                                     const std::vector<std::vector<BSONObj>>& inputs) {
+        WorkingSet ws;
+        MergeSortStage ms(&_txn, msparams, &ws, nullptr);
+        for (const auto& input : inputs) {
+            auto queuedDataStage = make_unique<QueuedDataStage>(&_txn, &ws);
+            for (const BSONObj& obj : input) {
+                WorkingSetID id = ws.allocate();
+                WorkingSetMember* member = ws.get(id);
+                member->obj = Snapshotted<BSONObj>(SnapshotId(), obj.getOwned());
+                member->transitionToOwnedObj();
+                queuedDataStage->pushBack(id);
+            }
+            ms.addChild(queuedDataStage.release());
+        }
+
+        std::vector<BSONObj> results;
+        while (!ms.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED == ms.work(&id)) {
+                results.push_back(ws.get(id)->obj.value().getOwned());
+            }
+        }
+        return results;
+    }
+
+    void assertResultsEqual(const std::vector<BSONObj>& expected,
+                            const std::vector<BSONObj>& actual) {
+        ASSERT_EQUALS(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_BSONOBJ_EQ(expected[i], actual[i]);
+        }
+    }
+
     static const char* ns() {
         return "unittests.QueryStageMergeSort";
     }
@@ -889,6 +928,88 @@ public:
     }
 };
 
+// Strings are ordered by the collator in a descending field that follows an ascending one.
+class QueryStageMergeSortCollationWithMixedDirections : public QueryStageMergeSortTestBase {
+public:
+    void run() {
+        MergeSortStageParams msparams;
+        msparams.pattern = BSON("c" << 1 << "d" << -1);
+        CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+        msparams.collator = &collator;
+
+        // The collator compares "ab" as "ba", so "ab" comes first in descending order.
+        std::vector<BSONObj> results =
+            mergeQueued(msparams,
+                        {{BSON("c" << 1 << "d"
+                                   << "ab"),
+                          BSON("c" << 2 << "d"
+                                   << "ab")},
+                         {BSON("c" << 1 << "d"
+                                   << "ba"),
+                          BSON("c" << 2 << "d"
+                                   << "ba")}});
+
+        assertResultsEqual({BSON("c" << 1 << "d"
+                                     << "ab"),
+                            BSON("c" << 1 << "d"
+                                     << "ba"),
+                            BSON("c" << 2 << "d"
+                                     << "ab"),
+                            BSON("c" << 2 << "d"
+                                     << "ba")},
+                           results);
+    }
+};
+
+// A missing sort field compares equal to undefined, which sorts before null.
+class QueryStageMergeSortMissingFieldEqualsUndefined : public QueryStageMergeSortTestBase {
+public:
+    void run() {
+        MergeSortStageParams msparams;
+        msparams.pattern = BSON("a" << 1 << "b" << 1);
+
+        BSONObjBuilder undefinedBob;
+        undefinedBob.appendUndefined("a");
+        undefinedBob.append("b", 0);
+        const BSONObj undefinedA = undefinedBob.obj();
+        const BSONObj missingA = BSON("b" << 1);
+        const BSONObj nullA = BSON("a" << BSONNULL << "b" << 0);
+
+        std::vector<BSONObj> results = mergeQueued(msparams, {{missingA, nullA}, {undefinedA}});
+
+        assertResultsEqual({undefinedA, missingA, nullA}, results);
+    }
+};
+
+// Sort keys too large to encode as KeyStrings are still merged in order, both among themselves
+// and with keys that are encoded.
+class QueryStageMergeSortLargeSortKeys : public QueryStageMergeSortTestBase {
+public:
+    void run() {
+        MergeSortStageParams msparams;
+        msparams.pattern = BSON("a" << 1);
+
+        // More than 1KB of numbers in each sort key.
+        auto largeKeyDoc = [](int last) {
+            BSONObjBuilder bob;
+            BSONObjBuilder a(bob.subobjStart("a"));
+            for (int i = 0; i < 600; ++i) {
+                a.append(str::stream() << "f" << i, i);
+            }
+            a.append("last", last);
+            a.doneFast();
+            return bob.obj();
+        };
+
+        std::vector<BSONObj> results =
+            mergeQueued(msparams,
+                        {{BSON("a" << 1), largeKeyDoc(2)}, {largeKeyDoc(1), largeKeyDoc(3)}});
+
+        assertResultsEqual({BSON("a" << 1), largeKeyDoc(1), largeKeyDoc(2), largeKeyDoc(3)},
+                           results);
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_merge_sort_test") {}
@@ -904,6 +1025,9 @@ public:
         add<QueryStageMergeSortInvalidationMutationDedup>();
         add<QueryStageMergeSortStringsWithNullCollation>();
         add<QueryStageMergeSortStringsRespectsCollation>();
+        add<QueryStageMergeSortCollationWithMixedDirections>();
+        add<QueryStageMergeSortMissingFieldEqualsUndefined>();
+        add<QueryStageMergeSortLargeSortKeys>();
     }
 };
 
@@ -48,6 +48,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/balancer/balancer_configuration.h"
 #include "mongo/s/catalog/catalog_cache.h"
@@ -84,7 +85,8 @@ namespace {
  */
 class CMConfigDiffTracker : public ConfigDiffTracker<shared_ptr<Chunk>> {
 public:
-    CMConfigDiffTracker(ChunkManager* manager) : _manager(manager) {}
+    CMConfigDiffTracker(ChunkManager* manager, stdx::unordered_set<const Chunk*>* chunksFromDiff)
+        : _manager(manager), _chunksFromDiff(chunksFromDiff) {}
 
     bool isTracked(const ChunkType& chunk) const final {
         // Mongos tracks all shards
@@ -98,6 +100,7 @@ public:
     pair<BSONObj, shared_ptr<Chunk>> rangeFor(OperationContext* txn,
                                               const ChunkType& chunk) const final {
         shared_ptr<Chunk> c(new Chunk(txn, _manager, chunk));
+        _chunksFromDiff->insert(c.get());
         return make_pair(chunk.getMax(), c);
     }
 
@@ -108,8 +111,13 @@ public:
 
 private:
     ChunkManager* const _manager;
+    stdx::unordered_set<const Chunk*>* const _chunksFromDiff;
 };
 
+// Chunk bounds are compared the same way as the simple BSON comparator used for the chunk map,
+// which is ascending on every field regardless of the direction of the shard key.
+const Ordering kRoutingKeyOrdering = Ordering::make(BSONObj());
+
 
 bool allOfType(BSONType type, const BSONObj& o) {
     BSONObjIterator it(o);
@@ -208,10 +216,11 @@ void ChunkManager::loadExistingRanges(OperationContext* txn, const ChunkManager*
             SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<std::shared_ptr<Chunk>>();
         set<ShardId> shardIds;
         ShardVersionMap shardVersions;
+        ChunkRoutingIndex::IncrementalLoadState loadState;
 
         Timer t;
 
-        bool success = _load(txn, chunkMap, shardIds, &shardVersions, oldManager);
+        bool success = _load(txn, chunkMap, shardIds, &shardVersions, oldManager, &loadState);
         if (success) {
             log() << "ChunkManager: time to load chunks for " << _ns << ": " << t.millis() << "ms"
                   << " sequenceNumber: " << _sequenceNumber << " version: " << _version.toString()
@@ -224,6 +233,8 @@ void ChunkManager::loadExistingRanges(OperationContext* txn, const ChunkManager*
                 _shardIds.swap(shardIds);
                 _shardVersions.swap(shardVersions);
                 _chunkRangeMap = _constructRanges(_chunkMap);
+                _routingIndex.assign(
+                    _chunkMap, oldManager ? &oldManager->_routingIndex : nullptr, &loadState);
                 return;
             }
         }
@@ -243,7 +254,8 @@ bool ChunkManager::_load(OperationContext* txn,
                          ChunkMap& chunkMap,
                          set<ShardId>& shardIds,
                          ShardVersionMap* shardVersions,
-                         const ChunkManager* oldManager) {
+                         const ChunkManager* oldManager,
+                         ChunkRoutingIndex::IncrementalLoadState* loadState) {
     // Reset the max version, but not the epoch, when we aren't loading from the oldManager
     _version = ChunkVersion(0, 0, _version.epoch());
 
@@ -259,9 +271,11 @@ bool ChunkManager::_load(OperationContext* txn,
         // Load a copy of the chunk map, replacing the chunk manager with our own
         const ChunkMap& oldChunkMap = oldManager->getChunkMap();
 
-        // Could be v.expensive
-        // TODO: If chunks were immutable and didn't reference the manager, we could do more
-        // interesting things here
+        // Chunks reference their manager, so they have to be copied, but the old map is already
+        // sorted, so each insert is hinted at the end of the new map rather than searched for.
+        // TODO: If chunks were immutable and didn't reference the manager, we could share them
+        // between managers instead
+        loadState->carriedOver.reserve(oldChunkMap.size());
         for (const auto& oldChunkMapEntry : oldChunkMap) {
             shared_ptr<Chunk> oldC = oldChunkMapEntry.second;
             shared_ptr<Chunk> newC(new Chunk(this,
@@ -271,7 +285,8 @@ bool ChunkManager::_load(OperationContext* txn,
                                              oldC->getLastmod(),
                                              oldC->getBytesWritten()));
 
-            chunkMap.insert(make_pair(oldC->getMax(), newC));
+            loadState->carriedOver.emplace_back(newC.get(), loadState->carriedOver.size());
+            chunkMap.insert(chunkMap.end(), make_pair(oldC->getMax(), newC));
         }
 
         LOG(2) << "loading chunk manager for collection " << _ns
@@ -280,7 +295,7 @@ bool ChunkManager::_load(OperationContext* txn,
     }
 
     // Attach a diff tracker for the versioned chunk data
-    CMConfigDiffTracker differ(this);
+    CMConfigDiffTracker differ(this, &loadState->fromDiff);
     differ.attach(_ns, chunkMap, _version, *shardVersions);
 
     // Diff tracker should *always* find at least one chunk if collection exists
@@ -493,22 +508,13 @@ StatusWith<shared_ptr<Chunk>> ChunkManager::findIntersectingChunk(OperationConte
             }
         }
 
-        BSONObj chunkMin;
-        shared_ptr<Chunk> chunk;
-        {
-            ChunkMap::const_iterator it = _chunkMap.upper_bound(shardKey);
-            if (it != _chunkMap.end()) {
-                chunkMin = it->first;
-                chunk = it->second;
-            }
-        }
-
+        shared_ptr<Chunk> chunk = _routingIndex.upperBound(shardKey);
         if (chunk) {
             if (chunk->containsKey(shardKey)) {
                 return chunk;
             }
 
-            log() << redact(chunkMin.toString());
+            log() << redact(chunk->getMax().toString());
             log() << redact((*chunk).toString());
             log() << redact(shardKey);
 
@@ -773,6 +779,73 @@ string ChunkManager::toString() const {
     return sb.str();
 }
 
+void ChunkManager::ChunkRoutingIndex::assign(const ChunkMap& chunkMap,
+                                             const ChunkRoutingIndex* oldIndex,
+                                             const IncrementalLoadState* state) {
+    std::string keys;
+    vector<size_t> keyOffsets;
+    vector<shared_ptr<Chunk>> chunks;
+
+    if (oldIndex) {
+        keys.reserve(oldIndex->_keys.size());
+    }
+    keyOffsets.reserve(chunkMap.size() + 1);
+    chunks.reserve(chunkMap.size());
+
+    KeyString encoder(KeyString::Version::V1);
+    const bool incremental = oldIndex && state;
+    size_t nextCarriedOver = 0;
+
+    for (const auto& chunkMapEntry : chunkMap) {
+        const Chunk* const chunk = chunkMapEntry.second.get();
+        keyOffsets.push_back(keys.size());
+        chunks.push_back(chunkMapEntry.second);
+
+        if (incremental && !state->fromDiff.count(chunk)) {
+            // Carried over chunks appear in the same relative order as in the old map, except
+            // that some of them may since have been replaced by the diff, so skip over those.
+            invariant(nextCarriedOver < state->carriedOver.size());
+            while (state->carriedOver[nextCarriedOver].first != chunk) {
+                ++nextCarriedOver;
+                invariant(nextCarriedOver < state->carriedOver.size());
+            }
+
+            const size_t oldPosition = state->carriedOver[nextCarriedOver++].second;
+            invariant(oldPosition < oldIndex->size());
+
+            const StringData oldKey = oldIndex->_keyAt(oldPosition);
+            keys.append(oldKey.rawData(), oldKey.size());
+            continue;
+        }
+
+        encoder.resetToKey(chunkMapEntry.first, kRoutingKeyOrdering);
+        keys.append(encoder.getBuffer(), encoder.getSize());
+    }
+    keyOffsets.push_back(keys.size());
+
+    _keys.swap(keys);
+    _keyOffsets.swap(keyOffsets);
+    _chunks.swap(chunks);
+}
+
+shared_ptr<Chunk> ChunkManager::ChunkRoutingIndex::upperBound(const BSONObj& shardKey) const {
+    const KeyString encodedKey(KeyString::Version::V1, shardKey, kRoutingKeyOrdering);
+    const StringData key(encodedKey.getBuffer(), encodedKey.getSize());
+
+    size_t low = 0;
+    size_t high = _chunks.size();
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (key.compare(_keyAt(mid)) < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low < _chunks.size() ? _chunks[low] : nullptr;
+}
+
 ChunkManager::ChunkRangeMap ChunkManager::_constructRanges(const ChunkMap& chunkMap) {
     ChunkRangeMap chunkRangeMap =
         SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ShardAndChunkRange>();
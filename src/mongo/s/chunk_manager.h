@@ -40,6 +40,7 @@
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard.h"
 #include "mongo/s/shard_key_pattern.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
@@ -234,6 +235,56 @@ private:
         ShardId _shardId;
     };
 
+    /**
+     * Flat, sorted index over the max bound of every chunk in the chunk map, which is what
+     * findIntersectingChunk searches. The bounds are KeyString-encoded and packed back to back
+     * into a single buffer, so a lookup is a binary search of memcmp calls over contiguous memory
+     * instead of a walk down the red-black tree doing a BSON comparison at every node.
+     */
+    class ChunkRoutingIndex {
+    public:
+        /**
+         * Records, while a chunk manager is loaded from a previous one, which chunks were carried
+         * over from the old chunk map (along with their position in the old routing index) and
+         * which ones were produced by the config diff.
+         */
+        struct IncrementalLoadState {
+            std::vector<std::pair<const Chunk*, size_t>> carriedOver;
+            stdx::unordered_set<const Chunk*> fromDiff;
+        };
+
+        /**
+         * Rebuilds the index so that it covers 'chunkMap'. If 'oldIndex' and 'state' are
+         * specified, the encoded bounds of the chunks which were carried over from 'oldIndex' are
+         * copied rather than re-encoded, so that only the chunks which changed in the diff pay for
+         * a KeyString conversion.
+         */
+        void assign(const ChunkMap& chunkMap,
+                    const ChunkRoutingIndex* oldIndex = nullptr,
+                    const IncrementalLoadState* state = nullptr);
+
+        /**
+         * Returns the first chunk whose max bound is greater than 'shardKey', or nullptr if there
+         * is no such chunk.
+         */
+        std::shared_ptr<Chunk> upperBound(const BSONObj& shardKey) const;
+
+        size_t size() const {
+            return _chunks.size();
+        }
+
+    private:
+        StringData _keyAt(size_t i) const {
+            return StringData(_keys.data() + _keyOffsets[i], _keyOffsets[i + 1] - _keyOffsets[i]);
+        }
+
+        // Encoded max bounds of all chunks, in key order. The bound of the i-th chunk occupies
+        // [_keyOffsets[i], _keyOffsets[i + 1]) in _keys.
+        std::string _keys;
+        std::vector<size_t> _keyOffsets;
+        std::vector<std::shared_ptr<Chunk>> _chunks;
+    };
+
     // Contains a compressed map of what range of keys resides on which shard. The index is the max
     // key of the respective range and the union of all ranges in a such constructed map must cover
     // the complete space from [MinKey, MaxKey).
@@ -248,7 +299,8 @@ private:
                ChunkMap& chunks,
                std::set<ShardId>& shardIds,
                ShardVersionMap* shardVersions,
-               const ChunkManager* oldManager);
+               const ChunkManager* oldManager,
+               ChunkRoutingIndex::IncrementalLoadState* loadState);
 
     /**
      * Merges consecutive chunks, which reside on the same shard into a single range.
@@ -268,6 +320,7 @@ private:
 
     ChunkMap _chunkMap;
     ChunkRangeMap _chunkRangeMap;
+    ChunkRoutingIndex _routingIndex;
 
     std::set<ShardId> _shardIds;
 
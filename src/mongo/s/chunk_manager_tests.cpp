@@ -243,6 +243,117 @@ TEST_F(ChunkManagerTests, Basic) {
     std::cout << "completely done";
 }
 
+/**
+ * Tests that a ChunkManager loaded from an old ChunkManager routes keys to the right chunks, both
+ * for the chunks it carried over and for the ones which changed in the diff.
+ */
+TEST_F(ChunkManagerTests, IncrementalLoadRoutesCarriedOverAndChangedChunks) {
+    OperationContextNoop txn;
+    string keyName = "_id";
+    vector<BSONObj> splitKeys;
+    genUniqueRandomSplitKeys(keyName, &splitKeys);
+    ShardKeyPattern shardKeyPattern(BSON(keyName << 1));
+    std::unique_ptr<CollatorInterface> defaultCollator;
+
+    std::vector<BSONObj> shards{
+        BSON(ShardType::name() << _shardId << ShardType::host()
+                               << ConnectionString(HostAndPort("hostFooBar:27017")).toString())};
+
+    std::vector<BSONObj> chunks;
+    auto future = launchAsync([&] {
+        ChunkManager manager(_collName, shardKeyPattern, std::move(defaultCollator), false);
+        ASSERT_OK(manager.createFirstChunks(operationContext(), _shardId, &splitKeys, NULL));
+    });
+
+    for (int i = 0; i < static_cast<int>(splitKeys.size()) + 1; i++) {
+        expectInsertOnConfigSaveChunkAndReturnOk(chunks);
+    }
+
+    future.timed_get(kFutureTimeout);
+
+    const int numChunks = static_cast<int>(chunks.size());
+    ChunkVersion version = ChunkVersion::fromBSON(chunks.back(), ChunkType::DEPRECATED_lastmod());
+
+    CollectionType collType;
+    collType.setNs(NamespaceString{_collName});
+    collType.setEpoch(version.epoch());
+    collType.setUpdatedAt(jsTime());
+    collType.setKeyPattern(BSON(keyName << 1));
+    collType.setUnique(false);
+    collType.setDropped(false);
+
+    ChunkManager manager(&txn, collType);
+    future = launchAsync([&] { manager.loadExistingRanges(operationContext(), nullptr); });
+    expectFindOnConfigSendBSONObjVector(chunks);
+    expectFindOnConfigSendBSONObjVector(shards);
+    future.timed_get(kFutureTimeout);
+
+    // Split a chunk in the middle of the key space, which is not the one with the highest version.
+    BSONObj splitMin;
+    BSONObj splitMax;
+    int splitPoint = 0;
+    for (auto it = chunks.begin(); it != chunks.end() - 1; ++it) {
+        const BSONObj min = it->getObjectField(ChunkType::min());
+        const BSONObj max = it->getObjectField(ChunkType::max());
+        if (min.firstElement().isNumber() && max.firstElement().isNumber() &&
+            max.firstElement().numberInt() - min.firstElement().numberInt() >= 2) {
+            splitMin = min;
+            splitMax = max;
+            splitPoint = (min.firstElement().numberInt() + max.firstElement().numberInt()) / 2;
+            break;
+        }
+    }
+    ASSERT_FALSE(splitMin.isEmpty());
+
+    ChunkType leftChunk;
+    leftChunk.setNS(_collName);
+    leftChunk.setMin(splitMin);
+    leftChunk.setMax(BSON(keyName << splitPoint));
+    leftChunk.setShard(_shardId);
+    leftChunk.setVersion(ChunkVersion(2, 0, version.epoch()));
+
+    ChunkType rightChunk;
+    rightChunk.setNS(_collName);
+    rightChunk.setMin(BSON(keyName << splitPoint));
+    rightChunk.setMax(splitMax);
+    rightChunk.setShard(_shardId);
+    rightChunk.setVersion(ChunkVersion(2, 1, version.epoch()));
+
+    future = launchAsync([&] {
+        ChunkManager newManager(manager.getns(),
+                                manager.getShardKeyPattern(),
+                                manager.getDefaultCollator() ? manager.getDefaultCollator()->clone()
+                                                             : nullptr,
+                                manager.isUnique());
+        newManager.loadExistingRanges(operationContext(), &manager);
+
+        ASSERT_EQ(numChunks + 1, newManager.numChunks());
+        ASSERT_EQ(ChunkVersion(2, 1, version.epoch()).toString(),
+                  newManager.getVersion().toString());
+
+        // Every chunk, carried over or not, must be the one found for its min bound.
+        for (const auto& chunkMapEntry : newManager.getChunkMap()) {
+            const auto& chunk = chunkMapEntry.second;
+            ASSERT_EQ(chunk,
+                      newManager.findIntersectingChunkWithSimpleCollation(operationContext(),
+                                                                          chunk->getMin()));
+        }
+
+        auto rightFound = newManager.findIntersectingChunkWithSimpleCollation(
+            operationContext(), BSON(keyName << splitPoint));
+        ASSERT_BSONOBJ_EQ(rightChunk.getMin(), rightFound->getMin());
+        ASSERT_BSONOBJ_EQ(rightChunk.getMax(), rightFound->getMax());
+
+        auto leftFound = newManager.findIntersectingChunkWithSimpleCollation(
+            operationContext(), BSON(keyName << splitPoint - 1));
+        ASSERT_BSONOBJ_EQ(leftChunk.getMin(), leftFound->getMin());
+        ASSERT_BSONOBJ_EQ(leftChunk.getMax(), leftFound->getMax());
+    });
+    expectFindOnConfigSendBSONObjVector(
+        std::vector<BSONObj>{chunks.back(), leftChunk.toBSON(), rightChunk.toBSON()});
+    future.timed_get(kFutureTimeout);
+}
+
 /**
  * Tests that chunk metadata is created correctly when using ChunkManager to create chunks for the
  * first time. Creating chunks on multiple shards is not tested here since there are unresolved
@@ -57,7 +57,7 @@ AsyncResultsMerger::AsyncResultsMerger(executor::TaskExecutor* executor,
                                        ClusterClientCursorParams&& params)
     : _executor(executor),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(_remotes, _params.sort)) {
+      _mergeTree(_remotes, _params.sort) {
     for (const auto& remote : _params.remotes) {
         if (remote.shardId) {
             invariant(remote.cmdObj);
@@ -206,12 +206,12 @@ ClusterQueryResult AsyncResultsMerger::nextReadySorted() {
     // Tailable cursors cannot have a sort.
     invariant(!_params.isTailable);
 
-    if (_mergeQueue.empty()) {
+    auto top = _mergeTree.top();
+    if (!top) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    size_t smallestRemote = *top;
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
@@ -219,11 +219,8 @@ ClusterQueryResult AsyncResultsMerger::nextReadySorted() {
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
-    }
+    // Replay the matches on the path of 'smallestRemote' with its next result, if it has one.
+    _mergeTree.pop(smallestRemote);
 
     return front;
 }
@@ -514,6 +511,10 @@ void AsyncResultsMerger::handleBatchResponse(
             std::queue<ClusterQueryResult> emptyBuffer;
             std::swap(remote.docBuffer, emptyBuffer);
             remote.cursorId = 0;
+
+            if (!_params.sort.isEmpty()) {
+                _mergeTree.invalidate(remoteIndex);
+            }
         }
 
         return;
@@ -541,10 +542,10 @@ void AsyncResultsMerger::handleBatchResponse(
         ++remote.fetchedCount;
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the
-    // merge queue.
+    // If we're doing a sorted merge, then we have to make sure the merge tree takes the new
+    // results from this remote into account.
     if (!_params.sort.isEmpty() && !cursorResponse.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        _mergeTree.invalidate(remoteIndex);
     }
 
     // If the cursor is tailable and we just received an empty batch, the next return value should
@@ -705,19 +706,111 @@ std::shared_ptr<Shard> AsyncResultsMerger::RemoteCursorData::getShard() {
 }
 
 //
-// AsyncResultsMerger::MergingComparator
+// AsyncResultsMerger::MergeTree
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+AsyncResultsMerger::MergeTree::MergeTree(const std::vector<RemoteCursorData>& remotes,
+                                         const BSONObj& sort)
+    : _remotes(remotes), _sort(sort), _encoder(sort, nullptr) {}
+
+boost::optional<size_t> AsyncResultsMerger::MergeTree::top() {
+    if (_needsRebuild) {
+        _rebuild();
+    }
+
+    if (_tree.empty() || _remotes[_tree[0]].docBuffer.empty()) {
+        return boost::none;
+    }
+    return _tree[0];
+}
 
-    BSONObj leftDocKey = (*leftDoc.getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
-    BSONObj rightDocKey = (*rightDoc.getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
+void AsyncResultsMerger::MergeTree::pop(size_t remoteIndex) {
+    invariant(!_needsRebuild);
+    invariant(remoteIndex == _tree[0]);
+
+    _updateKey(remoteIndex);
+
+    // Only the matches on the path from the winner's leaf to the root can have a different
+    // outcome, so replay just those.
+    const size_t numRemotes = _remotes.size();
+    size_t winner = remoteIndex;
+    for (size_t node = (remoteIndex + numRemotes) / 2; node > 0; node /= 2) {
+        if (_less(_tree[node], winner)) {
+            std::swap(_tree[node], winner);
+        }
+    }
+    _tree[0] = winner;
+}
+
+void AsyncResultsMerger::MergeTree::invalidate(size_t remoteIndex) {
+    if (remoteIndex < _keys.size()) {
+        _updateKey(remoteIndex);
+    }
+    _needsRebuild = true;
+}
+
+bool AsyncResultsMerger::MergeTree::_less(size_t lhs, size_t rhs) const {
+    const bool lhsEmpty = _remotes[lhs].docBuffer.empty();
+    const bool rhsEmpty = _remotes[rhs].docBuffer.empty();
+    if (lhsEmpty || rhsEmpty) {
+        return !lhsEmpty || (rhsEmpty && lhs < rhs);
+    }
 
     // This does not need to sort with a collator, since mongod has already mapped strings to their
     // ICU comparison keys as part of the $sortKey meta projection.
-    return leftDocKey.woCompare(rightDocKey, _sort, false /*considerFieldName*/) > 0;
+    int cmp;
+    if (!_keys[lhs].empty() && !_keys[rhs].empty()) {
+        cmp = _keys[lhs].compare(_keys[rhs]);
+    } else {
+        cmp = _frontSortKey(lhs).woCompare(_frontSortKey(rhs), _sort, false /*considerFieldName*/);
+    }
+    return cmp < 0 || (cmp == 0 && lhs < rhs);
+}
+
+BSONObj AsyncResultsMerger::MergeTree::_frontSortKey(size_t remoteIndex) const {
+    const ClusterQueryResult& front = _remotes[remoteIndex].docBuffer.front();
+    return (*front.getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
+}
+
+void AsyncResultsMerger::MergeTree::_updateKey(size_t remoteIndex) {
+    const auto& docBuffer = _remotes[remoteIndex].docBuffer;
+    if (docBuffer.empty()) {
+        return;
+    }
+
+    // Every key is encoded with a null RecordId, so that equal sort keys stay equal.
+    _encoder.encode(_frontSortKey(remoteIndex), RecordId(), &_keys[remoteIndex]);
+}
+
+void AsyncResultsMerger::MergeTree::_rebuild() {
+    const size_t numRemotes = _remotes.size();
+    if (_keys.size() != numRemotes) {
+        _keys.resize(numRemotes);
+        for (size_t i = 0; i < numRemotes; ++i) {
+            _updateKey(i);
+        }
+    }
+
+    _tree.assign(numRemotes, 0);
+    _needsRebuild = false;
+    if (numRemotes == 0) {
+        return;
+    }
+
+    // Play the tournament bottom-up. 'winners' holds the winner of the match at each internal
+    // node, followed by the leaves.
+    std::vector<size_t> winners(2 * numRemotes);
+    for (size_t i = 0; i < numRemotes; ++i) {
+        winners[numRemotes + i] = i;
+    }
+    for (size_t node = numRemotes - 1; node > 0; --node) {
+        const size_t left = winners[2 * node];
+        const size_t right = winners[2 * node + 1];
+        const bool rightWins = _less(right, left);
+        winners[node] = rightWins ? right : left;
+        _tree[node] = rightWins ? left : right;
+    }
+    _tree[0] = numRemotes == 1 ? 0 : winners[1];
 }
 
 }  // namespace mongo
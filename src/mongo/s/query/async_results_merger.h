@@ -30,12 +30,14 @@
 
 #include <boost/optional.hpp>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/query/sort_key_encoder.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/query/cluster_client_cursor_params.h"
 #include "mongo/s/query/cluster_query_result.h"
@@ -254,17 +256,69 @@ private:
         boost::optional<HostAndPort> _shardHostAndPort;
     };
 
-    class MergingComparator {
+    /**
+     * A tournament tree of losers over all remotes, used for sorted merges. The sort key of the
+     * document at the front of each remote's buffer is encoded once as a KeyString, so finding
+     * the next result after the previous one was consumed takes about log2(number of remotes)
+     * memcmp-based comparisons, rather than re-extracting and comparing $sortKey documents.
+     * Sort keys too large to encode are compared as $sortKey documents instead.
+     *
+     * A remote with an empty buffer sorts after every other remote.
+     */
+    class MergeTree {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes, const BSONObj& sort)
-            : _remotes(remotes), _sort(sort) {}
+        MergeTree(const std::vector<RemoteCursorData>& remotes, const BSONObj& sort);
+
+        /**
+         * Returns the index of the remote whose next document comes first in the sort order, or
+         * boost::none if no remote has a buffered document.
+         */
+        boost::optional<size_t> top();
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        /**
+         * Must be called after the front document of the remote returned by top() is removed.
+         */
+        void pop(size_t remoteIndex);
+
+        /**
+         * Must be called whenever the buffer of 'remoteIndex' changes other than through pop(),
+         * for instance when a new batch arrives. The tree is rebuilt lazily on the next top().
+         */
+        void invalidate(size_t remoteIndex);
 
     private:
+        /**
+         * Returns true if the next document of 'lhs' comes before the next document of 'rhs'.
+         * Ties are broken by remote index, to keep the merge deterministic.
+         */
+        bool _less(size_t lhs, size_t rhs) const;
+
+        /**
+         * Returns the $sortKey of the front document of 'remoteIndex', whose buffer must not be
+         * empty.
+         */
+        BSONObj _frontSortKey(size_t remoteIndex) const;
+
+        void _updateKey(size_t remoteIndex);
+
+        void _rebuild();
+
         const std::vector<RemoteCursorData>& _remotes;
+        const BSONObj _sort;
+
+        // mongod has already mapped strings to their collation keys in $sortKey, so this encodes
+        // without a collator.
+        SortKeyEncoder _encoder;
+
+        // The encoded sort key of the front document of each remote, valid only while that
+        // remote's buffer is not empty. Empty if that sort key is too large to encode.
+        std::vector<std::string> _keys;
+
+        // _tree[0] is the index of the winning remote, and _tree[1 .. n-1] hold the remote that
+        // lost the match played at that node. The parent of the leaf for remote i is (i + n) / 2.
+        std::vector<size_t> _tree;
 
-        const BSONObj& _sort;
+        bool _needsRebuild = true;
     };
 
     enum LifecycleState { kAlive, kKillStarted, kKillComplete };
@@ -359,9 +413,9 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // Tracks which remote host has the next document to return, according to the sort order. Used
+    // only if there is a sort.
+    MergeTree _mergeTree;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -515,6 +515,134 @@ TEST_F(AsyncResultsMergerTest, ClusterFindCompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, ClusterFindSortedManyRemotes) {
+    // Use a number of remotes which is not a power of two, so that the merge tree is not complete.
+    const size_t kNumRemotes = 7;
+    const int kDocsPerRemote = 3;
+    std::vector<ShardId> shardIds;
+    for (size_t i = 0; i < kNumRemotes; ++i) {
+        shardIds.push_back(kTestShardIds[i % kTestShardIds.size()]);
+    }
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1}, batchSize: 3}");
+    makeCursorFromFindCmd(findCmd, shardIds);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // Remote i returns the values congruent to i modulo kNumRemotes, in descending order. Odd
+    // remotes return doubles, to check that numeric types of equal value are ordered correctly.
+    std::vector<CursorResponse> responses;
+    for (size_t i = 0; i < kNumRemotes; ++i) {
+        std::vector<BSONObj> batch;
+        for (int j = kDocsPerRemote - 1; j >= 0; --j) {
+            const int value = static_cast<int>(j * kNumRemotes + i);
+            batch.push_back(i % 2 ? BSON("$sortKey" << BSON("" << static_cast<double>(value)))
+                                  : BSON("$sortKey" << BSON("" << value)));
+        }
+        responses.emplace_back(_nss, CursorId(0), batch);
+    }
+    scheduleNetworkResponses(std::move(responses), CursorResponse::ResponseType::InitialResponse);
+    executor()->waitForEvent(readyEvent);
+
+    for (int expected = kNumRemotes * kDocsPerRemote - 1; expected >= 0; --expected) {
+        ASSERT_TRUE(arm->ready());
+        auto result = unittest::assertGet(arm->nextReady());
+        ASSERT_FALSE(result.isEOF());
+        ASSERT_EQ(expected, (*result.getResult())["$sortKey"].Obj().firstElement().numberInt());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, ClusterFindSortPatternWithMoreThan32Fields) {
+    // Only the last, descending, field of the 33 differs between the sort keys.
+    const int kNumFields = 33;
+    BSONObjBuilder sortBob;
+    for (int i = 0; i < kNumFields; ++i) {
+        sortBob.append(str::stream() << "f" << i, i == kNumFields - 1 ? -1 : 1);
+    }
+    BSONObj findCmd = BSON("find"
+                           << "testcoll"
+                           << "sort"
+                           << sortBob.obj()
+                           << "batchSize"
+                           << 2);
+    makeCursorFromFindCmd(findCmd, kTestShardIds);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    auto makeDoc = [&](int last) {
+        BSONObjBuilder sortKey;
+        for (int i = 0; i < kNumFields - 1; ++i) {
+            sortKey.append("", 0);
+        }
+        sortKey.append("", last);
+        return BSON("$sortKey" << sortKey.obj());
+    };
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {makeDoc(5), makeDoc(2)};
+    responses.emplace_back(_nss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {makeDoc(4), makeDoc(1)};
+    responses.emplace_back(_nss, CursorId(0), batch2);
+    std::vector<BSONObj> batch3 = {makeDoc(6), makeDoc(3)};
+    responses.emplace_back(_nss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses), CursorResponse::ResponseType::InitialResponse);
+    executor()->waitForEvent(readyEvent);
+
+    for (int expected = 6; expected >= 1; --expected) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(makeDoc(expected), *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, ClusterFindSortKeysTooLargeToEncode) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1}, batchSize: 2}");
+    makeCursorFromFindCmd(findCmd, kTestShardIds);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // More than 1KB of numbers in each sort key but the small one, so these keys are compared as
+    // BSON, both among themselves and with the small key.
+    auto makeLargeDoc = [](int last) {
+        BSONObjBuilder numbers;
+        for (int i = 0; i < 600; ++i) {
+            numbers.append(str::stream() << "f" << i, i);
+        }
+        numbers.append("last", last);
+        return BSON("$sortKey" << BSON("" << numbers.obj()));
+    };
+    const BSONObj smallDoc = fromjson("{$sortKey: {'': 1}}");
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {makeLargeDoc(2), makeLargeDoc(5)};
+    responses.emplace_back(_nss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {smallDoc, makeLargeDoc(3)};
+    responses.emplace_back(_nss, CursorId(0), batch2);
+    std::vector<BSONObj> batch3 = {makeLargeDoc(1), makeLargeDoc(4)};
+    responses.emplace_back(_nss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses), CursorResponse::ResponseType::InitialResponse);
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(smallDoc, *unittest::assertGet(arm->nextReady()).getResult());
+    for (int expected = 1; expected <= 5; ++expected) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(makeLargeDoc(expected),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, ClusterFindSortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}, batchSize: 2}");
     makeCursorFromFindCmd(findCmd, {kTestShardIds[0]});
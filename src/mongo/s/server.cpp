@@ -83,7 +83,7 @@
 #include "mongo/s/version_mongos.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
-#include "mongo/transport/transport_layer_legacy.h"
+#include "mongo/transport/transport_layer_factory.h"
 #include "mongo/util/admin_access.h"
 #include "mongo/util/cmdline_utils/censor_cmdline.h"
 #include "mongo/util/concurrency/thread_name.h"
@@ -234,21 +234,19 @@ static ExitCode runMongosServer() {
 
     _initWireSpec();
 
-    transport::TransportLayerLegacy::Options opts;
-    opts.port = serverGlobalParams.port;
-    opts.ipList = serverGlobalParams.bind_ip;
-
     auto sep =
         stdx::make_unique<ServiceEntryPointMongos>(getGlobalServiceContext()->getTransportLayer());
     auto sepPtr = sep.get();
 
     getGlobalServiceContext()->setServiceEntryPoint(std::move(sep));
 
-    auto transportLayer = stdx::make_unique<transport::TransportLayerLegacy>(opts, sepPtr);
-    auto res = transportLayer->setup();
-    if (!res.isOK()) {
+    auto swTransportLayer = transport::makeIngressTransportLayer(
+        serverGlobalParams.port, serverGlobalParams.bind_ip, sepPtr);
+    if (!swTransportLayer.isOK()) {
+        error() << "Failed to set up listener: " << swTransportLayer.getStatus();
         return EXIT_NET_ERROR;
     }
+    auto transportLayer = std::move(swTransportLayer.getValue());
 
     // Add sharding hooks to both connection pools - ShardingConnectionHook includes auth hooks
     globalConnPool.addHook(new ShardingConnectionHookForMongos(false));
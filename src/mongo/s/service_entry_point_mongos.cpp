@@ -74,6 +74,13 @@ using transport::TransportLayer;
 ServiceEntryPointMongos::ServiceEntryPointMongos(TransportLayer* tl) : _tl(tl) {}
 
 void ServiceEntryPointMongos::startSession(Session&& session) {
+    if (session.getTransportLayer()->supportsAsyncWait()) {
+        launchAsyncServiceEntryWorker(std::move(session), [this](Session* session, Message* m) {
+            _handleMessage(session, m);
+        });
+        return;
+    }
+
     launchWrappedServiceEntryWorkerThread(std::move(session),
                                           [this](Session* session) { _sessionLoop(session); });
 }
@@ -83,9 +90,6 @@ void ServiceEntryPointMongos::_sessionLoop(Session* session) {
     int64_t counter = 0;
 
     while (true) {
-        // Release any cached egress connections for client back to pool before destroying
-        auto guard = MakeGuard(ShardConnection::releaseMyConnections);
-
         message.reset();
 
         // 1. Source a Message from the client
@@ -105,42 +109,50 @@ void ServiceEntryPointMongos::_sessionLoop(Session* session) {
             uassertStatusOK(status);
         }
 
-        // 2. Build a sharding request
-        Request r(message);
-        auto txn = cc().makeOperationContext();
-
-        try {
-            r.init(txn.get());
-            r.process(txn.get());
-        } catch (const AssertionException& ex) {
-            LOG(ex.isUserAssertion() ? 1 : 0) << "Assertion failed"
-                                              << " while processing "
-                                              << networkOpToString(message.operation()) << " op"
-                                              << " for " << r.getnsIfPresent() << causedBy(ex);
-            if (r.expectResponse()) {
-                message.header().setId(r.id());
-                replyToQuery(ResultFlag_ErrSet, session, message, buildErrReply(ex));
-            }
-
-            // We *always* populate the last error for now
-            LastError::get(cc()).setLastError(ex.getCode(), ex.what());
-        } catch (const DBException& ex) {
-            log() << "Exception thrown"
-                  << " while processing " << networkOpToString(message.operation()) << " op"
-                  << " for " << r.getnsIfPresent() << causedBy(ex);
+        // 2. Process it
+        _handleMessage(session, &message);
 
-            if (r.expectResponse()) {
-                message.header().setId(r.id());
-                replyToQuery(ResultFlag_ErrSet, session, message, buildErrReply(ex));
-            }
+        if ((counter++ & 0xf) == 0) {
+            markThreadIdle();
+        }
+    }
+}
 
-            // We *always* populate the last error for now
-            LastError::get(cc()).setLastError(ex.getCode(), ex.what());
+void ServiceEntryPointMongos::_handleMessage(Session* session, Message* message) {
+    // Release any cached egress connections for client back to pool before destroying
+    auto guard = MakeGuard(ShardConnection::releaseMyConnections);
+
+    // 1. Build a sharding request
+    Request r(*message);
+    auto txn = cc().makeOperationContext();
+
+    try {
+        r.init(txn.get());
+        r.process(txn.get());
+    } catch (const AssertionException& ex) {
+        LOG(ex.isUserAssertion() ? 1 : 0) << "Assertion failed"
+                                          << " while processing "
+                                          << networkOpToString(message->operation()) << " op"
+                                          << " for " << r.getnsIfPresent() << causedBy(ex);
+        if (r.expectResponse()) {
+            message->header().setId(r.id());
+            replyToQuery(ResultFlag_ErrSet, session, *message, buildErrReply(ex));
         }
 
-        if ((counter++ & 0xf) == 0) {
-            markThreadIdle();
+        // We *always* populate the last error for now
+        LastError::get(cc()).setLastError(ex.getCode(), ex.what());
+    } catch (const DBException& ex) {
+        log() << "Exception thrown"
+              << " while processing " << networkOpToString(message->operation()) << " op"
+              << " for " << r.getnsIfPresent() << causedBy(ex);
+
+        if (r.expectResponse()) {
+            message->header().setId(r.id());
+            replyToQuery(ResultFlag_ErrSet, session, *message, buildErrReply(ex));
         }
+
+        // We *always* populate the last error for now
+        LastError::get(cc()).setLastError(ex.getCode(), ex.what());
     }
 }
 
@@ -35,6 +35,8 @@
 
 namespace mongo {
 
+class Message;
+
 namespace transport {
 class Session;
 class TransportLayer;
@@ -42,7 +44,9 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongos. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the
+ * TransportLayer supports asyncWait(), in which case idle sessions hold no thread and Messages
+ * are handled on the TransportLayer's request pool.
  */
 class ServiceEntryPointMongos final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongos);
@@ -57,6 +61,11 @@ public:
 private:
     void _sessionLoop(transport::Session* session);
 
+    /**
+     * Processes a single Message sourced from 'session', replying to it if required.
+     */
+    void _handleMessage(transport::Session* session, Message* message);
+
     transport::TransportLayer* _tl;
 };
 
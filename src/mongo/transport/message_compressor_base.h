@@ -39,6 +39,7 @@ namespace mongo {
 enum class MessageCompressor : uint8_t {
     kNoop = 0,
     kSnappy = 1,
+    kZlib = 2,
     kExtended = 255,
 };
 
@@ -113,6 +114,34 @@ public:
         return _decompressBytesOut.loadRelaxed();
     }
 
+    /*
+     * This returns the total time spent in compressData, in microseconds
+     */
+    int64_t getCompressMicros() const {
+        return _compressMicros.loadRelaxed();
+    }
+
+    /*
+     * This returns the total time spent in decompressData, in microseconds
+     */
+    int64_t getDecompressMicros() const {
+        return _decompressMicros.loadRelaxed();
+    }
+
+    /*
+     * Called by the MessageCompressorManager to account for time spent in compressData
+     */
+    void counterHitCompressMicros(int64_t micros) {
+        _compressMicros.addAndFetch(micros);
+    }
+
+    /*
+     * Called by the MessageCompressorManager to account for time spent in decompressData
+     */
+    void counterHitDecompressMicros(int64_t micros) {
+        _decompressMicros.addAndFetch(micros);
+    }
+
 
 protected:
     /*
@@ -147,5 +176,8 @@ private:
 
     AtomicInt64 _decompressBytesIn;
     AtomicInt64 _decompressBytesOut;
+
+    AtomicInt64 _compressMicros;
+    AtomicInt64 _decompressMicros;
 };
 }  // namespace mongo
@@ -39,6 +39,7 @@
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -110,7 +111,9 @@ StatusWith<Message> MessageCompressorManager::compressMessage(const Message& msg
     compressionHeader.serialize(&output);
     ConstDataRange input(inputHeader.data(), inputHeader.data() + inputHeader.dataLen());
 
+    Timer compressTimer;
     auto sws = compressor->compressData(input, output);
+    compressor->counterHitCompressMicros(compressTimer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -142,7 +145,9 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     DataRangeCursor output(outMessage.data(), outMessage.data() + outMessage.dataLen());
 
+    Timer decompressTimer;
     auto sws = compressor->decompressData(input, output);
+    compressor->counterHitDecompressMicros(decompressTimer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
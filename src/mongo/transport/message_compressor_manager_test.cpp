@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_zlib.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/net/message.h"
 
@@ -182,5 +183,27 @@ TEST(SnappyMessageCompressor, Fidelity) {
     checkFidelity(testMessage, stdx::make_unique<NoopMessageCompressor>());
 }
 
+TEST(ZlibMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
+}
+
+TEST(ZlibMessageCompressor, FidelityAtAllLevels) {
+    auto testMessage = buildMessage();
+    for (int level = 0; level <= 9; level++) {
+        checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>(level));
+    }
+}
+
+TEST(ZlibMessageCompressor, CorruptInputFailsToDecompress) {
+    ZlibMessageCompressor compressor;
+    const std::string garbage = "this is not a zlib stream";
+    std::vector<char> output(64);
+    auto sws = compressor.decompressData(
+        ConstDataRange(garbage.data(), garbage.data() + garbage.size()),
+        DataRange(output.data(), output.data() + output.size()));
+    ASSERT_NOT_OK(sws.getStatus());
+}
+
 }  // namespace mongo
 }  // namespace
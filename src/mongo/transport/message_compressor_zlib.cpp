@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/init.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/util/mongoutils/str.h"
+
+#include <zlib.h>
+
+namespace mongo {
+namespace {
+// The compression level used for messages sent by this process. Decompression does not depend on
+// the level chosen by the sender.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(zlibMessageCompressionLevel,
+                                      int,
+                                      ZlibMessageCompressor::kDefaultLevel);
+}  // namespace
+
+constexpr int ZlibMessageCompressor::kDefaultLevel;
+
+ZlibMessageCompressor::ZlibMessageCompressor(int level)
+    : MessageCompressorBase(MessageCompressor::kZlib), _level(level) {}
+
+std::size_t ZlibMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ::compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZlibMessageCompressor::compressData(ConstDataRange input,
+                                                            DataRange output) {
+    uLongf length = output.length();
+    int ret = ::compress2(reinterpret_cast<Bytef*>(const_cast<char*>(output.data())),
+                          &length,
+                          reinterpret_cast<const Bytef*>(input.data()),
+                          input.length(),
+                          _level);
+
+    if (ret != Z_OK) {
+        return Status{ErrorCodes::ZLibError,
+                      str::stream() << "Could not compress message, zlib error " << ret};
+    }
+
+    counterHitCompress(input.length(), length);
+    return {length};
+}
+
+StatusWith<std::size_t> ZlibMessageCompressor::decompressData(ConstDataRange input,
+                                                              DataRange output) {
+    uLongf length = output.length();
+    int ret = ::uncompress(reinterpret_cast<Bytef*>(const_cast<char*>(output.data())),
+                           &length,
+                           reinterpret_cast<const Bytef*>(input.data()),
+                           input.length());
+
+    if (ret != Z_OK) {
+        return Status{ErrorCodes::BadValue, "Compressed message was invalid or corrupted"};
+    }
+
+    counterHitDecompress(input.length(), length);
+    return {length};
+}
+
+
+MONGO_INITIALIZER_GENERAL(ZlibMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    const int level = zlibMessageCompressionLevel;
+    if (level != ZlibMessageCompressor::kDefaultLevel && (level < 0 || level > 9)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "zlibMessageCompressionLevel must be between 0 and 9, or -1 for "
+                                 "the default level, but was "
+                              << level};
+    }
+
+    auto& compressorRegistry = MessageCompressorRegistry::get();
+    compressorRegistry.registerImplementation(stdx::make_unique<ZlibMessageCompressor>(level));
+    return Status::OK();
+}
+}  // namespace mongo
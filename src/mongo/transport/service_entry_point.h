@@ -41,7 +41,9 @@ class Session;
  *
  * The ServiceEntryPoint accepts new Sessions from the TransportLayer, and is
  * responsible for running these Sessions in a get-Message, run-Message,
- * reply-with-Message loop.  It may not do this on the TransportLayer’s thread.
+ * reply-with-Message loop.  It may not do this on the TransportLayer’s thread, unless
+ * the TransportLayer supports asyncWait(), in which case it may source Messages with
+ * asyncWait() and hand each one to TransportLayer::scheduleRequest() to be run.
  */
 class ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPoint);
@@ -34,12 +34,15 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/net/message.h"
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/quick_exit.h"
 
@@ -55,23 +58,14 @@ namespace mongo {
 
 namespace {
 
-struct Context {
-    Context(transport::Session session, stdx::function<void(transport::Session*)> task)
-        : session(std::move(session)), task(std::move(task)) {}
-
-    transport::Session session;
-    stdx::function<void(transport::Session*)> task;
-};
-
-void* runFunc(void* ptr) {
-    std::unique_ptr<Context> ctx(static_cast<Context*>(ptr));
-
-    auto tl = ctx->session.getTransportLayer();
-    Client::initThread("conn", &ctx->session);
-    setThreadName(std::string(str::stream() << "conn" << ctx->session.id()));
-
+/**
+ * Runs 'task', logging any exception it throws. Returns false if the task threw, in which case
+ * the client connection must be closed.
+ */
+bool runLoggingExceptions(const stdx::function<void()>& task) {
     try {
-        ctx->task(&ctx->session);
+        task();
+        return true;
     } catch (const AssertionException& e) {
         log() << "AssertionException handling request, closing client connection: " << e;
     } catch (const SocketException& e) {
@@ -83,20 +77,128 @@ void* runFunc(void* ptr) {
         error() << "Uncaught std::exception: " << e.what() << ", terminating";
         quickExit(EXIT_UNCAUGHT);
     }
+    return false;
+}
 
-    tl->end(ctx->session);
+void endSession(transport::Session* session) {
+    auto tl = session->getTransportLayer();
+    tl->end(*session);
 
     if (!serverGlobalParams.quiet) {
         auto conns = tl->sessionStats().numOpenSessions;
         const char* word = (conns == 1 ? " connection" : " connections");
-        log() << "end connection " << ctx->session.remote() << " (" << conns << word
-              << " now open)";
+        log() << "end connection " << session->remote() << " (" << conns << word << " now open)";
     }
+}
+
+struct Context {
+    Context(transport::Session session, stdx::function<void(transport::Session*)> task)
+        : session(std::move(session)), task(std::move(task)) {}
+
+    transport::Session session;
+    stdx::function<void(transport::Session*)> task;
+};
+
+void* runFunc(void* ptr) {
+    std::unique_ptr<Context> ctx(static_cast<Context*>(ptr));
+
+    Client::initThread("conn", &ctx->session);
+    setThreadName(std::string(str::stream() << "conn" << ctx->session.id()));
+
+    runLoggingExceptions([&ctx] { ctx->task(&ctx->session); });
+
+    endSession(&ctx->session);
 
     Client::destroy();
 
     return nullptr;
 }
+
+/**
+ * Drives a single Session asynchronously. Messages are sourced on the I/O threads of the Session's
+ * TransportLayer, and each request is then handed to its request pool with scheduleRequest().
+ *
+ * Handling a request may block for a long time, for example in an awaitData getMore, a
+ * writeConcern wait, a lock wait or while the server is fsyncLocked, so only network I/O runs on
+ * the I/O threads.
+ *
+ * The worker keeps itself alive through the callbacks it passes to asyncWait() and
+ * scheduleRequest(), so it is destroyed, along with its Session, once the Session has ended and
+ * no request for it is outstanding.
+ */
+class AsyncWorker : public std::enable_shared_from_this<AsyncWorker> {
+    MONGO_DISALLOW_COPYING(AsyncWorker);
+
+public:
+    AsyncWorker(transport::Session session, AsyncServiceEntryHandler handler)
+        : _session(std::move(session)), _handler(std::move(handler)) {}
+
+    void start() {
+        _client = getGlobalServiceContext()->makeClient(
+            str::stream() << "conn" << _session.id(), &_session);
+        _sourceMessage();
+    }
+
+private:
+    void _sourceMessage() {
+        _message.reset();
+        auto self = shared_from_this();
+        _session.getTransportLayer()->asyncWait(_session.sourceMessage(&_message),
+                                                [self](Status status) { self->_onSource(status); });
+    }
+
+    void _onSource(Status status) {
+        if (!status.isOK()) {
+            // Network errors and internally closed sessions are the normal ways a session ends.
+            if (!ErrorCodes::isInterruption(status.code()) &&
+                !ErrorCodes::isNetworkError(status.code()) &&
+                status != transport::TransportLayer::TicketSessionClosedStatus) {
+                log() << "Error receiving request from client, closing client connection: "
+                      << status;
+            }
+            _end();
+            return;
+        }
+
+        auto self = shared_from_this();
+        auto scheduled =
+            _session.getTransportLayer()->scheduleRequest([self] { self->_handleMessage(); });
+        if (!scheduled.isOK()) {
+            if (!ErrorCodes::isShutdownError(scheduled.code())) {
+                log() << "Unable to schedule request, closing client connection: " << scheduled;
+            }
+            _end();
+        }
+    }
+
+    void _handleMessage() {
+        // Attach this session's Client to the request thread for as long as the request is being
+        // handled. The handler may block, including on synchronous sinks of exhaust replies.
+        Client::setCurrent(std::move(_client));
+        const bool ok = runLoggingExceptions([this] { _handler(&_session, &_message); });
+        _client = Client::releaseCurrent();
+
+        if (!ok) {
+            _end();
+            return;
+        }
+
+        _sourceMessage();
+    }
+
+    void _end() {
+        endSession(&_session);
+        _client.reset();
+    }
+
+    transport::Session _session;
+    AsyncServiceEntryHandler _handler;
+
+    // Declared after the Session, which the Client must not outlive.
+    ServiceContext::UniqueClient _client;
+    Message _message;
+};
+
 }  // namespace
 
 void launchWrappedServiceEntryWorkerThread(transport::Session&& session,
@@ -151,4 +253,10 @@ void launchWrappedServiceEntryWorkerThread(transport::Session&& session,
     }
 }
 
+void launchAsyncServiceEntryWorker(transport::Session&& session,
+                                   AsyncServiceEntryHandler handler) {
+    invariant(session.getTransportLayer()->supportsAsyncWait());
+    std::make_shared<AsyncWorker>(std::move(session), std::move(handler))->start();
+}
+
 }  // namespace mongo
@@ -32,6 +32,8 @@
 
 namespace mongo {
 
+class Message;
+
 namespace transport {
 class Session;
 }  // namespace transport
@@ -39,4 +41,17 @@ class Session;
 void launchWrappedServiceEntryWorkerThread(transport::Session&& session,
                                            stdx::function<void(transport::Session*)> task);
 
+using AsyncServiceEntryHandler = stdx::function<void(transport::Session*, Message*)>;
+
+/**
+ * Runs 'session' without a dedicated thread. Messages are sourced from the session with
+ * asyncWait(). Each one is passed to 'handler' on a thread of the TransportLayer's request pool,
+ * see TransportLayer::scheduleRequest(), with the session's Client attached to that thread, so
+ * 'handler' may block. An idle session holds no
+ * thread. The session is ended when sourcing fails or the handler throws.
+ *
+ * The session's TransportLayer must support asyncWait() and scheduleRequest().
+ */
+void launchAsyncServiceEntryWorker(transport::Session&& session, AsyncServiceEntryHandler handler);
+
 }  // namespace mongo
@@ -147,6 +147,27 @@ public:
      */
     virtual void asyncWait(Ticket&& ticket, TicketCallback callback) = 0;
 
+    /**
+     * Returns true if this TransportLayer implements asyncWait() and scheduleRequest(). Service
+     * entry points use this to decide whether a Session can be driven by asyncWait() callbacks,
+     * which hand each request to scheduleRequest(), instead of by a dedicated thread.
+     */
+    virtual bool supportsAsyncWait() const {
+        return false;
+    }
+
+    /**
+     * Runs 'task', which handles a request sourced with asyncWait() and may block, on a bounded
+     * pool of threads that this TransportLayer owns and joins in shutdown(). These are not the
+     * threads that complete asyncWait() Tickets, so blocked requests do not hold up network I/O.
+     * Returns an error if 'task' cannot be scheduled, for instance once shutdown() has begun.
+     *
+     * Only TransportLayers whose supportsAsyncWait() returns true implement this.
+     */
+    virtual Status scheduleRequest(stdx::function<void()> task) {
+        return {ErrorCodes::IllegalOperation, "This TransportLayer does not schedule requests"};
+    }
+
     /**
      * Tag this Session within the TransportLayer with the tags currently assigned to the
      * Session. If endAllSessions() is called with a matching
@@ -0,0 +1,732 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_asio.h"
+
+#include <asio.hpp>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/config.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/threadlocal.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/net/listen.h"
+#include "mongo/util/net/message.h"
+#include "mongo/util/net/sockaddr.h"
+#include "mongo/util/net/ssl_options.h"
+#include "mongo/util/net/ssl_types.h"
+
+namespace mongo {
+namespace transport {
+
+namespace {
+
+using GenericSocket = asio::generic::stream_protocol::socket;
+using GenericEndpoint = asio::generic::stream_protocol::endpoint;
+using GenericAcceptor = asio::basic_socket_acceptor<asio::generic::stream_protocol>;
+
+const size_t kHeaderLen = sizeof(MSGHEADER::Value);
+const size_t kInitialMessageSize = 1024;
+
+SockAddr endpointToSockAddr(const GenericEndpoint& endpoint) {
+    SockAddr addr;
+    invariant(endpoint.size() <= sizeof(sockaddr_storage));
+    memcpy(addr.raw(), endpoint.data(), endpoint.size());
+    addr.addressSize = endpoint.size();
+    return addr;
+}
+
+HostAndPort endpointToHostAndPort(const GenericEndpoint& endpoint) {
+    auto addr = endpointToSockAddr(endpoint);
+    if (addr.getType() == AF_UNIX) {
+        return HostAndPort(addr.getAddr());
+    }
+    return HostAndPort(addr.getAddr(), addr.getPort());
+}
+
+/**
+ * Validates the length in the message header that has been read into 'buf' and grows 'buf' so
+ * that it can hold the rest of the message.
+ */
+Status prepareMessageBody(SharedBuffer* buf) {
+    const int msgLen = MsgData::ConstView(buf->get()).getLen();
+    if (static_cast<size_t>(msgLen) < kHeaderLen ||
+        static_cast<size_t>(msgLen) > MaxMessageSizeBytes) {
+        return {ErrorCodes::ProtocolError,
+                str::stream() << "Message length " << msgLen << " is invalid. Min: " << kHeaderLen
+                              << ", Max: " << MaxMessageSizeBytes};
+    }
+
+    if (static_cast<size_t>(msgLen) > kInitialMessageSize) {
+        buf->realloc(msgLen);
+    }
+    return Status::OK();
+}
+
+Status finishSourceMessage(SharedBuffer buf,
+                           Message* message,
+                           MessageCompressorManager* compressorMgr) {
+    message->setData(std::move(buf));
+    networkCounter.hitPhysical(message->size(), 0);
+    if (message->operation() == dbCompressed) {
+        auto swm = compressorMgr->decompressMessage(*message);
+        if (!swm.isOK())
+            return swm.getStatus();
+        *message = swm.getValue();
+    }
+    networkCounter.hitLogical(message->size(), 0);
+    return Status::OK();
+}
+
+StatusWith<Message> prepareSinkMessage(const Message& message,
+                                       MessageCompressorManager* compressorMgr) {
+    networkCounter.hitLogical(0, message.size());
+    return compressorMgr->compressMessage(message);
+}
+
+// Set on the threads of the request pool.
+MONGO_TRIVIALLY_CONSTRUCTIBLE_THREAD_LOCAL bool isRequestThread = false;
+
+}  // namespace
+
+/**
+ * A listening socket, along with the address it is bound to. Once the TransportLayer has started,
+ * the socket is only accepted on and closed from its strand.
+ */
+class TransportLayerASIO::Acceptor {
+public:
+    Acceptor(asio::io_service& ioService, SockAddr addr)
+        : acceptor(ioService), strand(ioService), addr(std::move(addr)) {}
+
+    GenericAcceptor acceptor;
+    asio::io_service::strand strand;
+    const SockAddr addr;
+};
+
+class TransportLayerASIO::IOServiceWork {
+public:
+    explicit IOServiceWork(asio::io_service& ioService) : work(ioService) {}
+
+    asio::io_service::work work;
+};
+
+/**
+ * An accepted connection. Outstanding asynchronous operations hold a reference to their
+ * Connection, so that it outlives the Session it belongs to until they have completed.
+ *
+ * asio sockets are not thread-safe, so asynchronous operations are started and completed on the
+ * connection's strand, and the socket is only shut down or closed from that strand as well.
+ * Blocking operations from wait() run on the caller's thread, which never has an asynchronous
+ * operation outstanding on the same connection.
+ */
+class TransportLayerASIO::Connection {
+public:
+    explicit Connection(asio::io_service& ioService) : socket(ioService), strand(ioService) {}
+
+    GenericSocket socket;
+    asio::io_service::strand strand;
+
+    // Guarded by the TransportLayer's _connectionsMutex.
+    Session::TagMask tags = Session::kEmptyTagMask;
+
+    AtomicWord<bool> ended{false};
+};
+
+/**
+ * A TicketImpl implementation for this TransportLayer. Exactly one of _sourceMessage and
+ * _sinkMessage is set.
+ */
+class TransportLayerASIO::ASIOTicket : public TicketImpl {
+    MONGO_DISALLOW_COPYING(ASIOTicket);
+
+public:
+    ASIOTicket(Session& session,
+               Date_t expiration,
+               Message* sourceMessage,
+               const Message* sinkMessage)
+        : _sessionId(session.id()),
+          _expiration(expiration),
+          _sourceMessage(sourceMessage),
+          _sinkMessage(sinkMessage),
+          _compressorMgr(&session.getCompressorManager()) {}
+
+    SessionId sessionId() const override {
+        return _sessionId;
+    }
+
+    Date_t expiration() const override {
+        return _expiration;
+    }
+
+    SessionId _sessionId;
+    Date_t _expiration;
+
+    Message* _sourceMessage;
+    const Message* _sinkMessage;
+    MessageCompressorManager* _compressorMgr;
+};
+
+namespace {
+
+Status errorToStatus(bool sessionEnded, const asio::error_code& ec) {
+    // Errors caused by ending the session are reported the same way as by the legacy
+    // TransportLayer, so that service entry points treat them as a normal disconnect.
+    if (sessionEnded) {
+        return TransportLayer::TicketSessionClosedStatus;
+    }
+    return {ErrorCodes::HostUnreachable, ec.message()};
+}
+
+}  // namespace
+
+TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
+                                       ServiceEntryPoint* sep)
+    : _sep(sep),
+      _options(opts),
+      _ioService(stdx::make_unique<asio::io_service>()),
+      _running(false) {}
+
+TransportLayerASIO::~TransportLayerASIO() {
+    // Ending a session posts to its connection's strand on the io_service, so every session,
+    // request and worker must have finished before the io_service is destroyed.
+    shutdown();
+    _joinPools();
+    _acceptors.clear();
+    _ioService.reset();
+}
+
+Status TransportLayerASIO::setup() {
+#ifdef MONGO_CONFIG_SSL
+    if (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled) {
+        return {ErrorCodes::InvalidOptions,
+                "The asio transport layer does not support SSL, use the legacy transport layer"};
+    }
+#endif
+
+    Listener::checkTicketNumbers();
+
+#ifndef _WIN32
+    const bool useUnixSockets = !serverGlobalParams.noUnixSocket;
+#else
+    const bool useUnixSockets = false;
+#endif
+
+    for (auto&& addr : ipToAddrs(_options.ipList.c_str(), _options.port, useUnixSockets)) {
+        if (!addr.isValid()) {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "Unable to bind to invalid address " << addr.toString()};
+        }
+
+#ifndef _WIN32
+        if (addr.getType() == AF_UNIX && unlink(addr.getAddr().c_str()) == -1 &&
+            errno != ENOENT) {
+            error() << "Failed to unlink socket file " << addr << " "
+                    << errnoWithDescription(errno);
+            fassertFailedNoTrace(40314);
+        }
+#endif
+
+        auto acceptor = stdx::make_unique<Acceptor>(*_ioService, addr);
+        GenericEndpoint endpoint(addr.raw(), addr.addressSize);
+
+        asio::error_code ec;
+        acceptor->acceptor.open(endpoint.protocol(), ec);
+        if (!ec && addr.getType() == AF_INET6) {
+            // IPv6 can also accept IPv4 connections as mapped addresses (::ffff:127.0.0.1)
+            // That causes a conflict if we don't do set it to IPV6_ONLY
+            acceptor->acceptor.set_option(asio::ip::v6_only(true), ec);
+        }
+#ifndef _WIN32
+        if (!ec) {
+            acceptor->acceptor.set_option(asio::socket_base::reuse_address(true), ec);
+        }
+#endif
+        if (!ec) {
+            acceptor->acceptor.bind(endpoint, ec);
+        }
+        if (ec) {
+            error() << "Failed to set up listener on " << addr.toString() << ": " << ec.message();
+            return {ErrorCodes::InternalError, "Failed to set up sockets"};
+        }
+
+#ifndef _WIN32
+        if (addr.getType() == AF_UNIX) {
+            if (chmod(addr.getAddr().c_str(), serverGlobalParams.unixSocketPermissions) == -1) {
+                error() << "Failed to chmod socket file " << addr << " "
+                        << errnoWithDescription(errno);
+                fassertFailedNoTrace(40315);
+            }
+            ListeningSockets::get()->addPath(addr.getAddr());
+        }
+#endif
+
+        _acceptors.push_back(std::move(acceptor));
+    }
+
+    return Status::OK();
+}
+
+Status TransportLayerASIO::start() {
+    if (_running.swap(true)) {
+        return {ErrorCodes::InternalError, "TransportLayer is already running"};
+    }
+
+    const size_t numCores = std::max(1u, stdx::thread::hardware_concurrency());
+
+    ThreadPool::Options requestOptions;
+    requestOptions.poolName = "TransportLayerASIORequests";
+    requestOptions.threadNamePrefix = "conn-executor-";
+    requestOptions.maxThreads =
+        _options.numRequestThreads == 0 ? numCores : _options.numRequestThreads;
+    requestOptions.minThreads = requestOptions.maxThreads;
+    requestOptions.onCreateThread = [](const std::string&) { isRequestThread = true; };
+    _requestExecutor = stdx::make_unique<ThreadPool>(requestOptions);
+    _requestExecutor->startup();
+
+    _work = stdx::make_unique<IOServiceWork>(*_ioService);
+
+    for (auto&& acceptor : _acceptors) {
+        asio::error_code ec;
+        acceptor->acceptor.listen(asio::socket_base::max_connections, ec);
+        if (ec) {
+            error() << "listen() failed on " << acceptor->addr.toString() << ": " << ec.message();
+            return {ErrorCodes::InternalError, "Failed to listen on sockets"};
+        }
+        _acceptConnection(acceptor.get());
+    }
+
+    const size_t numWorkers =
+        _options.numWorkerThreads == 0 ? numCores : _options.numWorkerThreads;
+    for (size_t i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back([this, i] {
+            setThreadName(str::stream() << "transport-" << i);
+            try {
+                _ioService->run();
+            } catch (...) {
+                severe() << "Uncaught exception in TransportLayerASIO worker thread: "
+                         << exceptionToStatus();
+                fassertFailed(40316);
+            }
+        });
+    }
+
+    log() << "waiting for connections on port " << listenerPort();
+
+    return Status::OK();
+}
+
+int TransportLayerASIO::listenerPort() const {
+    for (auto&& acceptor : _acceptors) {
+        if (acceptor->addr.getType() == AF_UNIX) {
+            continue;
+        }
+
+        asio::error_code ec;
+        auto endpoint = acceptor->acceptor.local_endpoint(ec);
+        if (!ec) {
+            return endpointToSockAddr(endpoint).getPort();
+        }
+    }
+    return _options.port;
+}
+
+void TransportLayerASIO::_acceptConnection(Acceptor* acceptor) {
+    auto conn = std::make_shared<Connection>(*_ioService);
+    acceptor->acceptor.async_accept(
+        conn->socket, acceptor->strand.wrap([this, acceptor, conn](asio::error_code ec) {
+            if (ec == asio::error::operation_aborted || !_running.load()) {
+                return;
+            }
+
+            if (ec) {
+                log() << "Error accepting new connection on " << acceptor->addr.toString() << ": "
+                      << ec.message();
+            } else {
+                _handleNewConnection(conn);
+            }
+
+            _acceptConnection(acceptor);
+        }));
+}
+
+void TransportLayerASIO::_handleNewConnection(ConnectionHandle conn) {
+    asio::error_code ec;
+    auto remote = conn->socket.remote_endpoint(ec);
+    auto local = !ec ? conn->socket.local_endpoint(ec) : GenericEndpoint();
+    if (ec) {
+        LOG(1) << "Failed to read the address of a new connection: " << ec.message();
+        conn->socket.close(ec);
+        return;
+    }
+
+    if (!Listener::globalTicketHolder.tryAcquire()) {
+        log() << "connection refused because too many open connections: "
+              << Listener::globalTicketHolder.used();
+        conn->socket.close(ec);
+        return;
+    }
+
+    if (remote.protocol().family() != AF_UNIX) {
+        conn->socket.set_option(asio::ip::tcp::no_delay(true), ec);
+    }
+
+    auto connectionNumber = Listener::globalConnectionNumber.addAndFetch(1);
+    Session session(endpointToHostAndPort(remote), endpointToHostAndPort(local), this);
+
+    if (!serverGlobalParams.quiet) {
+        const auto conns = Listener::globalTicketHolder.used();
+        const char* word = (conns == 1 ? " connection" : " connections");
+        log() << "connection accepted from " << session.remote() << " #" << connectionNumber
+              << " (" << conns << word << " now open)";
+    }
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_connectionsMutex);
+        _connections.emplace(session.id(), std::move(conn));
+    }
+
+    invariant(_sep);
+    _sep->startSession(std::move(session));
+}
+
+Ticket TransportLayerASIO::sourceMessage(Session& session, Message* message, Date_t expiration) {
+    return Ticket(this, stdx::make_unique<ASIOTicket>(session, expiration, message, nullptr));
+}
+
+Ticket TransportLayerASIO::sinkMessage(Session& session,
+                                       const Message& message,
+                                       Date_t expiration) {
+    return Ticket(this, stdx::make_unique<ASIOTicket>(session, expiration, nullptr, &message));
+}
+
+StatusWith<TransportLayerASIO::ConnectionHandle> TransportLayerASIO::_checkOutConnection(
+    const Ticket& ticket) {
+    if (!_running.load()) {
+        return TransportLayer::ShutdownStatus;
+    }
+
+    if (ticket.expiration() < Date_t::now()) {
+        return Ticket::ExpiredStatus;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_connectionsMutex);
+
+    // Error if we cannot find the session.
+    auto conn = _connections.find(ticket.sessionId());
+    if (conn == _connections.end()) {
+        return TransportLayer::TicketSessionUnknownStatus;
+    }
+
+    // Error if we find the session but its connection is closed.
+    if (conn->second->ended.load()) {
+        return TransportLayer::TicketSessionClosedStatus;
+    }
+
+    return conn->second;
+}
+
+Status TransportLayerASIO::wait(Ticket&& ticket) {
+    auto swConn = _checkOutConnection(ticket);
+    if (!swConn.isOK()) {
+        return swConn.getStatus();
+    }
+    auto& conn = swConn.getValue();
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(ticket));
+
+    try {
+        asio::error_code ec;
+        if (asioTicket->_sourceMessage) {
+            auto buf = SharedBuffer::allocate(kInitialMessageSize);
+            asio::read(conn->socket, asio::buffer(buf.get(), kHeaderLen), ec);
+            if (ec) {
+                return errorToStatus(conn->ended.load(), ec);
+            }
+
+            auto status = prepareMessageBody(&buf);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            const size_t msgLen = MsgData::ConstView(buf.get()).getLen();
+            asio::read(conn->socket, asio::buffer(buf.get() + kHeaderLen, msgLen - kHeaderLen), ec);
+            if (ec) {
+                return errorToStatus(conn->ended.load(), ec);
+            }
+
+            return finishSourceMessage(
+                std::move(buf), asioTicket->_sourceMessage, asioTicket->_compressorMgr);
+        }
+
+        auto swm = prepareSinkMessage(*asioTicket->_sinkMessage, asioTicket->_compressorMgr);
+        if (!swm.isOK()) {
+            return swm.getStatus();
+        }
+        const auto& toSend = swm.getValue();
+        asio::write(conn->socket, asio::buffer(toSend.buf(), toSend.size()), ec);
+        if (ec) {
+            return errorToStatus(conn->ended.load(), ec);
+        }
+        networkCounter.hitPhysical(0, toSend.size());
+        return Status::OK();
+    } catch (...) {
+        return exceptionToStatus();
+    }
+}
+
+void TransportLayerASIO::asyncWait(Ticket&& ticket, TicketCallback callback) {
+    auto swConn = _checkOutConnection(ticket);
+    if (!swConn.isOK()) {
+        // Never run the callback on the calling thread, it may hold locks the callback needs.
+        auto status = swConn.getStatus();
+        _ioService->post([callback, status] { callback(status); });
+        return;
+    }
+    auto conn = std::move(swConn.getValue());
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(ticket));
+
+    if (asioTicket->_sourceMessage) {
+        auto message = asioTicket->_sourceMessage;
+        auto compressorMgr = asioTicket->_compressorMgr;
+        auto buf = std::make_shared<SharedBuffer>(SharedBuffer::allocate(kInitialMessageSize));
+
+        auto onBody = [conn, buf, message, compressorMgr, callback](asio::error_code ec,
+                                                                     size_t) {
+            if (ec) {
+                callback(errorToStatus(conn->ended.load(), ec));
+                return;
+            }
+
+            Status status = Status::OK();
+            try {
+                status = finishSourceMessage(std::move(*buf), message, compressorMgr);
+            } catch (...) {
+                status = exceptionToStatus();
+            }
+            callback(status);
+        };
+
+        auto onHeader = [conn, buf, callback, onBody](asio::error_code ec, size_t) {
+            if (ec) {
+                callback(errorToStatus(conn->ended.load(), ec));
+                return;
+            }
+
+            auto status = prepareMessageBody(buf.get());
+            if (!status.isOK()) {
+                callback(status);
+                return;
+            }
+
+            const size_t msgLen = MsgData::ConstView(buf->get()).getLen();
+            asio::async_read(conn->socket,
+                             asio::buffer(buf->get() + kHeaderLen, msgLen - kHeaderLen),
+                             conn->strand.wrap(onBody));
+        };
+
+        conn->strand.dispatch([conn, buf, onHeader] {
+            asio::async_read(conn->socket,
+                             asio::buffer(buf->get(), kHeaderLen),
+                             conn->strand.wrap(onHeader));
+        });
+        return;
+    }
+
+    auto swm = prepareSinkMessage(*asioTicket->_sinkMessage, asioTicket->_compressorMgr);
+    if (!swm.isOK()) {
+        auto status = swm.getStatus();
+        _ioService->post([callback, status] { callback(status); });
+        return;
+    }
+
+    auto toSend = std::make_shared<Message>(std::move(swm.getValue()));
+    auto onWrite = [conn, toSend, callback](asio::error_code ec, size_t) {
+        if (ec) {
+            callback(errorToStatus(conn->ended.load(), ec));
+            return;
+        }
+        networkCounter.hitPhysical(0, toSend->size());
+        callback(Status::OK());
+    };
+
+    conn->strand.dispatch([conn, toSend, onWrite] {
+        asio::async_write(conn->socket,
+                          asio::buffer(toSend->buf(), toSend->size()),
+                          conn->strand.wrap(onWrite));
+    });
+}
+
+Status TransportLayerASIO::scheduleRequest(stdx::function<void()> task) {
+    if (!_running.load()) {
+        return TransportLayer::ShutdownStatus;
+    }
+    return _requestExecutor->schedule(std::move(task));
+}
+
+void TransportLayerASIO::registerTags(const Session& session) {
+    stdx::lock_guard<stdx::mutex> lk(_connectionsMutex);
+    auto conn = _connections.find(session.id());
+    if (conn != _connections.end()) {
+        conn->second->tags = session.getTags();
+    }
+}
+
+SSLPeerInfo TransportLayerASIO::getX509PeerInfo(const Session& session) const {
+    // SSL is not supported by this TransportLayer.
+    return SSLPeerInfo();
+}
+
+TransportLayer::Stats TransportLayerASIO::sessionStats() {
+    Stats stats;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_connectionsMutex);
+        stats.numOpenSessions = _connections.size();
+    }
+
+    stats.numAvailableSessions = Listener::globalTicketHolder.available();
+    stats.numCreatedSessions = Listener::globalConnectionNumber.load();
+
+    return stats;
+}
+
+void TransportLayerASIO::end(Session& session) {
+    stdx::lock_guard<stdx::mutex> lk(_connectionsMutex);
+    auto conn = _connections.find(session.id());
+    if (conn != _connections.end()) {
+        _endSession_inlock(conn->second);
+    }
+}
+
+void TransportLayerASIO::_endSession_inlock(const ConnectionHandle& conn) {
+    if (conn->ended.swap(true)) {
+        return;
+    }
+
+    // Shutting the socket down, rather than closing it, makes any outstanding or future
+    // operations on it fail. This may be called from any thread, so it is done on the strand
+    // that the connection's asynchronous operations run on.
+    conn->strand.post([conn] {
+        asio::error_code ec;
+        conn->socket.shutdown(GenericSocket::shutdown_both, ec);
+    });
+    Listener::globalTicketHolder.release();
+}
+
+void TransportLayerASIO::endAllSessions(Session::TagMask tags) {
+    log() << "asio transport layer ending all sessions";
+    stdx::lock_guard<stdx::mutex> lk(_connectionsMutex);
+    for (auto&& conn : _connections) {
+        if (conn.second->tags & tags) {
+            log() << "Skip closing connection for session # " << conn.first;
+        } else {
+            _endSession_inlock(conn.second);
+        }
+    }
+}
+
+void TransportLayerASIO::shutdown() {
+    if (!_running.swap(false)) {
+        return;
+    }
+
+    // Stop accepting connections. An accept handler may be re-arming an acceptor, so they are
+    // closed on their strands.
+    for (auto&& acceptor : _acceptors) {
+        auto toClose = acceptor.get();
+        toClose->strand.post([toClose] {
+            asio::error_code ec;
+            toClose->acceptor.close(ec);
+        });
+    }
+
+    endAllSessions(Session::kEmptyTagMask);
+
+    // Let the running requests finish. Their sessions fail to source another Message, and any
+    // request that follows fails to be scheduled, so every session ends.
+    _requestExecutor->shutdown();
+
+    // A request, such as the shutdown command, cannot wait for itself to finish. The destructor
+    // joins the pools instead.
+    if (isRequestThread) {
+        return;
+    }
+    _joinPools();
+}
+
+void TransportLayerASIO::_joinPools() {
+    if (!_requestExecutor) {
+        return;
+    }
+    _requestExecutor->join();
+    _requestExecutor.reset();
+
+    // The I/O that remains completes with errors now that every session has ended, after which
+    // the workers run out of work and return.
+    _work.reset();
+    for (auto&& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void TransportLayerASIO::_destroy(Session& session) {
+    ConnectionHandle conn;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_connectionsMutex);
+        auto it = _connections.find(session.id());
+        invariant(it != _connections.end());
+        _endSession_inlock(it->second);
+        conn = std::move(it->second);
+        _connections.erase(it);
+    }
+
+    // Closing runs after the shutdown posted above. Sessions end before shutdown() returns, but
+    // if one outlives the workers the socket is closed when the io_service destroys this handler
+    // instead.
+    conn->strand.post([conn] {
+        asio::error_code ec;
+        conn->socket.close(ec);
+    });
+}
+
+}  // namespace transport
+}  // namespace mongo
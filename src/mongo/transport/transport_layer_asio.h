@@ -0,0 +1,174 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/transport/ticket_impl.h"
+#include "mongo/transport/transport_layer.h"
+
+namespace asio {
+class io_service;
+}  // namespace asio
+
+namespace mongo {
+
+class MessageCompressorManager;
+class ServiceEntryPoint;
+class ThreadPool;
+
+namespace transport {
+
+/**
+ * A TransportLayer implementation based on ASIO. Instead of handing each accepted connection to
+ * a thread of its own, this TransportLayer accepts connections and moves Messages asynchronously
+ * on a fixed pool of worker threads that all run a single io_service.
+ *
+ * Both wait() and asyncWait() are supported. wait() performs blocking I/O on the calling
+ * thread, asyncWait() runs the Ticket on the worker pool and invokes its callback from one of
+ * the worker threads. Requests sourced with asyncWait() are run by scheduleRequest() on a
+ * second, bounded pool, so that requests which block do not hold up the worker threads.
+ *
+ * shutdown() stops accepting connections, ends every session, waits for the running requests
+ * and outstanding I/O to finish, and then joins both pools. When shutdown() is called by a request,
+ * the pools are joined on destruction instead.
+ */
+class TransportLayerASIO final : public TransportLayer {
+    MONGO_DISALLOW_COPYING(TransportLayerASIO);
+
+public:
+    struct Options {
+        int port = 0;                 // port to bind to, 0 lets the OS choose one
+        std::string ipList;           // addresses to bind to
+        size_t numWorkerThreads = 0;   // size of the worker pool, 0 means one per core
+        size_t numRequestThreads = 0;  // size of the request pool, 0 means one per core
+    };
+
+    TransportLayerASIO(const Options& opts, ServiceEntryPoint* sep);
+
+    ~TransportLayerASIO();
+
+    Status setup();
+    Status start() override;
+
+    Ticket sourceMessage(Session& session,
+                         Message* message,
+                         Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Ticket sinkMessage(Session& session,
+                       const Message& message,
+                       Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Status wait(Ticket&& ticket) override;
+    void asyncWait(Ticket&& ticket, TicketCallback callback) override;
+
+    bool supportsAsyncWait() const override {
+        return true;
+    }
+
+    Status scheduleRequest(stdx::function<void()> task) override;
+
+    void registerTags(const Session& session) override;
+    SSLPeerInfo getX509PeerInfo(const Session& session) const override;
+
+    Stats sessionStats() override;
+
+    void end(Session& session) override;
+    void endAllSessions(transport::Session::TagMask tags) override;
+
+    void shutdown() override;
+
+    /**
+     * Returns the port of the first TCP socket this TransportLayer listens on. When the configured
+     * port is 0 this is the port the OS assigned. Only meaningful after setup().
+     */
+    int listenerPort() const;
+
+    /**
+     * Returns the number of threads in the worker pool. Only meaningful after start().
+     */
+    size_t numWorkerThreads() const {
+        return _workers.size();
+    }
+
+private:
+    class Acceptor;
+    class Connection;
+    class ASIOTicket;
+    class IOServiceWork;
+
+    using ConnectionHandle = std::shared_ptr<Connection>;
+
+    /**
+     * Waits for the request pool to drain and the workers to return once shutdown() has ended
+     * every session. Does nothing if the pools have already been joined or never started.
+     */
+    void _joinPools();
+
+    void _destroy(Session& session) override;
+
+    void _acceptConnection(Acceptor* acceptor);
+    void _handleNewConnection(ConnectionHandle conn);
+
+    /**
+     * Looks up the connection for a Ticket, returning an error if the TransportLayer is shut
+     * down, the Ticket has expired, or the connection is unknown or already ended.
+     */
+    StatusWith<ConnectionHandle> _checkOutConnection(const Ticket& ticket);
+
+    void _endSession_inlock(const ConnectionHandle& conn);
+
+    ServiceEntryPoint* _sep;
+    Options _options;
+
+    std::unique_ptr<asio::io_service> _ioService;
+    std::vector<std::unique_ptr<Acceptor>> _acceptors;
+    std::vector<stdx::thread> _workers;
+
+    // Keeps the workers running while there is no I/O outstanding. Released by shutdown() once
+    // every session has ended, so that the workers return after completing the remaining I/O.
+    std::unique_ptr<IOServiceWork> _work;
+
+    // Runs the tasks passed to scheduleRequest(). Created by start().
+    std::unique_ptr<ThreadPool> _requestExecutor;
+
+    mutable stdx::mutex _connectionsMutex;
+    stdx::unordered_map<Session::Id, ConnectionHandle> _connections;
+
+    AtomicWord<bool> _running;
+};
+
+}  // namespace transport
+}  // namespace mongo
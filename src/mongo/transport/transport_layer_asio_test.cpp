@@ -0,0 +1,216 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_asio.h"
+
+#include <asio.hpp>
+
+#include "mongo/db/server_options.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/session.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
+#include "mongo/util/net/message.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+/**
+ * A ServiceEntryPoint that drives each Session with asyncWait(), echoing every Message it
+ * sources back to the client.
+ */
+class EchoServiceEntryPoint final : public ServiceEntryPoint {
+public:
+    void startSession(Session&& session) override {
+        auto state = std::make_shared<SessionState>(std::move(session));
+        _source(state);
+    }
+
+private:
+    struct SessionState {
+        explicit SessionState(Session session) : session(std::move(session)) {}
+
+        Session session;
+        Message message;
+    };
+
+    void _source(std::shared_ptr<SessionState> state) {
+        state->message.reset();
+        auto tl = state->session.getTransportLayer();
+        tl->asyncWait(state->session.sourceMessage(&state->message), [this, state](Status s) {
+            if (!s.isOK()) {
+                return;
+            }
+
+            auto tl = state->session.getTransportLayer();
+            tl->asyncWait(state->session.sinkMessage(state->message), [this, state](Status s) {
+                if (!s.isOK()) {
+                    return;
+                }
+                _source(state);
+            });
+        });
+    }
+};
+
+class TransportLayerASIOTest : public unittest::Test {
+public:
+    void setUp() override {
+        serverGlobalParams.noUnixSocket = true;
+
+        TransportLayerASIO::Options opts;
+        opts.port = 0;
+        opts.ipList = "127.0.0.1";
+        opts.numWorkerThreads = 2;
+
+        _tl = stdx::make_unique<TransportLayerASIO>(opts, &_sep);
+        ASSERT_OK(_tl->setup());
+        ASSERT_OK(_tl->start());
+    }
+
+    void tearDown() override {
+        _tl->shutdown();
+        _tl.reset();
+    }
+
+    TransportLayerASIO* tl() {
+        return _tl.get();
+    }
+
+    asio::ip::tcp::endpoint endpoint() {
+        return asio::ip::tcp::endpoint(asio::ip::address::from_string("127.0.0.1"),
+                                       _tl->listenerPort());
+    }
+
+private:
+    EchoServiceEntryPoint _sep;
+    std::unique_ptr<TransportLayerASIO> _tl;
+};
+
+Message makeMessage(const std::string& payload) {
+    Message msg;
+    msg.setData(dbQuery, payload.c_str(), payload.size());
+    msg.header().setId(1);
+    msg.header().setResponseToMsgId(0);
+    return msg;
+}
+
+std::string roundTrip(asio::ip::tcp::socket* sock, const Message& msg) {
+    asio::write(*sock, asio::buffer(msg.buf(), msg.size()));
+
+    std::vector<char> reply(msg.size());
+    asio::read(*sock, asio::buffer(reply.data(), reply.size()));
+    const size_t headerLen = sizeof(MSGHEADER::Value);
+    return std::string(reply.data() + headerLen, reply.size() - headerLen);
+}
+
+TEST_F(TransportLayerASIOTest, StartsRequestedNumberOfWorkers) {
+    ASSERT_EQUALS(tl()->numWorkerThreads(), 2U);
+    ASSERT_TRUE(tl()->supportsAsyncWait());
+}
+
+TEST_F(TransportLayerASIOTest, ListensOnPortAssignedByOS) {
+    ASSERT_GREATER_THAN(tl()->listenerPort(), 0);
+}
+
+TEST_F(TransportLayerASIOTest, StartFailsIfAlreadyRunning) {
+    ASSERT_NOT_OK(tl()->start());
+}
+
+TEST_F(TransportLayerASIOTest, EchoesMessagesOnWorkerPool) {
+    asio::io_service ioService;
+    asio::ip::tcp::socket sock(ioService);
+    sock.connect(endpoint());
+
+    ASSERT_EQUALS(roundTrip(&sock, makeMessage("hello")), "hello");
+    ASSERT_EQUALS(roundTrip(&sock, makeMessage(std::string(4096, 'x'))), std::string(4096, 'x'));
+    ASSERT_EQUALS(tl()->sessionStats().numOpenSessions, 1U);
+}
+
+TEST_F(TransportLayerASIOTest, ServesConcurrentSessions) {
+    asio::io_service ioService;
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> socks;
+    for (int i = 0; i < 8; ++i) {
+        socks.push_back(stdx::make_unique<asio::ip::tcp::socket>(ioService));
+        socks.back()->connect(endpoint());
+    }
+
+    for (int round = 0; round < 3; ++round) {
+        for (auto&& sock : socks) {
+            ASSERT_EQUALS(roundTrip(sock.get(), makeMessage("ping")), "ping");
+        }
+    }
+
+    ASSERT_EQUALS(tl()->sessionStats().numOpenSessions, 8U);
+}
+
+TEST_F(TransportLayerASIOTest, RunsScheduledRequests) {
+    Notification<void> ran;
+    ASSERT_OK(tl()->scheduleRequest([&] { ran.set(); }));
+    ran.get();
+}
+
+TEST_F(TransportLayerASIOTest, ShutdownWaitsForScheduledRequests) {
+    Notification<void> started;
+    Notification<void> release;
+    AtomicWord<bool> finished(false);
+    ASSERT_OK(tl()->scheduleRequest([&] {
+        started.set();
+        release.get();
+        finished.store(true);
+    }));
+    started.get();
+
+    stdx::thread shutdownThread([&] { tl()->shutdown(); });
+    release.set();
+    shutdownThread.join();
+
+    ASSERT_TRUE(finished.load());
+    ASSERT_EQUALS(tl()->scheduleRequest([] {}), TransportLayer::ShutdownStatus);
+}
+
+TEST_F(TransportLayerASIOTest, ShutdownFromScheduledRequestDoesNotWaitForIt) {
+    Notification<void> shutDown;
+    ASSERT_OK(tl()->scheduleRequest([&] {
+        tl()->shutdown();
+        shutDown.set();
+    }));
+    shutDown.get();
+
+    ASSERT_EQUALS(tl()->scheduleRequest([] {}), TransportLayer::ShutdownStatus);
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_factory.h"
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_layer_legacy.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace transport {
+
+namespace {
+
+const char kTransportLayerASIO[] = "asio";
+const char kTransportLayerLegacy[] = "legacy";
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayer, std::string, kTransportLayerLegacy);
+
+// Number of worker threads used by the asio transport layer, 0 means one per core.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerASIOWorkerThreads, int, 0);
+
+// Number of threads the asio transport layer runs requests on, 0 means one per core.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerASIORequestThreads, int, 0);
+
+template <typename TL>
+StatusWith<std::unique_ptr<TransportLayer>> setUp(std::unique_ptr<TL> tl) {
+    auto status = tl->setup();
+    if (!status.isOK()) {
+        return status;
+    }
+    return {std::unique_ptr<TransportLayer>(std::move(tl))};
+}
+
+}  // namespace
+
+StatusWith<std::unique_ptr<TransportLayer>> makeIngressTransportLayer(int port,
+                                                                      const std::string& ipList,
+                                                                      ServiceEntryPoint* sep) {
+    if (transportLayer == kTransportLayerLegacy) {
+        TransportLayerLegacy::Options opts;
+        opts.port = port;
+        opts.ipList = ipList;
+        return setUp(stdx::make_unique<TransportLayerLegacy>(opts, sep));
+    }
+
+    if (transportLayer == kTransportLayerASIO) {
+        if (transportLayerASIOWorkerThreads < 0) {
+            return {ErrorCodes::BadValue,
+                    "transportLayerASIOWorkerThreads must be greater than or equal to 0"};
+        }
+        if (transportLayerASIORequestThreads < 0) {
+            return {ErrorCodes::BadValue,
+                    "transportLayerASIORequestThreads must be greater than or equal to 0"};
+        }
+
+        TransportLayerASIO::Options opts;
+        opts.port = port;
+        opts.ipList = ipList;
+        opts.numWorkerThreads = transportLayerASIOWorkerThreads;
+        opts.numRequestThreads = transportLayerASIORequestThreads;
+        log() << "Using the asio transport layer";
+        return setUp(stdx::make_unique<TransportLayerASIO>(opts, sep));
+    }
+
+    return {ErrorCodes::BadValue, "unsupported transport layer: " + transportLayer};
+}
+
+}  // namespace transport
+}  // namespace mongo
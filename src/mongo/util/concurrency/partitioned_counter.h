@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/compiler.h"
+
+namespace mongo {
+
+/**
+ * Returns a small number identifying the calling thread, for spreading updates of frequently
+ * written statistics over separate cache lines. Numbers are handed out round robin the first time
+ * each thread asks, so threads that run at the same time mostly get different numbers.
+ */
+unsigned getCounterPartitionForCurrentThread();
+
+/**
+ * A 64 bit counter split into cache line aligned partitions, one of which is picked by each
+ * thread. Increments made on different threads therefore rarely write to the same cache line.
+ *
+ * Reading the value folds all partitions together, which makes get() considerably more expensive
+ * than increment(). This suits statistics that are updated by every operation but only read by
+ * serverStatus. As with Counter64, a read concurrent with updates is not a consistent snapshot.
+ */
+class PartitionedCounter64 {
+    MONGO_DISALLOW_COPYING(PartitionedCounter64);
+
+public:
+    enum { kNumPartitions = 16 };
+
+    PartitionedCounter64() = default;
+
+    /** Atomically increment the calling thread's partition. */
+    void increment(uint64_t n = 1) {
+        _get().addAndFetch(n);
+    }
+
+    /** Atomically decrement the calling thread's partition. */
+    void decrement(uint64_t n = 1) {
+        _get().subtractAndFetch(n);
+    }
+
+    /** Return the sum of all partitions. */
+    long long get() const {
+        long long total = 0;
+        for (int i = 0; i < kNumPartitions; i++) {
+            total += _partitions[i].counter.load();
+        }
+        return total;
+    }
+
+    operator long long() const {
+        return get();
+    }
+
+private:
+    // Best effort alignment so that each partition sits on its own cache line.
+    struct MONGO_COMPILER_ALIGN_TYPE(128) AlignedCounter {
+        AtomicInt64 counter;
+    };
+
+    AtomicInt64& _get() {
+        return _partitions[getCounterPartitionForCurrentThread() % kNumPartitions].counter;
+    }
+
+    AlignedCounter _partitions[kNumPartitions];
+};
+
+}  // namespace mongo
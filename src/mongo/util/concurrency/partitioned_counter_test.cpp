@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/partitioned_counter.h"
+
+#include <set>
+#include <vector>
+
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(PartitionedCounter64Test, SingleThreadIncrementAndDecrement) {
+    PartitionedCounter64 counter;
+    ASSERT_EQ(counter.get(), 0);
+
+    counter.increment();
+    counter.increment(10);
+    counter.decrement(3);
+    ASSERT_EQ(counter.get(), 8);
+    ASSERT_EQ(static_cast<long long>(counter), 8);
+}
+
+TEST(PartitionedCounter64Test, PartitionIsStableWithinAThread) {
+    const unsigned partition = getCounterPartitionForCurrentThread();
+    ASSERT_EQ(getCounterPartitionForCurrentThread(), partition);
+}
+
+TEST(PartitionedCounter64Test, ConcurrentThreadsUseDifferentPartitions) {
+    const int numThreads = 4;
+    std::vector<unsigned> partitions(numThreads);
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < numThreads; i++) {
+        threads.emplace_back([&partitions, i] {
+            partitions[i] = getCounterPartitionForCurrentThread();
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    // Partitions are handed out round robin, so threads started after each other never share.
+    std::set<unsigned> distinct(partitions.begin(), partitions.end());
+    ASSERT_EQ(distinct.size(), static_cast<size_t>(numThreads));
+}
+
+TEST(PartitionedCounter64Test, ConcurrentIncrementsAreAllCounted) {
+    PartitionedCounter64 counter;
+    const int numThreads = 8;
+    const int incrementsPerThread = 10000;
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < numThreads; i++) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < incrementsPerThread; j++) {
+                counter.increment(2);
+                counter.decrement();
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(counter.get(), static_cast<long long>(numThreads) * incrementsPerThread);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -83,6 +83,7 @@ void TicketHolder::waitForTicket() {
 }
 
 void TicketHolder::release() {
+    _numReleased.increment();
     _check(sem_post(&_sem));
 }
 
@@ -100,7 +101,8 @@ Status TicketHolder::resize(int newSize) {
                                     << newSize);
 
     while (_outof.load() < newSize) {
-        release();
+        // Not release(), which would count this as a completed operation.
+        _check(sem_post(&_sem));
         _outof.fetchAndAdd(1);
     }
 
@@ -147,6 +149,7 @@ void TicketHolder::waitForTicket() {
 }
 
 void TicketHolder::release() {
+    _numReleased.increment();
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
         _num++;
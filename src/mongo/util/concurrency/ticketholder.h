@@ -34,6 +34,7 @@
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/partitioned_counter.h"
 
 namespace mongo {
 
@@ -58,7 +59,17 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns how many tickets have been released since construction, which is the number of
+     * operations that have completed while holding a ticket.
+     */
+    long long numReleased() const {
+        return _numReleased.get();
+    }
+
 private:
+    PartitionedCounter64 _numReleased;
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
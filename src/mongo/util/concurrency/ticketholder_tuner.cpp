@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/ticketholder_tuner.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+TicketHolderTuner::TicketHolderTuner(TicketHolder* holder, Options options)
+    : _holder(holder), _options(options), _lastNumReleased(holder->numReleased()) {
+    invariant(_options.minTickets > 0);
+    invariant(_options.minTickets <= _options.maxTickets);
+    invariant(_options.multiplicativeDecrease > 0 && _options.multiplicativeDecrease < 1);
+}
+
+void TicketHolderTuner::sample() {
+    const int used = _holder->used();
+    _inUseSum += used;
+    _numSamples++;
+    if (used >= _holder->outof()) {
+        _saturated = true;
+    }
+}
+
+TicketHolderTuner::Decision TicketHolderTuner::tune(int64_t elapsedMicros) {
+    const long long numReleased = _holder->numReleased();
+    const long long released = numReleased - _lastNumReleased;
+    const double avgInUse = _numSamples ? static_cast<double>(_inUseSum) / _numSamples : 0;
+    const bool saturated = _saturated;
+
+    _lastNumReleased = numReleased;
+    _inUseSum = 0;
+    _numSamples = 0;
+    _saturated = false;
+
+    if (released <= 0 || elapsedMicros <= 0) {
+        // Nothing completed, so there is nothing to learn from. Shrinking the pool now would only
+        // block the tuning thread until the operations holding tickets finish.
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _lastThroughput = 0;
+        _lastDecision = Decision::kHold;
+        return Decision::kHold;
+    }
+
+    const double throughput = released * 1000000.0 / elapsedMicros;
+    const double latencyMicros = avgInUse * 1000000.0 / throughput;
+    const int currentSize = _holder->outof();
+
+    Decision decision;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        decision = _decide(currentSize, latencyMicros, saturated);
+
+        // The baseline follows any improvement immediately, but only creeps upwards so that a
+        // single fast interval is not forgotten right away.
+        if (_baselineLatencyMicros <= 0 || latencyMicros < _baselineLatencyMicros) {
+            _baselineLatencyMicros = latencyMicros;
+        } else {
+            _baselineLatencyMicros =
+                std::min(latencyMicros, _baselineLatencyMicros * (1 + _options.baselineDrift));
+        }
+        _lastLatencyMicros = latencyMicros;
+        _lastThroughput = throughput;
+    }
+
+    int newSize = currentSize;
+    if (decision == Decision::kIncrease) {
+        newSize = std::min(_options.maxTickets, currentSize + _options.additiveIncrease);
+    } else if (decision == Decision::kDecrease) {
+        newSize = std::max(_options.minTickets,
+                           static_cast<int>(currentSize * _options.multiplicativeDecrease));
+    }
+
+    if (newSize != currentSize) {
+        Status status = _holder->resize(newSize);
+        if (!status.isOK()) {
+            LOG(1) << "failed to resize ticket pool from " << currentSize << " to " << newSize
+                   << ": " << status;
+            decision = Decision::kHold;
+        } else {
+            LOG(2) << "resized ticket pool from " << currentSize << " to " << newSize
+                   << "; throughput: " << throughput << "/s, latency: " << latencyMicros
+                   << "us";
+        }
+    } else {
+        decision = Decision::kHold;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _lastDecision = decision;
+    if (decision == Decision::kIncrease) {
+        _numIncreases++;
+    } else if (decision == Decision::kDecrease) {
+        _numDecreases++;
+    }
+    return decision;
+}
+
+TicketHolderTuner::Decision TicketHolderTuner::_decide(int currentSize,
+                                                       double latencyMicros,
+                                                       bool saturated) const {
+    if (_baselineLatencyMicros > 0 &&
+        latencyMicros > _baselineLatencyMicros * _options.latencyTolerance) {
+        return currentSize > _options.minTickets ? Decision::kDecrease : Decision::kHold;
+    }
+    if (saturated) {
+        return currentSize < _options.maxTickets ? Decision::kIncrease : Decision::kHold;
+    }
+    return Decision::kHold;
+}
+
+void TicketHolderTuner::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    builder->append("lastDecision", decisionToString(_lastDecision));
+    builder->appendNumber("increases", _numIncreases);
+    builder->appendNumber("decreases", _numDecreases);
+    builder->append("throughputPerSec", _lastThroughput);
+    builder->append("latencyMicros", _lastLatencyMicros);
+    builder->append("baselineLatencyMicros", _baselineLatencyMicros);
+}
+
+const char* TicketHolderTuner::decisionToString(Decision decision) {
+    switch (decision) {
+        case Decision::kHold:
+            return "hold";
+        case Decision::kIncrease:
+            return "increase";
+        case Decision::kDecrease:
+            return "decrease";
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace mongo
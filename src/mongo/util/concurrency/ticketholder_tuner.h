@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class TicketHolder;
+
+/**
+ * Adjusts the size of a TicketHolder to the throughput and latency it observes, using additive
+ * increase and multiplicative decrease.
+ *
+ * A single thread drives the tuner. It calls sample() several times per interval to record how
+ * many tickets are in use, and tune() at the end of each interval. By Little's law, the average
+ * time a ticket is held is the average number of tickets in use divided by the rate at which they
+ * are released. If that latency rises well above the best latency seen recently, the pool is
+ * shrunk by a constant factor, because adding concurrency has only added queueing inside the
+ * storage engine. Otherwise, if every ticket was in use during the interval, the pool is grown by
+ * a constant number of tickets to find out whether more concurrency brings more throughput.
+ */
+class TicketHolderTuner {
+    MONGO_DISALLOW_COPYING(TicketHolderTuner);
+
+public:
+    struct Options {
+        int minTickets = 16;
+        int maxTickets = 512;
+
+        // Tickets added to a saturated pool per interval.
+        int additiveIncrease = 8;
+
+        // Factor applied to the pool size when latency degrades.
+        double multiplicativeDecrease = 0.75;
+
+        // How many times the baseline latency an interval may show before the pool shrinks.
+        double latencyTolerance = 2.0;
+
+        // How fast the baseline latency is allowed to rise per interval, so that the tuner
+        // adapts to workloads whose operations are inherently slower.
+        double baselineDrift = 0.02;
+    };
+
+    enum class Decision { kHold, kIncrease, kDecrease };
+
+    TicketHolderTuner(TicketHolder* holder, Options options);
+
+    /**
+     * Records the number of tickets in use right now.
+     */
+    void sample();
+
+    /**
+     * Ends the current interval, which lasted 'elapsedMicros', resizes the TicketHolder based on
+     * what was observed during it and returns what was decided.
+     */
+    Decision tune(int64_t elapsedMicros);
+
+    /**
+     * Appends the measurements of the last interval and the counts of past decisions.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+    static const char* decisionToString(Decision decision);
+
+private:
+    Decision _decide(int currentSize, double latencyMicros, bool saturated) const;
+
+    TicketHolder* const _holder;
+    const Options _options;
+
+    // State of the current interval. Only touched by the tuning thread.
+    long long _lastNumReleased;
+    long long _inUseSum = 0;
+    int _numSamples = 0;
+    bool _saturated = false;
+
+    // Protects the members below, which are reported by appendStats().
+    mutable stdx::mutex _mutex;
+    double _baselineLatencyMicros = 0;
+    double _lastLatencyMicros = 0;
+    double _lastThroughput = 0;
+    Decision _lastDecision = Decision::kHold;
+    long long _numIncreases = 0;
+    long long _numDecreases = 0;
+};
+
+}  // namespace mongo
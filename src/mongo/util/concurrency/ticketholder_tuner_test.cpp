@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/ticketholder_tuner.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/ticketholder.h"
+
+namespace mongo {
+namespace {
+
+using Decision = TicketHolderTuner::Decision;
+
+const int64_t kOneSecond = 1000 * 1000;
+
+TicketHolderTuner::Options makeOptions() {
+    TicketHolderTuner::Options options;
+    options.minTickets = 8;
+    options.maxTickets = 32;
+    options.additiveIncrease = 8;
+    options.multiplicativeDecrease = 0.75;
+    options.latencyTolerance = 2.0;
+    return options;
+}
+
+/**
+ * Takes every ticket, lets the tuner sample the saturated pool and then gives the tickets back,
+ * so that one interval sees 'outof()' operations each holding a ticket the whole time.
+ */
+void runSaturatedInterval(TicketHolder* holder, TicketHolderTuner* tuner) {
+    const int numTickets = holder->outof();
+    for (int i = 0; i < numTickets; i++) {
+        ASSERT_TRUE(holder->tryAcquire());
+    }
+    tuner->sample();
+    for (int i = 0; i < numTickets; i++) {
+        holder->release();
+    }
+}
+
+TEST(TicketHolderTunerTest, HoldsWhenNothingCompleted) {
+    TicketHolder holder(16);
+    TicketHolderTuner tuner(&holder, makeOptions());
+    tuner.sample();
+    ASSERT(tuner.tune(kOneSecond) == Decision::kHold);
+    ASSERT_EQ(holder.outof(), 16);
+}
+
+TEST(TicketHolderTunerTest, HoldsWhenPoolIsNotSaturated) {
+    TicketHolder holder(16);
+    TicketHolderTuner tuner(&holder, makeOptions());
+    ASSERT_TRUE(holder.tryAcquire());
+    tuner.sample();
+    holder.release();
+    ASSERT(tuner.tune(kOneSecond) == Decision::kHold);
+    ASSERT_EQ(holder.outof(), 16);
+}
+
+TEST(TicketHolderTunerTest, GrowsSaturatedPoolAdditively) {
+    TicketHolder holder(16);
+    TicketHolderTuner tuner(&holder, makeOptions());
+
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(kOneSecond) == Decision::kIncrease);
+    ASSERT_EQ(holder.outof(), 24);
+
+    // The latency stays the same, so the pool keeps growing until it reaches the maximum.
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(kOneSecond) == Decision::kIncrease);
+    ASSERT_EQ(holder.outof(), 32);
+
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(kOneSecond) == Decision::kHold);
+    ASSERT_EQ(holder.outof(), 32);
+}
+
+TEST(TicketHolderTunerTest, ShrinksPoolMultiplicativelyWhenLatencyDegrades) {
+    TicketHolder holder(16);
+    TicketHolderTuner tuner(&holder, makeOptions());
+
+    // Establish a baseline of 16 tickets held for one second each.
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(kOneSecond) == Decision::kIncrease);
+    ASSERT_EQ(holder.outof(), 24);
+
+    // The same work now takes ten times as long, so the extra tickets are shed.
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(10 * kOneSecond) == Decision::kDecrease);
+    ASSERT_EQ(holder.outof(), 18);
+
+    BSONObjBuilder builder;
+    tuner.appendStats(&builder);
+    BSONObj stats = builder.obj();
+    ASSERT_EQ(stats["lastDecision"].String(), "decrease");
+    ASSERT_EQ(stats["increases"].numberLong(), 1);
+    ASSERT_EQ(stats["decreases"].numberLong(), 1);
+}
+
+TEST(TicketHolderTunerTest, NeverShrinksBelowMinimum) {
+    TicketHolder holder(10);
+    TicketHolderTuner::Options options = makeOptions();
+    options.maxTickets = 10;
+    TicketHolderTuner tuner(&holder, options);
+
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(kOneSecond) == Decision::kHold);
+
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(10 * kOneSecond) == Decision::kDecrease);
+    ASSERT_EQ(holder.outof(), 8);
+
+    runSaturatedInterval(&holder, &tuner);
+    ASSERT(tuner.tune(100 * kOneSecond) == Decision::kHold);
+    ASSERT_EQ(holder.outof(), 8);
+}
+
+}  // namespace
+}  // namespace mongo
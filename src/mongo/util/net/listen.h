@@ -47,6 +47,13 @@ const int DEFAULT_MAX_CONN = 1000000;
 
 class ServiceContext;
 
+/**
+ * Expands a comma-separated list of bind addresses into the socket addresses to listen on. An
+ * empty list means all IPv4 (and, if enabled, IPv6) interfaces. If 'useUnixSockets' is set, a
+ * unix domain socket is added alongside the loopback or wildcard IPv4 address.
+ */
+std::vector<SockAddr> ipToAddrs(const char* ips, int port, bool useUnixSockets);
+
 class Listener {
     MONGO_DISALLOW_COPYING(Listener);
 
@@ -85,4 +85,27 @@ using StringMap = UnorderedFastKeyTable<StringData,   // K_L
                                         V,
                                         StringMapTraits>;
 
+/**
+ * Like StringMapTraits, but stores the keys as they are given rather than copies of them.
+ */
+struct UnownedStringMapTraits : StringMapTraits {
+    static StringData toStorage(StringData s) {
+        return s;
+    }
+
+    static StringData toLookup(StringData s) {
+        return s;
+    }
+};
+
+/**
+ * A StringMap that does not copy its keys. The memory the keys point into must outlive their
+ * entries in the map.
+ */
+template <typename V>
+using UnownedStringMap = UnorderedFastKeyTable<StringData,  // K_L
+                                               StringData,  // K_S
+                                               V,
+                                               UnownedStringMapTraits>;
+
 }  // namespace mongo